@@ -33,6 +33,7 @@
 
 #include "basechannel.hpp"
 #include "src/util.hpp"
+#include "src/data/analogsamplesignal.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
 #include "src/data/datautil.hpp"
@@ -149,6 +150,19 @@ void BaseChannel::add_channel_group_name(const string &channel_group_name)
 }
 
 void BaseChannel::add_signal(shared_ptr<data::AnalogTimeSignal> signal)
+{
+	connect(this, &BaseChannel::channel_start_timestamp_changed,
+		signal.get(), &data::AnalogTimeSignal::on_channel_start_timestamp_changed);
+
+	insert_signal(signal);
+}
+
+void BaseChannel::add_signal(shared_ptr<data::AnalogSampleSignal> signal)
+{
+	insert_signal(signal);
+}
+
+void BaseChannel::insert_signal(shared_ptr<data::BaseSignal> signal)
 {
 	if (!signal_map_.empty() && fixed_signal_) {
 		/*
@@ -165,9 +179,6 @@ void BaseChannel::add_signal(shared_ptr<data::AnalogTimeSignal> signal)
 		qCritical() << "WARNING: Please fix this in the libsigrok driver!";
 	}
 
-	connect(this, &BaseChannel::channel_start_timestamp_changed,
-		signal.get(), &data::AnalogTimeSignal::on_channel_start_timestamp_changed);
-
 	measured_quantity_t mq = make_pair(
 		signal->quantity(), signal->quantity_flags());
 	if (signal_map_.count(mq) > 0) {
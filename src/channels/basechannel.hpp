@@ -47,6 +47,7 @@ class Channel;
 namespace sv {
 
 namespace data {
+class AnalogSampleSignal;
 class AnalogTimeSignal;
 class BaseSignal;
 }
@@ -163,6 +164,11 @@ public:
 	 */
 	void add_signal(shared_ptr<data::AnalogTimeSignal> signal);
 
+	/**
+	 * Add a position indexed signal (e.g. a spectrum) to the channel.
+	 */
+	void add_signal(shared_ptr<data::AnalogSampleSignal> signal);
+
 	/**
 	 * Add a signal by its quantity, quantity_flags and unit.
 	 */
@@ -221,6 +227,9 @@ protected:
 	shared_ptr<data::BaseSignal> actual_signal_;
 	map<measured_quantity_t, vector<shared_ptr<data::BaseSignal>>> signal_map_;
 
+private:
+	void insert_signal(shared_ptr<data::BaseSignal> signal);
+
 public Q_SLOTS:
 	void on_aquisition_start_timestamp_changed(double timestamp);
 
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QDebug>
+
+#include "derivativechannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/calculus.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+DerivativeChannel::DerivativeChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		uint smooth_sample_count,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	next_signal_pos_(0),
+	prev_timestamps_{ 0., 0. },
+	prev_values_{ 0., 0. },
+	prev_count_(0),
+	smooth_sample_count_(smooth_sample_count > 0 ? smooth_sample_count : 1),
+	smooth_pos_(0),
+	smooth_fill_(0),
+	smooth_sum_(0.)
+{
+	assert(signal_);
+
+	total_digits_ = signal_->total_digits();
+	sr_digits_ = signal_->sr_digits();
+
+	smooth_samples_.assign(smooth_sample_count_, 0.);
+
+	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
+		this, &DerivativeChannel::on_sample_appended);
+}
+
+void DerivativeChannel::on_sample_appended()
+{
+	size_t signal_sample_count = signal_->sample_count();
+	if (next_signal_pos_ >= signal_sample_count)
+		return;
+
+	size_t count = signal_->get_samples(
+		next_signal_pos_, signal_sample_count,
+		in_timestamps_, in_values_, false);
+	next_signal_pos_ += count;
+
+	out_timestamps_.clear();
+	out_values_.clear();
+	for (size_t i=0; i<count; ++i) {
+		double t2 = in_timestamps_[i];
+		double f2 = in_values_[i];
+
+		// Ignore samples with the same (or an older) timestamp
+		if (prev_count_ > 0 && t2 <= prev_timestamps_[1])
+			continue;
+
+		if (prev_count_ == 2) {
+			double derivative = data::central_derivative(
+				prev_timestamps_[0], prev_values_[0],
+				prev_timestamps_[1], prev_values_[1], t2, f2);
+
+			out_timestamps_.push_back(prev_timestamps_[1]);
+			out_values_.push_back(smooth(derivative));
+		}
+
+		prev_timestamps_[0] = prev_timestamps_[1];
+		prev_values_[0] = prev_values_[1];
+		prev_timestamps_[1] = t2;
+		prev_values_[1] = f2;
+		if (prev_count_ < 2)
+			++prev_count_;
+	}
+
+	push_samples(out_values_, out_timestamps_);
+}
+
+double DerivativeChannel::smooth(double value)
+{
+	if (smooth_sample_count_ <= 1)
+		return value;
+
+	smooth_sum_ += value - smooth_samples_[smooth_pos_];
+	smooth_samples_[smooth_pos_] = value;
+	if (smooth_fill_ < smooth_sample_count_)
+		++smooth_fill_;
+	if (++smooth_pos_ >= smooth_sample_count_) {
+		smooth_pos_ = 0;
+		// Recalculate the sum once per cycle to get rid of rounding errors
+		smooth_sum_ = 0.;
+		for (const auto &sample : smooth_samples_)
+			smooth_sum_ += sample;
+	}
+
+	return smooth_sum_ / (double)smooth_fill_;
+}
+
+} // namespace channels
+} // namespace sv
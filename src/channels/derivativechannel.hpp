@@ -0,0 +1,105 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_DERIVATIVECHANNEL_HPP
+#define CHANNELS_DERIVATIVECHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+/**
+ * Numerical derivative of a signal over the time in seconds (e.g. dV/dt).
+ *
+ * The derivative is calculated with the three-point central difference for
+ * non-uniform spacing, so the output is delayed by one sample. When
+ * `smooth_sample_count` is greater than 1, the derivative is smoothed with a
+ * moving average over that many values.
+ */
+class DerivativeChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	DerivativeChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		uint smooth_sample_count,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+private:
+	double smooth(double value);
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	size_t next_signal_pos_;
+	/** The last two samples of the input signal, [0] is the older one. */
+	double prev_timestamps_[2];
+	double prev_values_[2];
+	size_t prev_count_;
+
+	/** Ring buffer for the moving average. */
+	uint smooth_sample_count_;
+	vector<double> smooth_samples_;
+	size_t smooth_pos_;
+	size_t smooth_fill_;
+	double smooth_sum_;
+
+	vector<double> in_timestamps_;
+	vector<double> in_values_;
+	vector<double> out_timestamps_;
+	vector<double> out_values_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_DERIVATIVECHANNEL_HPP
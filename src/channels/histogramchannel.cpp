@@ -0,0 +1,177 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QDebug>
+
+#include "histogramchannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogsamplesignal.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/histogram.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::make_shared;
+using std::set;
+using std::static_pointer_cast;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+HistogramChannel::HistogramChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t bin_count,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	histogram_(bin_count),
+	p1_estimator_(0.01),
+	p50_estimator_(0.5),
+	p99_estimator_(0.99),
+	next_signal_pos_(0)
+{
+	init();
+}
+
+HistogramChannel::HistogramChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t bin_count,
+		double min,
+		double max,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	histogram_(bin_count, min, max),
+	p1_estimator_(0.01),
+	p50_estimator_(0.5),
+	p99_estimator_(0.99),
+	next_signal_pos_(0)
+{
+	init();
+}
+
+void HistogramChannel::init()
+{
+	assert(signal_);
+
+	total_digits_ = signal_->total_digits();
+	sr_digits_ = signal_->sr_digits();
+
+	// This channel has the histogram and the percentile signals
+	fixed_signal_ = false;
+
+	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
+		this, &HistogramChannel::on_sample_appended);
+}
+
+void HistogramChannel::init_signals()
+{
+	p1_signal_ = static_pointer_cast<data::AnalogTimeSignal>(
+		add_signal(quantity_, quantity_flags_, unit_, name_ + " p1"));
+	p50_signal_ = static_pointer_cast<data::AnalogTimeSignal>(
+		add_signal(quantity_, quantity_flags_, unit_, name_ + " p50"));
+	p99_signal_ = static_pointer_cast<data::AnalogTimeSignal>(
+		add_signal(quantity_, quantity_flags_, unit_, name_ + " p99"));
+
+	histogram_signal_ = make_shared<data::AnalogSampleSignal>(
+		data::Quantity::Count, set<data::QuantityFlag>(),
+		data::Unit::Unitless, shared_from_this());
+	add_signal(histogram_signal_);
+
+	// The views can only display time signals, so the median is the actual
+	// signal of this channel.
+	actual_signal_ = p50_signal_;
+}
+
+double HistogramChannel::lower_bound() const
+{
+	return histogram_.lower_bound();
+}
+
+double HistogramChannel::bin_width() const
+{
+	return histogram_.bin_width();
+}
+
+void HistogramChannel::on_sample_appended()
+{
+	size_t signal_sample_count = signal_->sample_count();
+	if (next_signal_pos_ >= signal_sample_count)
+		return;
+
+	size_t count = signal_->get_samples(
+		next_signal_pos_, signal_sample_count,
+		in_timestamps_, in_values_, false);
+	next_signal_pos_ += count;
+
+	for (const auto &value : in_values_) {
+		histogram_.add(value);
+		p1_estimator_.add(value);
+		p50_estimator_.add(value);
+		p99_estimator_.add(value);
+	}
+
+	// Publish the percentiles and the histogram once per batch
+	double timestamp = in_timestamps_.back();
+	double p1 = p1_estimator_.value();
+	double p50 = p50_estimator_.value();
+	double p99 = p99_estimator_.value();
+	if (p1_signal_)
+		p1_signal_->push_sample(&p1, timestamp, size_of_double_,
+			total_digits_, sr_digits_);
+	if (p50_signal_)
+		p50_signal_->push_sample(&p50, timestamp, size_of_double_,
+			total_digits_, sr_digits_);
+	if (p99_signal_)
+		p99_signal_->push_sample(&p99, timestamp, size_of_double_,
+			total_digits_, sr_digits_);
+
+	const auto &bins = histogram_.bins();
+	if (histogram_signal_ && !bins.empty()) {
+		histogram_signal_->set_samples((void *)bins.data(), bins.size(),
+			size_of_double_, data::DefaultTotalDigits, 0);
+	}
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_HISTOGRAMCHANNEL_HPP
+#define CHANNELS_HISTOGRAMCHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/histogram.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogSampleSignal;
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+/**
+ * Histogram of the values of a signal.
+ *
+ * The bin counts are published as an AnalogSampleSignal where the position is
+ * the bin index. The value range of bin `pos` is
+ * [`lower_bound() + pos * bin_width()`, `lower_bound() + (pos+1) * bin_width()`).
+ *
+ * Additionally the running 1st, 50th and 99th percentiles are published as
+ * AnalogTimeSignals. They are estimated with the P² algorithm, so the memory
+ * usage doesn't depend on the number of samples.
+ */
+class HistogramChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * Create a histogram channel with auto-ranging bins.
+	 */
+	HistogramChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t bin_count,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+	/**
+	 * Create a histogram channel with the fixed range [`min`, `max`).
+	 */
+	HistogramChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t bin_count,
+		double min,
+		double max,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+	/**
+	 * Create the percentile signals and the histogram signal.
+	 */
+	void init_signals() override;
+
+	double lower_bound() const;
+	double bin_width() const;
+
+private:
+	void init();
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	data::Histogram histogram_;
+	data::P2QuantileEstimator p1_estimator_;
+	data::P2QuantileEstimator p50_estimator_;
+	data::P2QuantileEstimator p99_estimator_;
+	size_t next_signal_pos_;
+
+	shared_ptr<data::AnalogSampleSignal> histogram_signal_;
+	shared_ptr<data::AnalogTimeSignal> p1_signal_;
+	shared_ptr<data::AnalogTimeSignal> p50_signal_;
+	shared_ptr<data::AnalogTimeSignal> p99_signal_;
+
+	vector<double> in_timestamps_;
+	vector<double> in_values_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_HISTOGRAMCHANNEL_HPP
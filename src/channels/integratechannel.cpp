@@ -21,6 +21,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QDebug>
 
@@ -28,6 +29,8 @@
 #include "src/channels/basechannel.hpp"
 #include "src/channels/mathchannel.hpp"
 #include "src/data/analogtimesignal.hpp"
+#include "src/data/calculus.hpp"
+#include "src/data/compensatedsum.hpp"
 #include "src/data/datautil.hpp"
 #include "src/devices/basedevice.hpp"
 
@@ -42,6 +45,7 @@ IntegrateChannel::IntegrateChannel(
 		const set<data::QuantityFlag> &quantity_flags,
 		data::Unit unit,
 		shared_ptr<data::AnalogTimeSignal> int_signal,
+		IntegrationMethod integration_method,
 		shared_ptr<devices::BaseDevice> parent_device,
 		const set<string> &channel_group_names,
 		const string &channel_name,
@@ -50,9 +54,14 @@ IntegrateChannel::IntegrateChannel(
 		parent_device, channel_group_names, channel_name,
 		channel_start_timestamp),
 	int_signal_(int_signal),
+	integration_method_(integration_method),
 	next_int_signal_pos_(0),
 	last_timestamp_(channel_start_timestamp),
-	last_value_(0.)
+	last_value_(0.),
+	has_last_sample_(false),
+	mid_timestamp_(0.),
+	mid_value_(0.),
+	has_mid_sample_(false)
 {
 	assert(int_signal_);
 
@@ -74,20 +83,61 @@ void IntegrateChannel::on_channel_start_timestamp_changed(double timestamp)
 
 void IntegrateChannel::on_sample_appended()
 {
-	// Integrate
+	// Integrate all new samples in one batch
 	size_t int_signal_sample_count = int_signal_->sample_count();
-	while (next_int_signal_pos_ < int_signal_sample_count) {
-		auto sample = int_signal_->get_sample(next_int_signal_pos_, false);
-		double time = sample.first;
-		double elapsed_time_hours = (time - last_timestamp_) / (double)3600;
-		double value = last_value_ + (sample.second * elapsed_time_hours);
+	if (next_int_signal_pos_ >= int_signal_sample_count)
+		return;
 
-		push_sample(value, time);
+	size_t count = int_signal_->get_samples(
+		next_int_signal_pos_, int_signal_sample_count,
+		in_timestamps_, in_values_, false);
+	next_int_signal_pos_ += count;
 
-		last_timestamp_ = time;
-		last_value_ = value;
-		++next_int_signal_pos_;
+	out_values_.resize(count);
+	for (size_t i=0; i<count; ++i) {
+		double value_seconds = integrate(in_timestamps_[i], in_values_[i]);
+		out_values_[i] = value_seconds / (double)3600;
 	}
+
+	push_samples(out_values_, in_timestamps_);
+}
+
+double IntegrateChannel::integrate(double timestamp, double value)
+{
+	switch (integration_method_) {
+	case IntegrationMethod::Rectangular:
+		sum_.add(value * (timestamp - last_timestamp_));
+		break;
+	case IntegrationMethod::Trapezoidal:
+		if (has_last_sample_) {
+			sum_.add(data::trapezoid_area(
+				last_timestamp_, last_value_, timestamp, value));
+		}
+		break;
+	case IntegrationMethod::Simpson:
+		if (!has_last_sample_)
+			break;
+		if (!has_mid_sample_) {
+			// Wait for the next sample, use a trapezoid in the meantime
+			mid_timestamp_ = timestamp;
+			mid_value_ = value;
+			has_mid_sample_ = true;
+			return sum_.value() + data::trapezoid_area(
+				last_timestamp_, last_value_, timestamp, value);
+		}
+		else {
+			sum_.add(data::simpson_area(last_timestamp_, last_value_,
+				mid_timestamp_, mid_value_, timestamp, value));
+			has_mid_sample_ = false;
+		}
+		break;
+	}
+
+	last_timestamp_ = timestamp;
+	last_value_ = value;
+	has_last_sample_ = true;
+
+	return sum_.value();
 }
 
 } // namespace channels
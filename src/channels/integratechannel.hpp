@@ -23,16 +23,19 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QObject>
 
 #include "src/channels/basechannel.hpp"
 #include "src/channels/mathchannel.hpp"
+#include "src/data/compensatedsum.hpp"
 #include "src/data/datautil.hpp"
 
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::vector;
 
 namespace sv {
 
@@ -46,6 +49,29 @@ class BaseDevice;
 
 namespace channels {
 
+enum class IntegrationMethod {
+	/**
+	 * Right rectangle rule: Every sample is held since the last sample.
+	 */
+	Rectangular,
+	/**
+	 * Trapezoidal rule: Linear interpolation between two samples.
+	 */
+	Trapezoidal,
+	/**
+	 * Simpson's rule for non-uniform spacing over two intervals. The last
+	 * incomplete interval is integrated with the trapezoidal rule until the
+	 * next sample arrives.
+	 */
+	Simpson
+};
+
+/**
+ * Integrate a signal over the time in hours (e.g. Ah and Wh).
+ *
+ * The integral is accumulated with a compensated sum, so it doesn't drift
+ * over long acquisitions.
+ */
 class IntegrateChannel : public MathChannel
 {
 	Q_OBJECT
@@ -56,16 +82,34 @@ public:
 		const set<data::QuantityFlag> &quantity_flags,
 		data::Unit unit,
 		shared_ptr<data::AnalogTimeSignal> int_signal,
+		IntegrationMethod integration_method,
 		shared_ptr<devices::BaseDevice> parent_device,
 		const set<string> &channel_group_names,
 		const string &channel_name,
 		double channel_start_timestamp);
 
 private:
+	/**
+	 * Add the sample to the integral and return the actual integral value in
+	 * value * seconds.
+	 */
+	double integrate(double timestamp, double value);
+
 	shared_ptr<data::AnalogTimeSignal> int_signal_;
+	IntegrationMethod integration_method_;
 	size_t next_int_signal_pos_;
 	double last_timestamp_;
 	double last_value_;
+	bool has_last_sample_;
+	/** The middle sample for Simpson's rule. */
+	double mid_timestamp_;
+	double mid_value_;
+	bool has_mid_sample_;
+	data::CompensatedSum sum_;
+
+	vector<double> in_timestamps_;
+	vector<double> in_values_;
+	vector<double> out_values_;
 
 private Q_SLOTS:
 	void on_channel_start_timestamp_changed(double timestamp);
@@ -91,6 +91,11 @@ data::Unit MathChannel::unit()
 	return unit_;
 }
 
+void MathChannel::init_signals()
+{
+	add_signal(quantity_, quantity_flags_, unit_);
+}
+
 void MathChannel::push_sample(double sample, double timestamp)
 {
 	auto signal = static_pointer_cast<data::AnalogTimeSignal>(actual_signal_);
@@ -98,5 +103,12 @@ void MathChannel::push_sample(double sample, double timestamp)
 		total_digits_, sr_digits_);
 }
 
+void MathChannel::push_samples(const vector<double> &samples,
+	const vector<double> &timestamps)
+{
+	auto signal = static_pointer_cast<data::AnalogTimeSignal>(actual_signal_);
+	signal->push_samples(timestamps, samples, total_digits_, sr_digits_);
+}
+
 } // namespace channels
 } // namespace sv
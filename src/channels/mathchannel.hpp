@@ -79,12 +79,25 @@ public:
 	 */
 	data::Unit unit();
 
+	/**
+	 * Create the signal(s) of the math channel. The default implementation
+	 * adds one AnalogTimeSignal with the quantity, quantity flags and unit of
+	 * the math channel.
+	 */
+	virtual void init_signals();
+
 protected:
 	/**
 	 * Add a single sample with timestamp to the channel/signal
 	 */
 	void push_sample(double sample, double timestamp);
 
+	/**
+	 * Add multiple samples with timestamps to the channel/signal
+	 */
+	void push_samples(const vector<double> &samples,
+		const vector<double> &timestamps);
+
 	int total_digits_;
 	int sr_digits_;
 	data::Quantity quantity_;
@@ -0,0 +1,274 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "resamplechannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace channels {
+
+const uint ResampleChannel::FilterTapsPerPhase = 16;
+const uint ResampleChannel::MaxDecimation = 1024;
+const size_t ResampleChannel::RateEstimationSamples = 33;
+
+ResampleChannel::ResampleChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		double samplerate,
+		InterpolationMethod interpolation_method,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	samplerate_(samplerate),
+	interpolation_method_(interpolation_method),
+	next_signal_pos_(0),
+	last_input_timestamp_(std::numeric_limits<double>::lowest()),
+	hist_timestamps_{ 0., 0., 0., 0. },
+	hist_values_{ 0., 0., 0., 0. },
+	hist_count_(0),
+	grid_initialized_(false),
+	grid_start_timestamp_(0.),
+	grid_interval_(0.),
+	grid_index_(0),
+	decimation_(1),
+	fir_pos_(0)
+{
+	assert(signal_);
+	assert(samplerate_ > 0);
+
+	total_digits_ = signal_->total_digits();
+	sr_digits_ = signal_->sr_digits();
+
+	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
+		this, &ResampleChannel::on_sample_appended);
+}
+
+void ResampleChannel::on_sample_appended()
+{
+	size_t signal_sample_count = signal_->sample_count();
+	if (next_signal_pos_ >= signal_sample_count)
+		return;
+
+	size_t count = signal_->get_samples(
+		next_signal_pos_, signal_sample_count,
+		in_timestamps_, in_values_, false);
+	next_signal_pos_ += count;
+
+	out_timestamps_.clear();
+	out_values_.clear();
+	for (size_t i=0; i<count; ++i) {
+		// Ignore samples with the same (or an older) timestamp
+		if (in_timestamps_[i] <= last_input_timestamp_)
+			continue;
+		last_input_timestamp_ = in_timestamps_[i];
+
+		if (grid_initialized_) {
+			add_sample(in_timestamps_[i], in_values_[i]);
+			continue;
+		}
+
+		pending_timestamps_.push_back(in_timestamps_[i]);
+		pending_values_.push_back(in_values_[i]);
+		if (pending_timestamps_.size() < RateEstimationSamples)
+			continue;
+
+		init_grid();
+		for (size_t j=0; j<pending_timestamps_.size(); ++j)
+			add_sample(pending_timestamps_[j], pending_values_[j]);
+		pending_timestamps_.clear();
+		pending_values_.clear();
+	}
+
+	push_samples(out_values_, out_timestamps_);
+}
+
+void ResampleChannel::add_sample(double timestamp, double value)
+{
+	for (size_t j=0; j<3; ++j) {
+		hist_timestamps_[j] = hist_timestamps_[j+1];
+		hist_values_[j] = hist_values_[j+1];
+	}
+	hist_timestamps_[3] = timestamp;
+	hist_values_[3] = value;
+
+	if (hist_count_ < 4) {
+		if (++hist_count_ < 4)
+			return;
+
+		// Catch up with the segments of the first samples
+		interpolate_segment(0);
+		interpolate_segment(1);
+		if (interpolation_method_ == InterpolationMethod::Linear)
+			interpolate_segment(2);
+		return;
+	}
+
+	if (interpolation_method_ == InterpolationMethod::Linear)
+		interpolate_segment(2);
+	else
+		interpolate_segment(1);
+}
+
+void ResampleChannel::init_grid()
+{
+	// The median is robust against single gaps and jitter
+	vector<double> intervals;
+	for (size_t i=1; i<pending_timestamps_.size(); ++i)
+		intervals.push_back(pending_timestamps_[i] - pending_timestamps_[i-1]);
+	auto median = intervals.begin() + intervals.size() / 2;
+	std::nth_element(intervals.begin(), median, intervals.end());
+
+	double input_samplerate = 1. / *median;
+	long decimation = std::lround(input_samplerate / samplerate_);
+	decimation_ = (uint)std::max(1L, std::min(decimation, (long)MaxDecimation));
+
+	grid_start_timestamp_ = pending_timestamps_[0];
+	grid_interval_ = 1. / (samplerate_ * decimation_);
+	grid_index_ = 0;
+	grid_initialized_ = true;
+
+	if (decimation_ > 1) {
+		// Windowed sinc (Blackman) low-pass with the cutoff slightly below
+		// the output nyquist frequency.
+		const size_t length = FilterTapsPerPhase * decimation_ + 1;
+		const double cutoff = 0.45 / decimation_;
+		const double center = (double)(length - 1) / 2.;
+		fir_coefficients_.resize(length);
+		double sum = 0.;
+		for (size_t i=0; i<length; ++i) {
+			double x = (double)i - center;
+			double sinc = (x == 0) ?
+				2 * cutoff : std::sin(2 * M_PI * cutoff * x) / (M_PI * x);
+			double w = 2 * M_PI * (double)i / (double)(length - 1);
+			double window = 0.42 - 0.5 * std::cos(w) + 0.08 * std::cos(2 * w);
+			fir_coefficients_[i] = sinc * window;
+			sum += fir_coefficients_[i];
+		}
+		for (auto &coefficient : fir_coefficients_)
+			coefficient /= sum;
+
+		fir_buffer_.assign(2 * length, 0.);
+		fir_pos_ = 0;
+	}
+}
+
+void ResampleChannel::interpolate_segment(size_t a)
+{
+	const size_t b = a + 1;
+	const double t1 = hist_timestamps_[a];
+	const double v1 = hist_values_[a];
+	const double t2 = hist_timestamps_[b];
+	const double v2 = hist_values_[b];
+	const double h = t2 - t1;
+
+	// Catmull-Rom tangents for non-uniform spacing
+	double m1 = 0.;
+	double m2 = 0.;
+	if (interpolation_method_ == InterpolationMethod::Cubic) {
+		size_t a0 = (a > 0) ? a - 1 : a;
+		size_t b1 = (b < 3) ? b + 1 : b;
+		m1 = (v2 - hist_values_[a0]) / (t2 - hist_timestamps_[a0]);
+		m2 = (hist_values_[b1] - v1) / (hist_timestamps_[b1] - t1);
+	}
+
+	while (true) {
+		double timestamp = grid_start_timestamp_ +
+			(double)grid_index_ * grid_interval_;
+		if (timestamp > t2)
+			break;
+
+		double s = (timestamp - t1) / h;
+		double value;
+		if (interpolation_method_ == InterpolationMethod::Cubic) {
+			double s2 = s * s;
+			double s3 = s2 * s;
+			value = (2 * s3 - 3 * s2 + 1) * v1 +
+				(s3 - 2 * s2 + s) * h * m1 +
+				(-2 * s3 + 3 * s2) * v2 +
+				(s3 - s2) * h * m2;
+		}
+		else {
+			value = v1 + (v2 - v1) * s;
+		}
+
+		push_grid_sample(value);
+		++grid_index_;
+	}
+}
+
+void ResampleChannel::push_grid_sample(double value)
+{
+	if (decimation_ <= 1) {
+		out_timestamps_.push_back(grid_start_timestamp_ +
+			(double)grid_index_ * grid_interval_);
+		out_values_.push_back(value);
+		return;
+	}
+
+	// The ring buffer is doubled, so the filter input is always contiguous
+	const size_t length = fir_coefficients_.size();
+	fir_buffer_[fir_pos_] = value;
+	fir_buffer_[fir_pos_ + length] = value;
+	if (++fir_pos_ >= length)
+		fir_pos_ = 0;
+
+	if (grid_index_ + 1 < length)
+		return;
+
+	// Only calculate the filter for the grid samples that are output samples
+	uint64_t center_index = grid_index_ - (length - 1) / 2;
+	if (center_index % decimation_ != 0)
+		return;
+
+	const double *samples = fir_buffer_.data() + fir_pos_;
+	double filtered = 0.;
+	for (size_t i=0; i<length; ++i)
+		filtered += fir_coefficients_[i] * samples[i];
+
+	out_timestamps_.push_back(grid_start_timestamp_ +
+		(double)center_index * grid_interval_);
+	out_values_.push_back(filtered);
+}
+
+} // namespace channels
+} // namespace sv
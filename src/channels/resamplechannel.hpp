@@ -0,0 +1,155 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_RESAMPLECHANNEL_HPP
+#define CHANNELS_RESAMPLECHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class InterpolationMethod {
+	Linear,
+	/**
+	 * Cubic Hermite spline with Catmull-Rom tangents for non-uniform
+	 * spacing. The output is delayed by one input sample.
+	 */
+	Cubic
+};
+
+/**
+ * Resample an (irregular) AnalogTimeSignal to a uniform grid with the given
+ * samplerate.
+ *
+ * The input is interpolated to an intermediate uniform grid. When the input
+ * samplerate is higher than the output samplerate, the intermediate grid runs
+ * at `decimation` times the output samplerate (the ratio of the input to the
+ * output samplerate) and is low-pass
+ * filtered and decimated by a FIR filter, that is only evaluated for the
+ * output samples (polyphase decimation).
+ *
+ * The input samplerate is estimated from the median interval of the first
+ * `RateEstimationSamples` input samples, so single gaps or jitter don't
+ * change the filter length. The output starts, when these samples have
+ * been received.
+ */
+class ResampleChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	ResampleChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		double samplerate,
+		InterpolationMethod interpolation_method,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+private:
+	/** Taps per decimation step of the anti-aliasing filter. */
+	static const uint FilterTapsPerPhase;
+	/** Maximum decimation factor, limits the filter length. */
+	static const uint MaxDecimation;
+	/** Number of input samples to estimate the input samplerate from. */
+	static const size_t RateEstimationSamples;
+
+	/**
+	 * Estimate the decimation factor from the pending samples and create the
+	 * anti-aliasing filter.
+	 */
+	void init_grid();
+	/** Add an input sample to the history and interpolate the grid. */
+	void add_sample(double timestamp, double value);
+	/**
+	 * Interpolate all grid points in the segment between the history samples
+	 * `a` and `a + 1`.
+	 */
+	void interpolate_segment(size_t a);
+	/** Feed one interpolated grid sample into the decimation filter. */
+	void push_grid_sample(double value);
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	double samplerate_;
+	InterpolationMethod interpolation_method_;
+	size_t next_signal_pos_;
+	double last_input_timestamp_;
+
+	/** The first input samples, until the grid is initialized. */
+	vector<double> pending_timestamps_;
+	vector<double> pending_values_;
+
+	/** The last 4 input samples, [3] is the newest one. */
+	double hist_timestamps_[4];
+	double hist_values_[4];
+	size_t hist_count_;
+
+	bool grid_initialized_;
+	double grid_start_timestamp_;
+	double grid_interval_;
+	uint64_t grid_index_;
+	uint decimation_;
+
+	/** FIR anti-aliasing filter and a doubled ring buffer for it. */
+	vector<double> fir_coefficients_;
+	vector<double> fir_buffer_;
+	size_t fir_pos_;
+
+	vector<double> in_timestamps_;
+	vector<double> in_values_;
+	vector<double> out_timestamps_;
+	vector<double> out_values_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_RESAMPLECHANNEL_HPP
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QDebug>
+
+#include "rollingstatschannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/rollingstatistics.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+RollingStatsChannel::RollingStatsChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		RollingStatistic statistic,
+		size_t window_sample_count,
+		double window_time,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	statistic_(statistic),
+	rolling_statistics_(window_sample_count, window_time),
+	next_signal_pos_(0)
+{
+	assert(signal_);
+	assert(window_sample_count > 0 || window_time > 0);
+
+	total_digits_ = signal_->total_digits();
+	sr_digits_ = signal_->sr_digits();
+
+	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
+		this, &RollingStatsChannel::on_sample_appended);
+}
+
+void RollingStatsChannel::on_sample_appended()
+{
+	size_t signal_sample_count = signal_->sample_count();
+	if (next_signal_pos_ >= signal_sample_count)
+		return;
+
+	size_t count = signal_->get_samples(
+		next_signal_pos_, signal_sample_count,
+		in_timestamps_, in_values_, false);
+	next_signal_pos_ += count;
+
+	out_values_.resize(count);
+	for (size_t i=0; i<count; ++i) {
+		rolling_statistics_.add(in_timestamps_[i], in_values_[i]);
+		out_values_[i] = statistic_value();
+	}
+
+	push_samples(out_values_, in_timestamps_);
+}
+
+double RollingStatsChannel::statistic_value() const
+{
+	switch (statistic_) {
+	case RollingStatistic::Min:
+		return rolling_statistics_.min();
+	case RollingStatistic::Max:
+		return rolling_statistics_.max();
+	case RollingStatistic::PeakToPeak:
+		return rolling_statistics_.peak_to_peak();
+	case RollingStatistic::Mean:
+		return rolling_statistics_.mean();
+	case RollingStatistic::StdDev:
+		return rolling_statistics_.stddev();
+	case RollingStatistic::RMS:
+		return rolling_statistics_.rms();
+	}
+	return 0.;
+}
+
+} // namespace channels
+} // namespace sv
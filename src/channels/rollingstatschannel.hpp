@@ -0,0 +1,110 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_ROLLINGSTATSCHANNEL_HPP
+#define CHANNELS_ROLLINGSTATSCHANNEL_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/rollingstatistics.hpp"
+
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+enum class RollingStatistic {
+	Min,
+	Max,
+	PeakToPeak,
+	Mean,
+	StdDev,
+	RMS
+};
+
+/**
+ * A statistic value of a signal over a sliding window, that is defined by a
+ * sample count or by a time span (e.g. "max ripple over the last 1 s").
+ * One sample is output for every input sample.
+ */
+class RollingStatsChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @param window_sample_count The number of samples in the window, 0 if
+	 *        the window is defined by `window_time`.
+	 * @param window_time The time span of the window in seconds, 0 if the
+	 *        window is defined by `window_sample_count`.
+	 */
+	RollingStatsChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		RollingStatistic statistic,
+		size_t window_sample_count,
+		double window_time,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+private:
+	double statistic_value() const;
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	RollingStatistic statistic_;
+	data::RollingStatistics rolling_statistics_;
+	size_t next_signal_pos_;
+
+	vector<double> in_timestamps_;
+	vector<double> in_values_;
+	vector<double> out_values_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_ROLLINGSTATSCHANNEL_HPP
@@ -0,0 +1,203 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <QDebug>
+
+#include "spectrumchannel.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/analogsamplesignal.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/fft.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::make_shared;
+using std::set;
+using std::string;
+
+namespace sv {
+namespace channels {
+
+SpectrumChannel::SpectrumChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t window_size,
+		data::WindowFunction window_function,
+		double overlap,
+		uint avg_count,
+		bool with_phase,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp) :
+	MathChannel(quantity, quantity_flags, unit,
+		parent_device, channel_group_names, channel_name,
+		channel_start_timestamp),
+	signal_(signal),
+	window_size_(window_size),
+	avg_count_(avg_count > 0 ? avg_count : 1),
+	with_phase_(with_phase),
+	fft_(window_size),
+	window_(data::create_window(window_function, window_size)),
+	next_signal_pos_(0),
+	bin_width_(0.),
+	frame_pos_(0),
+	avg_frames_(0)
+{
+	assert(signal_);
+	assert(window_size_ > 1);
+
+	total_digits_ = signal_->total_digits();
+	sr_digits_ = signal_->sr_digits();
+
+	// Magnitude and phase are two signals in this channel
+	fixed_signal_ = !with_phase_;
+
+	overlap = std::max(0., std::min(overlap, 0.99));
+	hop_size_ = (size_t)std::lround((double)window_size_ * (1. - overlap));
+	if (hop_size_ < 1)
+		hop_size_ = 1;
+
+	window_sum_ = 0.;
+	for (const auto &w : window_)
+		window_sum_ += w;
+
+	const size_t bin_count = window_size_ / 2 + 1;
+	windowed_.resize(window_size_);
+	fft_out_.resize(window_size_);
+	power_sum_.assign(bin_count, 0.);
+	magnitude_.resize(bin_count);
+	phase_.resize(bin_count);
+
+	connect(signal_.get(), &data::AnalogTimeSignal::sample_appended,
+		this, &SpectrumChannel::on_sample_appended);
+}
+
+void SpectrumChannel::init_signals()
+{
+	/*
+	 * The phase signal is added first, so the magnitude signal will be the
+	 * actual signal of this channel.
+	 */
+	if (with_phase_) {
+		phase_signal_ = make_shared<data::AnalogSampleSignal>(
+			data::Quantity::PhaseAngle, set<data::QuantityFlag>(),
+			data::Unit::Degree, shared_from_this(), name_ + " phase");
+		add_signal(phase_signal_);
+	}
+
+	magnitude_signal_ = make_shared<data::AnalogSampleSignal>(
+		quantity_, quantity_flags_, unit_, shared_from_this());
+	add_signal(magnitude_signal_);
+}
+
+double SpectrumChannel::bin_width() const
+{
+	return bin_width_;
+}
+
+void SpectrumChannel::on_sample_appended()
+{
+	size_t signal_sample_count = signal_->sample_count();
+	while (next_signal_pos_ < signal_sample_count) {
+		auto sample = signal_->get_sample(next_signal_pos_, false);
+		timestamps_.push_back(sample.first);
+		samples_.push_back(sample.second);
+		++next_signal_pos_;
+
+		if (samples_.size() - frame_pos_ >= window_size_) {
+			process_frame();
+			frame_pos_ += hop_size_;
+		}
+	}
+
+	// Drop the samples, that are not needed for the next frames anymore
+	if (frame_pos_ >= window_size_) {
+		size_t drop = std::min(frame_pos_, samples_.size());
+		samples_.erase(samples_.begin(), samples_.begin() + drop);
+		timestamps_.erase(timestamps_.begin(), timestamps_.begin() + drop);
+		frame_pos_ -= drop;
+	}
+}
+
+void SpectrumChannel::process_frame()
+{
+	const double *frame = samples_.data() + frame_pos_;
+	for (size_t i=0; i<window_size_; ++i)
+		windowed_[i] = frame[i] * window_[i];
+
+	fft_.transform_real(windowed_.data(), fft_out_.data(), fft_buffer_);
+
+	const size_t bin_count = power_sum_.size();
+	for (size_t i=0; i<bin_count; ++i)
+		power_sum_[i] += std::norm(fft_out_[i]);
+	++avg_frames_;
+
+	if (avg_frames_ < avg_count_)
+		return;
+
+	// Estimate the sample rate from the timestamps of the frame
+	double frame_time = timestamps_[frame_pos_ + window_size_ - 1] -
+		timestamps_[frame_pos_];
+	if (frame_time > 0) {
+		double samplerate = (double)(window_size_ - 1) / frame_time;
+		bin_width_ = samplerate / (double)window_size_;
+	}
+
+	publish_spectrum();
+}
+
+void SpectrumChannel::publish_spectrum()
+{
+	const size_t bin_count = power_sum_.size();
+	for (size_t i=0; i<bin_count; ++i) {
+		// Single sided amplitude spectrum, corrected for the window gain
+		double amplitude = std::sqrt(power_sum_[i] / avg_frames_) / window_sum_;
+		if (i > 0 && i < window_size_ - i)
+			amplitude *= 2;
+		magnitude_[i] = amplitude;
+		if (with_phase_)
+			phase_[i] = std::arg(fft_out_[i]) * 180. / M_PI;
+	}
+
+	std::fill(power_sum_.begin(), power_sum_.end(), 0.);
+	avg_frames_ = 0;
+
+	if (magnitude_signal_) {
+		magnitude_signal_->set_samples(magnitude_.data(), bin_count,
+			size_of_double_, total_digits_, sr_digits_);
+	}
+	if (phase_signal_) {
+		phase_signal_->set_samples(phase_.data(), bin_count,
+			size_of_double_, total_digits_, sr_digits_);
+	}
+}
+
+} // namespace channels
+} // namespace sv
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANNELS_SPECTRUMCHANNEL_HPP
+#define CHANNELS_SPECTRUMCHANNEL_HPP
+
+#include <complex>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "src/channels/basechannel.hpp"
+#include "src/channels/mathchannel.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/fft.hpp"
+
+using std::complex;
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogSampleSignal;
+class AnalogTimeSignal;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace channels {
+
+/**
+ * Short-time fourier transform of an AnalogTimeSignal.
+ *
+ * The input samples are collected into frames of `window_size` samples, which
+ * overlap by the `overlap` fraction. Each frame is windowed and transformed,
+ * the single-sided amplitude spectrum (and optionally the phase) is published
+ * as an AnalogSampleSignal where the position is the bin index. When
+ * `avg_count` is greater than 1, the power of `avg_count` consecutive frames
+ * is averaged before publishing (Welch's method).
+ *
+ * The input signal is assumed to be sampled uniformly. The bin width is
+ * estimated from the timestamps of each frame.
+ */
+class SpectrumChannel : public MathChannel
+{
+	Q_OBJECT
+
+public:
+	SpectrumChannel(
+		data::Quantity quantity,
+		const set<data::QuantityFlag> &quantity_flags,
+		data::Unit unit,
+		shared_ptr<data::AnalogTimeSignal> signal,
+		size_t window_size,
+		data::WindowFunction window_function,
+		double overlap,
+		uint avg_count,
+		bool with_phase,
+		shared_ptr<devices::BaseDevice> parent_device,
+		const set<string> &channel_group_names,
+		const string &channel_name,
+		double channel_start_timestamp);
+
+	/**
+	 * Create the magnitude signal and, if enabled, the phase signal.
+	 */
+	void init_signals() override;
+
+	/**
+	 * Return the width of a frequency bin in Hz of the last published
+	 * spectrum. The frequency of bin `pos` is `pos * bin_width()`.
+	 */
+	double bin_width() const;
+
+private:
+	void process_frame();
+	void publish_spectrum();
+
+	shared_ptr<data::AnalogTimeSignal> signal_;
+	size_t window_size_;
+	size_t hop_size_;
+	uint avg_count_;
+	bool with_phase_;
+	data::FFT fft_;
+	vector<double> window_;
+	double window_sum_;
+	size_t next_signal_pos_;
+	double bin_width_;
+
+	/** Collected input samples, the next frame starts at `frame_pos_`. */
+	vector<double> samples_;
+	vector<double> timestamps_;
+	size_t frame_pos_;
+
+	vector<double> windowed_;
+	vector<complex<double>> fft_buffer_;
+	vector<complex<double>> fft_out_;
+	vector<double> power_sum_;
+	uint avg_frames_;
+	vector<double> magnitude_;
+	vector<double> phase_;
+
+	shared_ptr<data::AnalogSampleSignal> magnitude_signal_;
+	shared_ptr<data::AnalogSampleSignal> phase_signal_;
+
+private Q_SLOTS:
+	void on_sample_appended();
+
+};
+
+} // namespace channels
+} // namespace sv
+
+#endif // CHANNELS_SPECTRUMCHANNEL_HPP
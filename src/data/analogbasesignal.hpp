@@ -94,9 +94,9 @@ public:
 	int total_digits() const;
 	/** digits from ....digits */
 	int sr_digits() const;
-	double last_value() const;
-	double min_value() const;
-	double max_value() const;
+	virtual double last_value() const;
+	virtual double min_value() const;
+	virtual double max_value() const;
 
 	/*
 	static void combine_signals(
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
@@ -139,6 +140,99 @@ void AnalogSampleSignal::push_sample(void *sample, uint32_t pos,
 		Q_EMIT digits_changed(total_digits_, sr_digits_);
 }
 
+void AnalogSampleSignal::push_samples(void *data, uint64_t samples,
+	uint32_t pos, size_t unit_size, int total_digits, int sr_digits)
+{
+	if (samples == 0)
+		return;
+
+	double dsample = 0.;
+	pos_->reserve(pos_->size() + samples);
+	data_->reserve(data_->size() + samples);
+	for (uint64_t i=0; i<samples; ++i) {
+		if (unit_size == size_of_float_)
+			dsample = static_cast<double>(static_cast<float *>(data)[i]);
+		else if (unit_size == size_of_double_)
+			dsample = static_cast<double *>(data)[i];
+
+		// TODO: Mutex?
+		if (min_value_ > dsample)
+			min_value_ = dsample;
+		// Ignore infinitiy (overflow) as max value.
+		if (max_value_ < dsample &&
+			dsample != std::numeric_limits<double>::infinity()) {
+
+			max_value_ = dsample;
+		}
+
+		pos_->push_back(pos + (uint32_t)i);
+		data_->push_back(dsample);
+		++sample_count_;
+	}
+
+	last_pos_ = pos + (uint32_t)(samples - 1);
+	last_value_ = dsample;
+	Q_EMIT sample_appended();
+
+	bool digits_chngd = false;
+	if (total_digits != total_digits_) {
+		total_digits_ = total_digits;
+		digits_chngd = true;
+	}
+	if (sr_digits != sr_digits_) {
+		sr_digits_ = sr_digits;
+		digits_chngd = true;
+	}
+	if (digits_chngd)
+		Q_EMIT digits_changed(total_digits_, sr_digits_);
+}
+
+void AnalogSampleSignal::set_samples(void *data, uint64_t samples,
+	size_t unit_size, int total_digits, int sr_digits)
+{
+	pos_->resize(samples);
+	data_->resize(samples);
+	min_value_ = std::numeric_limits<double>::max();
+	max_value_ = std::numeric_limits<double>::lowest();
+
+	double dsample = 0.;
+	for (uint64_t i=0; i<samples; ++i) {
+		if (unit_size == size_of_float_)
+			dsample = static_cast<double>(static_cast<float *>(data)[i]);
+		else if (unit_size == size_of_double_)
+			dsample = static_cast<double *>(data)[i];
+
+		if (min_value_ > dsample)
+			min_value_ = dsample;
+		// Ignore infinitiy (overflow) as max value.
+		if (max_value_ < dsample &&
+			dsample != std::numeric_limits<double>::infinity()) {
+
+			max_value_ = dsample;
+		}
+
+		(*pos_)[i] = (uint32_t)i;
+		(*data_)[i] = dsample;
+	}
+
+	sample_count_ = samples;
+	last_pos_ = samples > 0 ? (uint32_t)(samples - 1) : 0;
+	last_value_ = dsample;
+	Q_EMIT samples_changed();
+
+	bool digits_chngd = false;
+	if (total_digits != total_digits_) {
+		total_digits_ = total_digits;
+		digits_chngd = true;
+	}
+	if (sr_digits != sr_digits_) {
+		sr_digits_ = sr_digits;
+		digits_chngd = true;
+	}
+	if (digits_chngd)
+		Q_EMIT digits_changed(total_digits_, sr_digits_);
+}
+
 uint32_t AnalogSampleSignal::first_pos() const
 {
 	if (pos_->empty())
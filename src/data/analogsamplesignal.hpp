@@ -70,6 +70,21 @@ public:
 	void push_sample(void *sample, uint32_t pos,
 		size_t unit_size, int total_digits, int sr_digits);
 
+	/**
+	 * Push multiple samples with consecutive positions, starting at `pos`, to
+	 * the signal. `sample_appended()` is only emitted once for all samples.
+	 */
+	void push_samples(void *data, uint64_t samples, uint32_t pos,
+		size_t unit_size, int total_digits, int sr_digits);
+
+	/**
+	 * Replace all samples of the signal with the samples at the positions
+	 * 0..`samples`-1. The existing samples are overwritten in place and only
+	 * `samples_changed()` is emitted.
+	 */
+	void set_samples(void *data, uint64_t samples,
+		size_t unit_size, int total_digits, int sr_digits);
+
 	uint32_t first_pos() const;
 	uint32_t last_pos() const;
 
@@ -86,6 +101,9 @@ private:
 	shared_ptr<vector<uint32_t>> pos_;
 	uint32_t last_pos_;
 
+Q_SIGNALS:
+	void samples_changed();
+
 };
 
 } // namespace data
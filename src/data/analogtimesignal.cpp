@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cassert>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -31,12 +32,16 @@
 #include "src/channels/basechannel.hpp"
 #include "src/data/basesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/samplestatistics.hpp"
 
 using std::make_pair;
+using std::lock_guard;
 using std::make_shared;
+using std::mutex;
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::unique_lock;
 using std::vector;
 
 namespace sv {
@@ -50,6 +55,7 @@ AnalogTimeSignal::AnalogTimeSignal(
 		double signal_start_timestamp,
 		const string &custom_name) :
 	AnalogBaseSignal(quantity, quantity_flags, unit, parent_channel, custom_name),
+	next_statistics_epoch_id_(0),
 	signal_start_timestamp_(signal_start_timestamp),
 	last_timestamp_(0.)
 {
@@ -62,14 +68,43 @@ AnalogTimeSignal::AnalogTimeSignal(
 
 void AnalogTimeSignal::clear()
 {
-	// TODO: mutex
-	time_->clear();
-	data_->clear();
-	sample_count_ = 0;
+	{
+		lock_guard<mutex> lock(samples_mutex_);
+		time_->clear();
+		data_->clear();
+		sample_count_ = 0;
+		for (auto &epoch : statistics_epochs_)
+			epoch.second.reset();
+		interval_statistics_.reset();
+	}
 
 	Q_EMIT samples_cleared();
 }
 
+size_t AnalogTimeSignal::sample_count() const
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	return sample_count_;
+}
+
+double AnalogTimeSignal::last_value() const
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	return last_value_;
+}
+
+double AnalogTimeSignal::min_value() const
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	return min_value_;
+}
+
+double AnalogTimeSignal::max_value() const
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	return max_value_;
+}
+
 analog_time_sample_t AnalogTimeSignal::get_sample(
 	size_t pos, bool relative_time) const
 {
@@ -78,6 +113,7 @@ analog_time_sample_t AnalogTimeSignal::get_sample(
 	//qWarning() << "AnalogSignal::get_sample(" << pos
 	//	<< "): sample_count_ = " << sample_count_;
 
+	lock_guard<mutex> lock(samples_mutex_);
 	if (pos < sample_count_) {
 		double timestamp = time_->at(pos);
 		if (relative_time)
@@ -90,9 +126,64 @@ analog_time_sample_t AnalogTimeSignal::get_sample(
 	return make_pair(0., 0.);
 }
 
+size_t AnalogTimeSignal::get_samples(size_t pos, size_t end_pos,
+	vector<double> &timestamps, vector<double> &values,
+	bool relative_time) const
+{
+	timestamps.clear();
+	values.clear();
+
+	lock_guard<mutex> lock(samples_mutex_);
+	if (end_pos > sample_count_)
+		end_pos = sample_count_;
+	if (pos >= end_pos)
+		return 0;
+
+	timestamps.assign(time_->begin() + pos, time_->begin() + end_pos);
+	values.assign(data_->begin() + pos, data_->begin() + end_pos);
+	if (relative_time) {
+		for (auto &timestamp : timestamps)
+			timestamp -= signal_start_timestamp_;
+	}
+
+	return end_pos - pos;
+}
+
+size_t AnalogTimeSignal::get_samples_at(const size_t *positions, size_t count,
+	vector<double> &timestamps, vector<double> &values,
+	bool relative_time) const
+{
+	timestamps.clear();
+	values.clear();
+
+	lock_guard<mutex> lock(samples_mutex_);
+	for (size_t i=0; i<count && positions[i]<sample_count_; ++i) {
+		timestamps.push_back((*time_)[positions[i]]);
+		values.push_back((*data_)[positions[i]]);
+	}
+	if (relative_time) {
+		for (auto &timestamp : timestamps)
+			timestamp -= signal_start_timestamp_;
+	}
+
+	return timestamps.size();
+}
+
+size_t AnalogTimeSignal::find_sample_pos(
+	double timestamp, bool relative_time) const
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	if (relative_time)
+		timestamp += signal_start_timestamp_;
+
+	auto end = time_->begin() + sample_count_;
+	return std::lower_bound(time_->begin(), end, timestamp) - time_->begin();
+}
+
 analog_time_sample_t AnalogTimeSignal::get_last_sample(bool relative_time) const
 {
 	// TODO: retrun reference (&double)? See get_value_at_timestamp()
+	lock_guard<mutex> lock(samples_mutex_);
 	if (sample_count_ == 0)
 		return make_pair(0., 0.);
 
@@ -106,6 +197,7 @@ analog_time_sample_t AnalogTimeSignal::get_last_sample(bool relative_time) const
 bool AnalogTimeSignal::get_value_at_timestamp(
 	double timestamp, double &value, bool relative_time) const
 {
+	lock_guard<mutex> lock(samples_mutex_);
 	if (time_->empty())
 		return false;
 	if (timestamp < time_->at(0))
@@ -160,33 +252,82 @@ void AnalogTimeSignal::push_sample(void *sample, double timestamp,
 		<< ": sample_count_ = " << sample_count_+1;
 	*/
 
-	// TODO: Mutex?
-	last_timestamp_ = timestamp;
-	last_value_ = dsample;
-	if (min_value_ > dsample)
-		min_value_ = dsample;
-	// Ignore infinitiy (overflow) as max value.
-	if (max_value_ < dsample &&
-		dsample != std::numeric_limits<double>::infinity()) {
+	{
+		lock_guard<mutex> lock(samples_mutex_);
+		last_timestamp_ = timestamp;
+		last_value_ = dsample;
+		if (min_value_ > dsample)
+			min_value_ = dsample;
+		// Ignore infinitiy (overflow) as max value.
+		if (max_value_ < dsample &&
+			dsample != std::numeric_limits<double>::infinity()) {
+
+			max_value_ = dsample;
+		}
 
-		max_value_ = dsample;
+		time_->push_back(timestamp);
+		data_->push_back(dsample);
+		sample_count_++;
+		interval_statistics_.add(timestamp);
+		for (auto &epoch : statistics_epochs_)
+			epoch.second.add(dsample);
 	}
+	Q_EMIT sample_appended();
 
-	/*
-	qWarning() << "AnalogTimeSignal::push_sample(): " << display_name()
-		<< ": last_timestamp_ = " << last_timestamp_;
-	qWarning() << "AnalogTimeSignal::push_sample(): " << display_name()
-		<< ": last_value_ = " << last_value_;
-	qWarning() << "AnalogTimeSignal::push_sample(): " << display_name()
-		<< ": min_value_ = " << min_value_;
-	qWarning() << "AnalogTimeSignal::push_sample(): " << display_name()
-		<< ": max_value_ = " << max_value_;
-	*/
+	bool digits_chngd = false;
+	if (total_digits != total_digits_) {
+		total_digits_ = total_digits;
+		digits_chngd = true;
+	}
+	if (sr_digits != sr_digits_) {
+		sr_digits_ = sr_digits;
+		digits_chngd = true;
+	}
+	if (digits_chngd)
+		Q_EMIT digits_changed(total_digits_, sr_digits_);
+}
+
+void AnalogTimeSignal::push_samples(const vector<double> &timestamps,
+	const vector<double> &samples, int total_digits, int sr_digits)
+{
+	assert(timestamps.size() == samples.size());
+	push_samples(timestamps.data(), samples.data(), samples.size(),
+		total_digits, sr_digits);
+}
+
+void AnalogTimeSignal::push_samples(const double *timestamps,
+	const double *samples, size_t count, int total_digits, int sr_digits)
+{
+	if (count == 0)
+		return;
 
-	// TODO: Mutex?
-	time_->push_back(timestamp);
-	data_->push_back(dsample);
-	sample_count_++;
+	// TODO: Limit memory!
+	{
+		lock_guard<mutex> lock(samples_mutex_);
+		for (size_t i=0; i<count; ++i) {
+			const double dsample = samples[i];
+			if (min_value_ > dsample)
+				min_value_ = dsample;
+			// Ignore infinitiy (overflow) as max value.
+			if (max_value_ < dsample &&
+				dsample != std::numeric_limits<double>::infinity()) {
+
+				max_value_ = dsample;
+			}
+		}
+		last_timestamp_ = timestamps[count - 1];
+		last_value_ = samples[count - 1];
+
+		time_->insert(time_->end(), timestamps, timestamps + count);
+		data_->insert(data_->end(), samples, samples + count);
+		sample_count_ += count;
+		for (auto &epoch : statistics_epochs_) {
+			for (size_t i=0; i<count; ++i)
+				epoch.second.add(samples[i]);
+		}
+		for (size_t i=0; i<count; ++i)
+			interval_statistics_.add(timestamps[i]);
+	}
 	Q_EMIT sample_appended();
 
 	bool digits_chngd = false;
@@ -206,8 +347,6 @@ void AnalogTimeSignal::push_samples(void *data,
 	uint64_t samples, double timestamp, uint64_t samplerate, size_t unit_size,
 	int total_digits, int sr_digits)
 {
-	//lock_guard<recursive_mutex> lock(mutex_);
-
 	double dsample = 0.0;
 	uint64_t pos = 0;
 	double time_stride = 0.0;
@@ -223,6 +362,8 @@ void AnalogTimeSignal::push_samples(void *data,
 	}
 	*/
 
+	unique_lock<mutex> lock(samples_mutex_);
+	interval_statistics_.add_uniform(timestamp, time_stride, samples);
 	while (pos < samples) {
 		if (unit_size == size_of_float_)
 			dsample = static_cast<double>(static_cast<float *>(data)[pos]);
@@ -237,7 +378,6 @@ void AnalogTimeSignal::push_samples(void *data,
 			<< ": remaining_samples = " << remaining_samples;
 		*/
 
-		// TODO: Mutex?
 		if (min_value_ > dsample)
 			min_value_ = dsample;
 		// Ignore infinitiy (overflow) as max value.
@@ -250,14 +390,19 @@ void AnalogTimeSignal::push_samples(void *data,
 		// TODO: Limit memory!
 		time_->push_back(timestamp);
 		data_->push_back(dsample);
+		for (auto &epoch : statistics_epochs_)
+			epoch.second.add(dsample);
 
 		timestamp += time_stride;
 		++pos;
 		++sample_count_;
 	}
+	if (samples > 0) {
+		last_timestamp_ = timestamp - time_stride;
+		last_value_ = dsample;
+	}
+	lock.unlock();
 
-	last_timestamp_ = timestamp - time_stride;
-	last_value_ = dsample;
 	Q_EMIT sample_appended();
 
 	bool digits_chngd = false;
@@ -273,13 +418,52 @@ void AnalogTimeSignal::push_samples(void *data,
 		Q_EMIT digits_changed(total_digits_, sr_digits_);
 }
 
+size_t AnalogTimeSignal::open_statistics_epoch()
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	const size_t epoch_id = next_statistics_epoch_id_++;
+	statistics_epochs_[epoch_id] = SampleStatistics();
+	return epoch_id;
+}
+
+void AnalogTimeSignal::close_statistics_epoch(size_t epoch_id)
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	statistics_epochs_.erase(epoch_id);
+}
+
+void AnalogTimeSignal::reset_statistics_epoch(size_t epoch_id)
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	auto it = statistics_epochs_.find(epoch_id);
+	if (it != statistics_epochs_.end())
+		it->second.reset();
+}
+
+SampleStatistics AnalogTimeSignal::statistics_epoch(size_t epoch_id) const
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	auto it = statistics_epochs_.find(epoch_id);
+	if (it == statistics_epochs_.end())
+		return SampleStatistics();
+	return it->second;
+}
+
+IntervalStatistics AnalogTimeSignal::interval_statistics() const
+{
+	lock_guard<mutex> lock(samples_mutex_);
+	return interval_statistics_;
+}
+
 double AnalogTimeSignal::signal_start_timestamp() const
 {
+	lock_guard<mutex> lock(samples_mutex_);
 	return signal_start_timestamp_;
 }
 
 double AnalogTimeSignal::first_timestamp(bool relative_time) const
 {
+	lock_guard<mutex> lock(samples_mutex_);
 	if (time_->empty())
 		return 0.;
 
@@ -291,6 +475,7 @@ double AnalogTimeSignal::first_timestamp(bool relative_time) const
 
 double AnalogTimeSignal::last_timestamp(bool relative_time) const
 {
+	lock_guard<mutex> lock(samples_mutex_);
 	if (time_->empty())
 		return 0.;
 
@@ -302,7 +487,10 @@ double AnalogTimeSignal::last_timestamp(bool relative_time) const
 
 void AnalogTimeSignal::on_channel_start_timestamp_changed(double timestamp)
 {
-	signal_start_timestamp_ = timestamp;
+	{
+		lock_guard<mutex> lock(samples_mutex_);
+		signal_start_timestamp_ = timestamp;
+	}
 	Q_EMIT signal_start_timestamp_changed(timestamp);
 }
 
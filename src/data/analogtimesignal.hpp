@@ -20,7 +20,9 @@
 #ifndef DATA_ANALOGTIMESIGNAL_HPP
 #define DATA_ANALOGTIMESIGNAL_HPP
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -30,7 +32,11 @@
 
 #include "src/data/analogbasesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/intervalstatistics.hpp"
+#include "src/data/samplestatistics.hpp"
 
+using std::map;
+using std::mutex;
 using std::pair;
 using std::set;
 using std::shared_ptr;
@@ -60,11 +66,48 @@ public:
 	 */
 	void clear() override;
 
+	size_t sample_count() const override;
+	double last_value() const override;
+	double min_value() const override;
+	double max_value() const override;
+
 	/**
 	 * Return the sample at the given position.
 	 */
 	analog_time_sample_t get_sample(size_t pos, bool relative_time) const;
 
+	/**
+	 * Copy the samples from position `pos` up to (but not including)
+	 * `end_pos` to `timestamps` and `values`. The vectors are cleared first,
+	 * so they can be reused by the caller to avoid allocations.
+	 *
+	 * This method is thread safe, it can be called while samples are pushed
+	 * to the signal from another thread.
+	 *
+	 * @return The number of copied samples.
+	 */
+	size_t get_samples(size_t pos, size_t end_pos,
+		vector<double> &timestamps, vector<double> &values,
+		bool relative_time) const;
+
+	/**
+	 * Copy the samples at the `count` ascending `positions` to `timestamps`
+	 * and `values`, like get_samples(). Positions beyond the end of the
+	 * signal are skipped. This method is thread safe.
+	 *
+	 * @return The number of copied samples.
+	 */
+	size_t get_samples_at(const size_t *positions, size_t count,
+		vector<double> &timestamps, vector<double> &values,
+		bool relative_time) const;
+
+	/**
+	 * Return the position of the first sample with a timestamp not less than
+	 * `timestamp`, or `sample_count()` if there is no such sample. This
+	 * method is thread safe.
+	 */
+	size_t find_sample_pos(double timestamp, bool relative_time) const;
+
 	/**
 	 * Return the last captured sample.
 	 */
@@ -94,12 +137,57 @@ public:
 	void push_sample(void *sample, double timestamp,
 		size_t unit_size, int total_digits, int sr_digits);
 
+	/**
+	 * Push multiple samples with individual timestamps to the signal.
+	 * `sample_appended()` is only emitted once for all samples.
+	 */
+	void push_samples(const vector<double> &timestamps,
+		const vector<double> &samples, int total_digits, int sr_digits);
+
+	/**
+	 * Push `count` samples with individual timestamps from contiguous
+	 * memory (e.g. a memory mapped file) to the signal.
+	 */
+	void push_samples(const double *timestamps, const double *samples,
+		size_t count, int total_digits, int sr_digits);
+
 	/**
 	 * Push multiple samples to the signal.
 	 */
 	void push_samples(void *data, uint64_t samples, double timestamp,
 		uint64_t samplerate, size_t unit_size, int total_digits, int sr_digits);
 
+	/**
+	 * Open a new statistics epoch and return its id.
+	 *
+	 * The statistics of all open epochs are updated while the samples are
+	 * pushed, so they include every sample, no matter how often they are
+	 * read. Each consumer (e.g. a view) opens its own epoch, so resetting
+	 * the statistics doesn't affect the other consumers. All epochs are
+	 * reset, when the signal is cleared.
+	 *
+	 * These methods are thread safe.
+	 */
+	size_t open_statistics_epoch();
+	void close_statistics_epoch(size_t epoch_id);
+	/**
+	 * Reset the statistics of the epoch, so only the following samples are
+	 * included. The existing samples are not scanned again.
+	 */
+	void reset_statistics_epoch(size_t epoch_id);
+	/**
+	 * Return a snapshot of the statistics of the epoch.
+	 */
+	SampleStatistics statistics_epoch(size_t epoch_id) const;
+
+	/**
+	 * Return a snapshot of the statistics of the intervals between the
+	 * timestamps of all samples. The statistics are updated while the
+	 * samples are pushed and reset when the signal is cleared. This method
+	 * is thread safe.
+	 */
+	IntervalStatistics interval_statistics() const;
+
 	double signal_start_timestamp() const;
 	double first_timestamp(bool relative_time) const;
 	double last_timestamp(bool relative_time) const;
@@ -131,6 +219,16 @@ public:
 
 private:
 	shared_ptr<vector<double>> time_;
+	/**
+	 * Guards the samples and all values derived from them (count, last/min/
+	 * max value, last timestamp and the statistics). The samples are pushed
+	 * in the acquisition thread, so every accessor takes this lock.
+	 */
+	mutable mutex samples_mutex_;
+	/** Open statistics epochs. */
+	map<size_t, SampleStatistics> statistics_epochs_;
+	size_t next_statistics_epoch_id_;
+	IntervalStatistics interval_statistics_;
 	double signal_start_timestamp_;
 	double last_timestamp_;
 
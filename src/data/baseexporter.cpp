@@ -0,0 +1,101 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QString>
+
+#include "baseexporter.hpp"
+#include "src/data/analogtimesignal.hpp"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+BaseExporter::BaseExporter(
+		const vector<shared_ptr<AnalogTimeSignal>> &signals,
+		const string &file_name) :
+	signals_(signals),
+	file_name_(file_name),
+	abort_(false),
+	progress_(-1)
+{
+}
+
+BaseExporter::~BaseExporter()
+{
+	// The derived class must have stopped the thread already.
+	assert(!export_thread_.joinable());
+}
+
+void BaseExporter::start()
+{
+	assert(!export_thread_.joinable());
+
+	for (const auto &signal : signals_)
+		sample_counts_.push_back(signal->sample_count());
+
+	export_thread_ = std::thread(&BaseExporter::run, this);
+}
+
+void BaseExporter::cancel()
+{
+	abort_ = true;
+}
+
+void BaseExporter::wait()
+{
+	cancel();
+	if (export_thread_.joinable())
+		export_thread_.join();
+}
+
+void BaseExporter::run()
+{
+	QString error = export_proc();
+	if (!error.isEmpty()) {
+		Q_EMIT finished(false, error);
+	}
+	else if (abort_) {
+		Q_EMIT finished(false, tr("Export canceled"));
+	}
+	else {
+		set_progress(1, 1);
+		Q_EMIT finished(true, QString());
+	}
+}
+
+void BaseExporter::set_progress(size_t done, size_t total)
+{
+	int progress = total > 0 ? (int)(done * 1000 / total) : 1000;
+	if (progress == progress_)
+		return;
+	progress_ = progress;
+	Q_EMIT progress_changed(progress_);
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_BASEEXPORTER_HPP
+#define DATA_BASEEXPORTER_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+
+using std::atomic;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+class AnalogTimeSignal;
+
+/**
+ * Base class for the export of AnalogTimeSignals to a file in a worker
+ * thread.
+ *
+ * The samples that exist when the export is started are written. The
+ * progress and the result are reported by signals, that are emitted in the
+ * worker thread.
+ *
+ * Derived classes must call `wait()` in their destructor, so the worker
+ * thread doesn't access the already destroyed derived object.
+ */
+class BaseExporter : public QObject
+{
+	Q_OBJECT
+
+public:
+	BaseExporter(const vector<shared_ptr<AnalogTimeSignal>> &signals,
+		const string &file_name);
+	virtual ~BaseExporter();
+
+	void start();
+	/** Abort the export, `finished()` is emitted with `false`. */
+	void cancel();
+
+protected:
+	/**
+	 * Write the file. This runs in the worker thread and must check
+	 * `abort_` regularly.
+	 *
+	 * @return An empty string on success, otherwise the error message.
+	 */
+	virtual QString export_proc() = 0;
+	/** Cancel the export and wait for the worker thread. */
+	void wait();
+	void set_progress(size_t done, size_t total);
+
+	const vector<shared_ptr<AnalogTimeSignal>> signals_;
+	const string file_name_;
+	/** The sample counts at the start of the export. */
+	vector<size_t> sample_counts_;
+	atomic<bool> abort_;
+
+private:
+	void run();
+
+	std::thread export_thread_;
+	int progress_;
+
+Q_SIGNALS:
+	/** The progress in permille. */
+	void progress_changed(int progress);
+	void finished(bool success, const QString &error);
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_BASEEXPORTER_HPP
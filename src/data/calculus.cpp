@@ -0,0 +1,60 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+
+#include "calculus.hpp"
+
+namespace sv {
+namespace data {
+
+double trapezoid_area(double t0, double f0, double t1, double f1)
+{
+	return 0.5 * (f0 + f1) * (t1 - t0);
+}
+
+double simpson_area(double t0, double f0, double t1, double f1,
+	double t2, double f2)
+{
+	double h0 = t1 - t0;
+	double h1 = t2 - t1;
+	if (h0 <= 0 || h1 <= 0)
+		return trapezoid_area(t0, f0, t1, f1) + trapezoid_area(t1, f1, t2, f2);
+
+	double h = h0 + h1;
+	return h / 6. * (
+		(2. - h1 / h0) * f0 +
+		(h * h / (h0 * h1)) * f1 +
+		(2. - h0 / h1) * f2);
+}
+
+double central_derivative(double t0, double f0, double t1, double f1,
+	double t2, double f2)
+{
+	double h0 = t1 - t0;
+	double h1 = t2 - t1;
+	assert(h0 > 0 && h1 > 0);
+
+	return -h1 / (h0 * (h0 + h1)) * f0 +
+		(h1 - h0) / (h0 * h1) * f1 +
+		h0 / (h1 * (h0 + h1)) * f2;
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,53 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_CALCULUS_HPP
+#define DATA_CALCULUS_HPP
+
+namespace sv {
+namespace data {
+
+/**
+ * Return the integral of the line through (t0, f0) and (t1, f1) from t0 to t1.
+ */
+double trapezoid_area(double t0, double f0, double t1, double f1);
+
+/**
+ * Return the integral of the parabola through (t0, f0), (t1, f1) and
+ * (t2, f2) from t0 to t2 (Simpson's rule for non-uniform spacing).
+ *
+ * If the spacing is not strictly increasing, the area of the two trapezoids
+ * is returned instead.
+ */
+double simpson_area(double t0, double f0, double t1, double f1,
+	double t2, double f2);
+
+/**
+ * Return the derivative at t1 of the parabola through (t0, f0), (t1, f1) and
+ * (t2, f2) (three-point central difference for non-uniform spacing).
+ *
+ * The timestamps must be strictly increasing.
+ */
+double central_derivative(double t0, double f0, double t1, double f1,
+	double t2, double f2);
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_CALCULUS_HPP
@@ -0,0 +1,65 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "chunkedbuffer.hpp"
+
+namespace sv {
+namespace data {
+
+const size_t ChunkedBuffer::ChunkShift;
+const size_t ChunkedBuffer::ChunkSize;
+const size_t ChunkedBuffer::MaxChunks = 16384;
+
+ChunkedBuffer::ChunkedBuffer() :
+	size_(0)
+{
+	// The chunk table must never be reallocated, see class description.
+	chunks_.reserve(MaxChunks);
+}
+
+bool ChunkedBuffer::push_back(double value)
+{
+	const size_t offset = size_ & (ChunkSize - 1);
+	if (offset == 0) {
+		if (chunks_.size() == MaxChunks)
+			return false;
+		chunks_.emplace_back(new double[ChunkSize]);
+	}
+	chunks_.back()[offset] = value;
+	++size_;
+	return true;
+}
+
+void ChunkedBuffer::clear()
+{
+	// Keeps the reserved chunk table
+	chunks_.clear();
+	size_ = 0;
+}
+
+size_t ChunkedBuffer::size() const
+{
+	return size_;
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,82 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_CHUNKEDBUFFER_HPP
+#define DATA_CHUNKEDBUFFER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using std::unique_ptr;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Append-only column of doubles, stored in chunks of `ChunkSize` values.
+ *
+ * Values never move once they are appended, and the chunk table is reserved
+ * for `MaxChunks` chunks up front, so it is never reallocated either. This
+ * way one thread can append values while another thread reads all values
+ * below a count, that the writer has published (e.g. under a mutex).
+ */
+class ChunkedBuffer
+{
+
+public:
+	ChunkedBuffer();
+
+	/**
+	 * Append a value. Must only be called by the writer thread. Returns
+	 * false, when the buffer is full.
+	 */
+	bool push_back(double value);
+	/**
+	 * Remove all values. Must only be called by the writer thread, while
+	 * there are no readers.
+	 */
+	void clear();
+
+	/**
+	 * Return the number of values. Must only be called by the writer thread,
+	 * readers must use the published count.
+	 */
+	size_t size() const;
+
+	double at(size_t pos) const
+	{
+		return chunks_[pos >> ChunkShift][pos & (ChunkSize - 1)];
+	}
+
+	static const size_t ChunkShift = 16;
+	static const size_t ChunkSize = (size_t)1 << ChunkShift;
+	static const size_t MaxChunks;
+
+private:
+	vector<unique_ptr<double[]>> chunks_;
+	size_t size_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_CHUNKEDBUFFER_HPP
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_COMPENSATEDSUM_HPP
+#define DATA_COMPENSATEDSUM_HPP
+
+#include <cmath>
+
+namespace sv {
+namespace data {
+
+/**
+ * Kahan-Babuska-Neumaier compensated summation.
+ *
+ * The rounding error of every addition is accumulated in a separate
+ * compensation term, so the error of the sum doesn't grow with the number of
+ * summands. This is needed for sums over very long acquisitions (e.g. Ah/Wh
+ * over several days).
+ */
+class CompensatedSum
+{
+
+public:
+	explicit CompensatedSum(double value = 0.) :
+		sum_(value),
+		compensation_(0.)
+	{
+	}
+
+	void add(double value)
+	{
+		double t = sum_ + value;
+		if (std::fabs(sum_) >= std::fabs(value))
+			compensation_ += (sum_ - t) + value;
+		else
+			compensation_ += (value - t) + sum_;
+		sum_ = t;
+	}
+
+	void reset(double value = 0.)
+	{
+		sum_ = value;
+		compensation_ = 0.;
+	}
+
+	double value() const
+	{
+		return sum_ + compensation_;
+	}
+
+private:
+	double sum_;
+	double compensation_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_COMPENSATEDSUM_HPP
@@ -0,0 +1,279 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QString>
+
+#include "csvexporter.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/csvformatter.hpp"
+#include "src/data/samplemerger.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+const size_t CsvExporter::BlockSize = 65536;
+const size_t CsvExporter::MinRowsPerThread = 4096;
+const size_t CsvExporter::FlushSize = 1 << 20;
+
+CsvExporter::CsvExporter(const vector<shared_ptr<AnalogTimeSignal>> &signals,
+		const string &file_name, const string &separator, bool relative_time,
+		bool combined, double combined_timeframe) :
+	BaseExporter(signals, file_name),
+	separator_(separator),
+	relative_time_(relative_time),
+	combined_(combined),
+	combined_timeframe_(combined_timeframe),
+	file_(nullptr),
+	write_error_(false)
+{
+}
+
+CsvExporter::~CsvExporter()
+{
+	wait();
+}
+
+QString CsvExporter::export_proc()
+{
+	file_ = fopen(file_name_.c_str(), "wb");
+	if (!file_) {
+		return tr("Could not open %1: %2").
+			arg(QString::fromStdString(file_name_),
+			QString::fromLocal8Bit(strerror(errno)));
+	}
+
+	size_t thread_count = std::thread::hardware_concurrency();
+	formatters_.resize(thread_count > 0 ? thread_count : 1);
+
+	write_header();
+	if (combined_)
+		write_combined();
+	else
+		write_separate();
+
+	if (fclose(file_) != 0)
+		write_error_ = true;
+	file_ = nullptr;
+
+	if (write_error_) {
+		return tr("Could not write %1: %2").
+			arg(QString::fromStdString(file_name_),
+			QString::fromLocal8Bit(strerror(errno)));
+	}
+	return QString();
+}
+
+void CsvExporter::write_header()
+{
+	string start_sep;
+	string device_header_line;
+	string chg_name_header_line;
+	string ch_name_header_line;
+	string signal_name_header_line;
+	if (combined_) {
+		device_header_line = "Time";
+		chg_name_header_line = "Time";
+		ch_name_header_line = "Time";
+		signal_name_header_line = "Time";
+		start_sep = separator_;
+	}
+
+	for (const auto &signal : signals_) {
+		shared_ptr<sv::channels::BaseChannel> parent_channel =
+			signal->parent_channel();
+
+		string chg_names;
+		string chg_sep;
+		for (const auto &chg_name : parent_channel->channel_group_names()) {
+			chg_names += chg_sep;
+			if (chg_name.empty())
+				chg_names += "\"\"";
+			else
+				chg_names += chg_name;
+			// TODO: Ugly workaround. Implement escaping or quotation characters?
+			chg_sep = separator_ == "," ? "; " : ", ";
+		}
+
+		device_header_line += start_sep;
+		chg_name_header_line += start_sep;
+		ch_name_header_line += start_sep;
+		signal_name_header_line += start_sep;
+		if (!combined_) {
+			device_header_line += parent_channel->parent_device()->name(); // Time
+			device_header_line += separator_;
+			chg_name_header_line += chg_names; // Time
+			chg_name_header_line += separator_;
+			ch_name_header_line += parent_channel->name(); // Time
+			ch_name_header_line += separator_;
+			signal_name_header_line += "Time ";
+			signal_name_header_line += signal->name(); // Time
+			signal_name_header_line += separator_;
+		}
+		device_header_line += parent_channel->parent_device()->name(); // Value
+		chg_name_header_line += chg_names; // Value
+		ch_name_header_line += parent_channel->name(); // Value
+		signal_name_header_line += signal->name(); // Value
+
+		start_sep = separator_;
+	}
+
+	CsvFormatter &formatter = formatters_[0];
+	formatter.clear();
+	formatter.append(device_header_line);
+	formatter.end_line();
+	formatter.append(chg_name_header_line);
+	formatter.end_line();
+	formatter.append(ch_name_header_line);
+	formatter.end_line();
+	formatter.append(signal_name_header_line);
+	formatter.end_line();
+	write(formatter);
+}
+
+void CsvExporter::write_separate()
+{
+	size_t row_count = 0;
+	for (const auto &sample_count : sample_counts_)
+		row_count = std::max(row_count, sample_count);
+
+	timestamps_.resize(signals_.size());
+	values_.resize(signals_.size());
+
+	vector<std::thread> format_threads;
+	for (size_t block_start=0; block_start<row_count; block_start+=BlockSize) {
+		if (abort_ || write_error_)
+			return;
+
+		const size_t block_end = std::min(block_start + BlockSize, row_count);
+		for (size_t i=0; i<signals_.size(); ++i) {
+			signals_[i]->get_samples(block_start,
+				std::min(block_end, sample_counts_[i]),
+				timestamps_[i], values_[i], relative_time_);
+		}
+
+		// Format contiguous ranges of rows in parallel
+		const size_t rows = block_end - block_start;
+		const size_t thread_count = std::min(formatters_.size(),
+			(rows + MinRowsPerThread - 1) / MinRowsPerThread);
+		const size_t rows_per_thread = (rows + thread_count - 1) / thread_count;
+		for (size_t t=1; t<thread_count; ++t) {
+			const size_t first = std::min(t * rows_per_thread, rows);
+			const size_t last = std::min(first + rows_per_thread, rows);
+			format_threads.emplace_back(&CsvExporter::format_rows, this,
+				first, last, std::ref(formatters_[t]));
+		}
+		format_rows(0, std::min(rows_per_thread, rows), formatters_[0]);
+		for (auto &format_thread : format_threads)
+			format_thread.join();
+		format_threads.clear();
+
+		for (size_t t=0; t<thread_count; ++t)
+			write(formatters_[t]);
+
+		set_progress(block_end, row_count);
+	}
+}
+
+void CsvExporter::format_rows(size_t first_row, size_t last_row,
+	CsvFormatter &formatter) const
+{
+	formatter.clear();
+	for (size_t row=first_row; row<last_row; ++row) {
+		for (size_t i=0; i<signals_.size(); ++i) {
+			if (i > 0)
+				formatter.append(separator_);
+			if (row < timestamps_[i].size()) {
+				if (relative_time_)
+					formatter.append_fixed(timestamps_[i][row], 4);
+				else
+					formatter.append_date_time(timestamps_[i][row]);
+				formatter.append(separator_);
+				formatter.append_double(values_[i][row]);
+			}
+			else {
+				formatter.append(separator_);
+			}
+		}
+		formatter.end_line();
+	}
+}
+
+void CsvExporter::write_combined()
+{
+	SampleMerger merger(sample_counts_,
+		[this](size_t source, size_t pos, size_t end,
+				vector<double> &timestamps, vector<double> &values) {
+			signals_[source]->get_samples(pos, end, timestamps, values,
+				relative_time_);
+		},
+		combined_timeframe_);
+
+	CsvFormatter &formatter = formatters_[0];
+	formatter.clear();
+	while (!abort_ && !write_error_ && merger.next()) {
+		// Timestamp
+		if (relative_time_)
+			formatter.append_fixed(merger.timestamp(), 4);
+		else
+			formatter.append_date_time(merger.timestamp());
+
+		// Values
+		for (size_t i=0; i<merger.source_count(); ++i) {
+			formatter.append(separator_);
+			if (merger.has_value(i))
+				formatter.append_double(merger.value(i));
+		}
+		formatter.end_line();
+
+		if (formatter.size() >= FlushSize) {
+			write(formatter);
+			formatter.clear();
+			set_progress(merger.merged_count(), merger.total_count());
+		}
+	}
+	write(formatter);
+}
+
+void CsvExporter::write(const CsvFormatter &formatter)
+{
+	if (write_error_ || formatter.size() == 0)
+		return;
+	if (fwrite(formatter.data(), 1, formatter.size(), file_) != formatter.size())
+		write_error_ = true;
+}
+
+} // namespace data
+} // namespace sv
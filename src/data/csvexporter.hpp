@@ -0,0 +1,98 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_CSVEXPORTER_HPP
+#define DATA_CSVEXPORTER_HPP
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+
+#include "src/data/baseexporter.hpp"
+#include "src/data/csvformatter.hpp"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+class AnalogTimeSignal;
+
+/**
+ * Exports AnalogTimeSignals to a CSV file in a worker thread.
+ *
+ * Each signal is either written as a time and a value column, or all signals
+ * share one time column with combined timestamps. The signals are read in
+ * blocks and the rows of a block are formatted in parallel by multiple
+ * threads, the formatted blocks are written with a single fwrite() each.
+ */
+class CsvExporter : public BaseExporter
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @param combined_timeframe The max. time span in seconds, for that
+	 *                           samples are combined into one row. Only used
+	 *                           when `combined` is true.
+	 */
+	CsvExporter(const vector<shared_ptr<AnalogTimeSignal>> &signals,
+		const string &file_name, const string &separator, bool relative_time,
+		bool combined, double combined_timeframe);
+	~CsvExporter();
+
+protected:
+	QString export_proc() override;
+
+private:
+	void write_header();
+	void write_separate();
+	void write_combined();
+	void format_rows(size_t first_row, size_t last_row,
+		CsvFormatter &formatter) const;
+	void write(const CsvFormatter &formatter);
+
+	const string separator_;
+	const bool relative_time_;
+	const bool combined_;
+	const double combined_timeframe_;
+
+	/** Samples of the current block. */
+	vector<vector<double>> timestamps_;
+	vector<vector<double>> values_;
+	vector<CsvFormatter> formatters_;
+	FILE *file_;
+	bool write_error_;
+
+	static const size_t BlockSize;
+	static const size_t MinRowsPerThread;
+	static const size_t FlushSize;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_CSVEXPORTER_HPP
@@ -0,0 +1,147 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "csvformatter.hpp"
+
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+CsvFormatter::CsvFormatter() :
+	locale_decimal_point_(*localeconv()->decimal_point),
+	date_time_secs_(-1),
+	date_time_length_(0)
+{
+	date_time_[0] = '\0';
+}
+
+void CsvFormatter::append(const string &str)
+{
+	buffer_.insert(buffer_.end(), str.begin(), str.end());
+}
+
+void CsvFormatter::append(const char *str, size_t length)
+{
+	buffer_.insert(buffer_.end(), str, str + length);
+}
+
+void CsvFormatter::append(char c)
+{
+	buffer_.push_back(c);
+}
+
+void CsvFormatter::append_double(double value, int significant_digits)
+{
+	char number[32];
+	int length = snprintf(number, sizeof(number), "%.*g",
+		significant_digits, value);
+	append_number(number, length, sizeof(number));
+}
+
+void CsvFormatter::append_fixed(double value, int decimal_places)
+{
+	// Large enough for the integer digits of DBL_MAX
+	char number[384];
+	int length = snprintf(number, sizeof(number), "%.*f",
+		decimal_places, value);
+	append_number(number, length, sizeof(number));
+}
+
+void CsvFormatter::append_date_time(double timestamp)
+{
+	// Same rounding as util::format_time_date()
+	long long msecs = static_cast<long long>(timestamp * 1000);
+	long long secs = msecs / 1000;
+	int msec = static_cast<int>(msecs % 1000);
+	if (msec < 0) {
+		msec += 1000;
+		--secs;
+	}
+
+	if (secs != date_time_secs_) {
+		date_time_secs_ = static_cast<time_t>(secs);
+		struct tm local_time;
+#ifdef _WIN32
+		localtime_s(&local_time, &date_time_secs_);
+#else
+		localtime_r(&date_time_secs_, &local_time);
+#endif
+		date_time_length_ = strftime(date_time_, sizeof(date_time_),
+			"%Y.%m.%d %H:%M:%S", &local_time);
+	}
+
+	append(date_time_, date_time_length_);
+	char msec_str[8];
+	int length = snprintf(msec_str, sizeof(msec_str), ".%03d", msec);
+	append(msec_str, length);
+}
+
+void CsvFormatter::end_line()
+{
+	buffer_.push_back('\n');
+}
+
+const char *CsvFormatter::data() const
+{
+	return buffer_.data();
+}
+
+size_t CsvFormatter::size() const
+{
+	return buffer_.size();
+}
+
+void CsvFormatter::clear()
+{
+	buffer_.clear();
+}
+
+void CsvFormatter::append_number(const char *number, int length,
+	size_t size)
+{
+	if (length <= 0)
+		return;
+	// The number was truncated by snprintf()
+	if ((size_t)length >= size)
+		length = (int)size - 1;
+
+	size_t start = buffer_.size();
+	buffer_.insert(buffer_.end(), number, number + length);
+	// snprintf() uses the decimal point of the C locale
+	if (locale_decimal_point_ != '.') {
+		for (size_t i=start; i<buffer_.size(); ++i) {
+			if (buffer_[i] == locale_decimal_point_) {
+				buffer_[i] = '.';
+				break;
+			}
+		}
+	}
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_CSVFORMATTER_HPP
+#define DATA_CSVFORMATTER_HPP
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Formats CSV lines into a reusable buffer.
+ *
+ * The numbers are formatted with snprintf() into a small stack buffer and
+ * always use '.' as the decimal point, regardless of the C locale. The
+ * buffer keeps its capacity when it is cleared, so formatting large exports
+ * doesn't allocate after the first lines.
+ *
+ * A formatter is not thread safe, but different formatters can be used in
+ * different threads.
+ */
+class CsvFormatter
+{
+
+public:
+	CsvFormatter();
+
+	void append(const string &str);
+	void append(const char *str, size_t length);
+	void append(char c);
+	/**
+	 * Append the value in the 'g' format. The default of 6 significant
+	 * digits is the same as `QString::arg(double)`, 17 digits are needed
+	 * to restore the exact value.
+	 */
+	void append_double(double value, int significant_digits = 6);
+	void append_fixed(double value, int decimal_places);
+	/**
+	 * Append the timestamp (in seconds since epoch) as local time in the
+	 * format "yyyy.MM.dd hh:mm:ss.zzz", like `util::format_time_date()`.
+	 * The date and time part is cached, so consecutive timestamps in the
+	 * same second are cheap.
+	 */
+	void append_date_time(double timestamp);
+	void end_line();
+
+	const char *data() const;
+	size_t size() const;
+	/** Clear the buffer, but keep its capacity. */
+	void clear();
+
+private:
+	void append_number(const char *number, int length, size_t size);
+
+	vector<char> buffer_;
+	char locale_decimal_point_;
+	time_t date_time_secs_;
+	char date_time_[32];
+	size_t date_time_length_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_CSVFORMATTER_HPP
@@ -0,0 +1,183 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "densitybuffer.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+const uint32_t DensityBuffer::DecayOne = 256;
+
+DensityBuffer::DensityBuffer() :
+	width_(0),
+	height_(0)
+{
+}
+
+void DensityBuffer::resize(size_t width, size_t height)
+{
+	width_ = width;
+	height_ = height;
+	counts_.assign(width_ * height_, 0);
+}
+
+void DensityBuffer::clear()
+{
+	std::fill(counts_.begin(), counts_.end(), 0);
+}
+
+size_t DensityBuffer::width() const
+{
+	return width_;
+}
+
+size_t DensityBuffer::height() const
+{
+	return height_;
+}
+
+void DensityBuffer::add_point(int x, int y)
+{
+	if (x < 0 || y < 0 || (size_t)x >= width_ || (size_t)y >= height_)
+		return;
+	hit((size_t)x, (size_t)y);
+}
+
+void DensityBuffer::add_line(double x0, double y0, double x1, double y1)
+{
+	const double start_x = x0;
+	const double start_y = y0;
+	if (!clip_line(x0, y0, x1, y1))
+		return;
+	const bool skip_start = x0 == start_x && y0 == start_y;
+
+	// Bresenham
+	long x = std::lround(x0);
+	long y = std::lround(y0);
+	const long end_x = std::lround(x1);
+	const long end_y = std::lround(y1);
+	const long d_x = std::labs(end_x - x);
+	const long d_y = -std::labs(end_y - y);
+	const long s_x = x < end_x ? 1 : -1;
+	const long s_y = y < end_y ? 1 : -1;
+	long err = d_x + d_y;
+	bool first = true;
+	while (true) {
+		if (!first || !skip_start)
+			hit((size_t)x, (size_t)y);
+		first = false;
+		if (x == end_x && y == end_y)
+			break;
+		const long e2 = 2 * err;
+		if (e2 >= d_y) {
+			err += d_y;
+			x += s_x;
+		}
+		if (e2 <= d_x) {
+			err += d_x;
+			y += s_y;
+		}
+	}
+}
+
+void DensityBuffer::decay(uint32_t factor)
+{
+	if (factor >= DecayOne)
+		return;
+	for (auto &count : counts_)
+		count = (uint32_t)(((uint64_t)count * factor) / DecayOne);
+}
+
+uint32_t DensityBuffer::max_count() const
+{
+	if (counts_.empty())
+		return 0;
+	return *std::max_element(counts_.begin(), counts_.end());
+}
+
+uint32_t DensityBuffer::count(size_t x, size_t y) const
+{
+	return counts_[y * width_ + x];
+}
+
+const uint32_t *DensityBuffer::data() const
+{
+	return counts_.data();
+}
+
+bool DensityBuffer::clip_line(double &x0, double &y0,
+	double &x1, double &y1) const
+{
+	if (width_ == 0 || height_ == 0)
+		return false;
+	if (!std::isfinite(x0) || !std::isfinite(y0) ||
+			!std::isfinite(x1) || !std::isfinite(y1))
+		return false;
+
+	const double d_x = x1 - x0;
+	const double d_y = y1 - y0;
+	const double p[4] = { -d_x, d_x, -d_y, d_y };
+	const double q[4] = {
+		x0, (double)(width_ - 1) - x0, y0, (double)(height_ - 1) - y0 };
+	double t0 = 0.;
+	double t1 = 1.;
+	for (size_t i=0; i<4; ++i) {
+		if (p[i] == 0.) {
+			if (q[i] < 0.)
+				return false;
+			continue;
+		}
+		const double r = q[i] / p[i];
+		if (p[i] < 0.) {
+			if (r > t1)
+				return false;
+			t0 = std::max(t0, r);
+		}
+		else {
+			if (r < t0)
+				return false;
+			t1 = std::min(t1, r);
+		}
+	}
+
+	x1 = x0 + t1 * d_x;
+	y1 = y0 + t1 * d_y;
+	x0 = x0 + t0 * d_x;
+	y0 = y0 + t0 * d_y;
+	return true;
+}
+
+void DensityBuffer::hit(size_t x, size_t y)
+{
+	uint32_t &count = counts_[y * width_ + x];
+	if (count < std::numeric_limits<uint32_t>::max())
+		++count;
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_DENSITYBUFFER_HPP
+#define DATA_DENSITYBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * 2D hit count buffer for persistence (density) displays.
+ *
+ * Lines are rasterized into the buffer by incrementing the count of every
+ * pixel they cross. Old hits fade by scaling all counts with decay(), so the
+ * cost of accumulating many sweeps doesn't depend on the number of sweeps.
+ * All operations work on integer counts, the counts saturate.
+ */
+class DensityBuffer
+{
+
+public:
+	DensityBuffer();
+
+	/** Resize the buffer, all counts are cleared. */
+	void resize(size_t width, size_t height);
+	void clear();
+
+	size_t width() const;
+	size_t height() const;
+
+	/** Add a hit to a pixel. Pixels outside of the buffer are ignored. */
+	void add_point(int x, int y);
+
+	/**
+	 * Add a hit to every pixel of the line from (x0, y0) to (x1, y1). The
+	 * start pixel is excluded (unless it is outside of the buffer), so the
+	 * consecutive lines of a polyline hit every pixel once. The line is
+	 * clipped to the buffer.
+	 */
+	void add_line(double x0, double y0, double x1, double y1);
+
+	/**
+	 * Scale all counts by `factor / DecayOne`.
+	 */
+	void decay(uint32_t factor);
+
+	uint32_t max_count() const;
+	uint32_t count(size_t x, size_t y) const;
+	const uint32_t *data() const;
+
+	/** decay() factor, that keeps the counts unchanged. */
+	static const uint32_t DecayOne;
+
+private:
+	/** Clip the line to the buffer (Liang-Barsky), false if it is outside. */
+	bool clip_line(double &x0, double &y0, double &x1, double &y1) const;
+	void hit(size_t x, size_t y);
+
+	size_t width_;
+	size_t height_;
+	vector<uint32_t> counts_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_DENSITYBUFFER_HPP
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_ENERGYACCUMULATOR_HPP
+#define DATA_ENERGYACCUMULATOR_HPP
+
+#include <cmath>
+
+#include "src/data/compensatedsum.hpp"
+#include "src/data/samplestatistics.hpp"
+
+namespace sv {
+namespace data {
+
+/**
+ * Charge and energy of time aligned voltage/current samples.
+ *
+ * The current and the power are integrated with the trapezoidal rule over
+ * the sample timestamps, so the result doesn't depend on how often the
+ * values are read by the GUI. The integrals are compensated sums, to stay
+ * accurate over long acquisitions. Additionally the min/max of voltage,
+ * current, resistance and power are tracked for every sample.
+ *
+ * A non-finite sample (e.g. an overflow) interrupts the integration until
+ * the next valid sample.
+ */
+class EnergyAccumulator
+{
+
+public:
+	EnergyAccumulator() :
+		has_last_sample_(false),
+		last_timestamp_(0.),
+		last_current_(0.),
+		last_power_(0.)
+	{
+	}
+
+	void add(double timestamp, double voltage, double current)
+	{
+		const double power = voltage * current;
+		voltage_.add(voltage);
+		current_.add(current);
+		power_.add(power);
+		resistance_.add(voltage / current);
+
+		if (!std::isfinite(voltage) || !std::isfinite(current)) {
+			has_last_sample_ = false;
+			return;
+		}
+
+		if (has_last_sample_) {
+			const double dt = timestamp - last_timestamp_;
+			if (dt > 0) {
+				amp_seconds_.add((current + last_current_) * .5 * dt);
+				watt_seconds_.add((power + last_power_) * .5 * dt);
+			}
+		}
+		has_last_sample_ = true;
+		last_timestamp_ = timestamp;
+		last_current_ = current;
+		last_power_ = power;
+	}
+
+	void reset()
+	{
+		*this = EnergyAccumulator();
+	}
+
+	double amp_hours() const
+	{
+		return amp_seconds_.value() / 3600.;
+	}
+
+	double watt_hours() const
+	{
+		return watt_seconds_.value() / 3600.;
+	}
+
+	const SampleStatistics &voltage() const
+	{
+		return voltage_;
+	}
+
+	const SampleStatistics &current() const
+	{
+		return current_;
+	}
+
+	const SampleStatistics &resistance() const
+	{
+		return resistance_;
+	}
+
+	const SampleStatistics &power() const
+	{
+		return power_;
+	}
+
+private:
+	bool has_last_sample_;
+	double last_timestamp_;
+	double last_current_;
+	double last_power_;
+	CompensatedSum amp_seconds_;
+	CompensatedSum watt_seconds_;
+	SampleStatistics voltage_;
+	SampleStatistics current_;
+	SampleStatistics resistance_;
+	SampleStatistics power_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_ENERGYACCUMULATOR_HPP
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+#include <QObject>
+
+#include "energymeter.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/energyaccumulator.hpp"
+#include "src/data/timealigner.hpp"
+
+using std::lock_guard;
+using std::mutex;
+using std::shared_ptr;
+using std::weak_ptr;
+
+namespace sv {
+namespace data {
+
+EnergyMeter::EnergyMeter(shared_ptr<AnalogTimeSignal> voltage_signal,
+		shared_ptr<AnalogTimeSignal> current_signal) :
+	voltage_signal_(voltage_signal),
+	current_signal_(current_signal)
+{
+	assert(voltage_signal_);
+	assert(current_signal_);
+
+	voltage_signal_pos_ = voltage_signal_->sample_count();
+	current_signal_pos_ = current_signal_->sample_count();
+}
+
+EnergyMeter::~EnergyMeter()
+{
+	for (const auto &connection : connections_)
+		QObject::disconnect(connection);
+}
+
+void EnergyMeter::start()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		voltage_signal_pos_ = voltage_signal_->sample_count();
+		current_signal_pos_ = current_signal_->sample_count();
+	}
+
+	// The signals are emitted in the acquisition thread, the samples are
+	// accounted directly there. The slots keep the meter alive while they
+	// are running.
+	weak_ptr<EnergyMeter> weak_meter = shared_from_this();
+	auto appended = [weak_meter]() {
+		if (auto meter = weak_meter.lock())
+			meter->on_sample_appended();
+	};
+	auto cleared = [weak_meter]() {
+		if (auto meter = weak_meter.lock())
+			meter->on_samples_cleared();
+	};
+	connections_.push_back(QObject::connect(voltage_signal_.get(),
+		&AnalogTimeSignal::sample_appended,
+		voltage_signal_.get(), appended, Qt::DirectConnection));
+	connections_.push_back(QObject::connect(current_signal_.get(),
+		&AnalogTimeSignal::sample_appended,
+		current_signal_.get(), appended, Qt::DirectConnection));
+	connections_.push_back(QObject::connect(voltage_signal_.get(),
+		&AnalogTimeSignal::samples_cleared,
+		voltage_signal_.get(), cleared, Qt::DirectConnection));
+	connections_.push_back(QObject::connect(current_signal_.get(),
+		&AnalogTimeSignal::samples_cleared,
+		current_signal_.get(), cleared, Qt::DirectConnection));
+}
+
+EnergyAccumulator EnergyMeter::snapshot() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return accumulator_;
+}
+
+void EnergyMeter::reset()
+{
+	lock_guard<mutex> lock(mutex_);
+	accumulator_.reset();
+}
+
+void EnergyMeter::on_sample_appended()
+{
+	lock_guard<mutex> lock(mutex_);
+
+	// get_samples() limits the end position to the current sample count.
+	voltage_signal_pos_ += voltage_signal_->get_samples(voltage_signal_pos_,
+		std::numeric_limits<size_t>::max(),
+		read_timestamps_, read_values_, false);
+	aligner_.add_first(read_timestamps_, read_values_);
+	current_signal_pos_ += current_signal_->get_samples(current_signal_pos_,
+		std::numeric_limits<size_t>::max(),
+		read_timestamps_, read_values_, false);
+	aligner_.add_second(read_timestamps_, read_values_);
+
+	timestamps_.clear();
+	voltages_.clear();
+	currents_.clear();
+	aligner_.combine(timestamps_, voltages_, currents_);
+	for (size_t i=0; i<timestamps_.size(); ++i)
+		accumulator_.add(timestamps_[i], voltages_[i], currents_[i]);
+}
+
+void EnergyMeter::on_samples_cleared()
+{
+	lock_guard<mutex> lock(mutex_);
+	voltage_signal_pos_ = voltage_signal_->sample_count();
+	current_signal_pos_ = current_signal_->sample_count();
+	aligner_.clear();
+	accumulator_.reset();
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_ENERGYMETER_HPP
+#define DATA_ENERGYMETER_HPP
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QMetaObject>
+
+#include "src/data/energyaccumulator.hpp"
+#include "src/data/timealigner.hpp"
+
+using std::mutex;
+using std::enable_shared_from_this;
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+class AnalogTimeSignal;
+
+/**
+ * Sample accurate charge/energy and min/max accounting of a voltage and a
+ * current signal.
+ *
+ * The new samples of both signals are time aligned and fed into an
+ * EnergyAccumulator in the acquisition thread, when they are appended. So
+ * the result doesn't depend on the update rate of the GUI. Only the samples
+ * that are appended after start() was called are accounted.
+ *
+ * The meter must be owned by a shared_ptr. The connected slots only hold a
+ * weak_ptr to the meter and lock it while they are running, so the meter can
+ * be released in the GUI thread while a slot is running in the acquisition
+ * thread. In that case the meter is destroyed in the acquisition thread, when
+ * the slot has returned.
+ *
+ * snapshot() and reset() are thread safe.
+ */
+class EnergyMeter : public enable_shared_from_this<EnergyMeter>
+{
+
+public:
+	EnergyMeter(shared_ptr<AnalogTimeSignal> voltage_signal,
+		shared_ptr<AnalogTimeSignal> current_signal);
+	~EnergyMeter();
+
+	/** Connect to the signals and start the accounting. */
+	void start();
+
+	/** Return a copy of the current state of the accumulator. */
+	EnergyAccumulator snapshot() const;
+	/** Reset the accumulator, only the following samples are accounted. */
+	void reset();
+
+private:
+	void on_sample_appended();
+	void on_samples_cleared();
+
+	shared_ptr<AnalogTimeSignal> voltage_signal_;
+	shared_ptr<AnalogTimeSignal> current_signal_;
+	vector<QMetaObject::Connection> connections_;
+
+	/** Guards all following members. */
+	mutable mutex mutex_;
+	size_t voltage_signal_pos_;
+	size_t current_signal_pos_;
+	vector<double> read_timestamps_;
+	vector<double> read_values_;
+	TimeAligner aligner_;
+	vector<double> timestamps_;
+	vector<double> voltages_;
+	vector<double> currents_;
+	EnergyAccumulator accumulator_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_ENERGYMETER_HPP
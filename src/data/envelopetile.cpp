@@ -0,0 +1,211 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "envelopetile.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+const size_t EnvelopeTile::BucketCount = 256;
+// The global bucket index of absolute timestamps must fit into 64 bit.
+const int EnvelopeTile::MinLevel = -30;
+const int EnvelopeTile::MaxLevel = 30;
+const size_t EnvelopeTile::EmptyPos = std::numeric_limits<size_t>::max();
+
+namespace {
+
+bool less(double a, double b)
+{
+	return a < b || (std::isnan(b) && !std::isnan(a));
+}
+
+bool greater(double a, double b)
+{
+	return a > b || (std::isnan(b) && !std::isnan(a));
+}
+
+void append_position(vector<size_t> &positions, size_t pos)
+{
+	if (positions.empty() || pos > positions.back())
+		positions.push_back(pos);
+}
+
+} // namespace
+
+EnvelopeTile::EnvelopeTile(int level, int64_t index) :
+	level_(level),
+	index_(index),
+	buckets_(BucketCount,
+		{ EmptyPos, EmptyPos, EmptyPos, EmptyPos, 0., 0. })
+{
+}
+
+int EnvelopeTile::level_for_width(double width)
+{
+	if (!(width > 0.))
+		return MinLevel;
+	int level = (int)std::floor(std::log2(width));
+	// Correct rounding errors of log2()
+	if (bucket_width(level) > width)
+		--level;
+	else if (bucket_width(level + 1) <= width)
+		++level;
+	return std::min(std::max(level, MinLevel), MaxLevel);
+}
+
+double EnvelopeTile::bucket_width(int level)
+{
+	return std::ldexp(1., level);
+}
+
+double EnvelopeTile::tile_width(int level)
+{
+	return bucket_width(level) * (double)BucketCount;
+}
+
+int64_t EnvelopeTile::index_for_time(int level, double timestamp)
+{
+	// Dividing by a power of two is exact, so the tile boundaries are
+	// consistent with the bucket boundaries.
+	return (int64_t)std::floor(timestamp / tile_width(level));
+}
+
+EnvelopeTile EnvelopeTile::merge(const EnvelopeTile &first,
+	const EnvelopeTile &second)
+{
+	assert(first.level_ == second.level_);
+	assert(first.index_ % 2 == 0);
+	assert(second.index_ == first.index_ + 1);
+
+	EnvelopeTile tile(first.level_ + 1, first.index_ / 2);
+	const size_t half = BucketCount / 2;
+	for (size_t i=0; i<BucketCount; ++i) {
+		const EnvelopeTile &child = i < half ? first : second;
+		const size_t child_bucket = 2 * (i % half);
+		Bucket &bucket = tile.buckets_[i];
+		bucket = child.buckets_[child_bucket];
+		merge_bucket(bucket, child.buckets_[child_bucket + 1]);
+	}
+	return tile;
+}
+
+int EnvelopeTile::level() const
+{
+	return level_;
+}
+
+int64_t EnvelopeTile::index() const
+{
+	return index_;
+}
+
+double EnvelopeTile::start() const
+{
+	return (double)index_ * tile_width(level_);
+}
+
+double EnvelopeTile::end() const
+{
+	return (double)(index_ + 1) * tile_width(level_);
+}
+
+void EnvelopeTile::add_samples(size_t pos, const double *timestamps,
+	const double *values, size_t count)
+{
+	const int64_t first_bucket = index_ * (int64_t)BucketCount;
+	for (size_t i=0; i<count; ++i) {
+		const int64_t b = global_bucket(timestamps[i]) - first_bucket;
+		if (b < 0 || b >= (int64_t)BucketCount)
+			continue;
+
+		const size_t sample_pos = pos + i;
+		const double value = values[i];
+		merge_bucket(buckets_[b],
+			{ sample_pos, sample_pos, sample_pos, sample_pos, value, value });
+	}
+}
+
+bool EnvelopeTile::is_empty(size_t bucket) const
+{
+	return buckets_[bucket].first_pos == EmptyPos;
+}
+
+const EnvelopeTile::Bucket &EnvelopeTile::bucket(size_t bucket) const
+{
+	return buckets_[bucket];
+}
+
+void EnvelopeTile::append_positions(double start, double end,
+	vector<size_t> &positions) const
+{
+	const int64_t first_bucket = index_ * (int64_t)BucketCount;
+	const int64_t from = std::max(global_bucket(start) - first_bucket,
+		(int64_t)0);
+	const int64_t to = std::min(global_bucket(end) - first_bucket,
+		(int64_t)BucketCount - 1);
+
+	for (int64_t b=from; b<=to; ++b) {
+		const Bucket &bucket = buckets_[b];
+		if (bucket.first_pos == EmptyPos)
+			continue;
+		// Keep the samples in chronological order
+		append_position(positions, bucket.first_pos);
+		append_position(positions, std::min(bucket.min_pos, bucket.max_pos));
+		append_position(positions, std::max(bucket.min_pos, bucket.max_pos));
+		append_position(positions, bucket.last_pos);
+	}
+}
+
+int64_t EnvelopeTile::global_bucket(double timestamp) const
+{
+	return (int64_t)std::floor(timestamp / bucket_width(level_));
+}
+
+void EnvelopeTile::merge_bucket(Bucket &bucket, const Bucket &other)
+{
+	if (other.first_pos == EmptyPos)
+		return;
+	if (bucket.first_pos == EmptyPos) {
+		bucket = other;
+		return;
+	}
+
+	// `other` always follows `bucket`, so the first of two equal values wins.
+	if (less(other.min, bucket.min)) {
+		bucket.min = other.min;
+		bucket.min_pos = other.min_pos;
+	}
+	if (greater(other.max, bucket.max)) {
+		bucket.max = other.max;
+		bucket.max_pos = other.max_pos;
+	}
+	bucket.last_pos = other.last_pos;
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_ENVELOPETILE_HPP
+#define DATA_ENVELOPETILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Pre-reduced min/max envelope of a time range of a sample column.
+ *
+ * The time axis is divided into buckets with a width of 2^`level` seconds,
+ * and `BucketCount` consecutive buckets form the tile with the given
+ * `index`. So a tile is identified by its level and index alone, independent
+ * of the signal and the current zoom. For each bucket the positions of the
+ * first, the minimum, the maximum and the last sample are stored, like the
+ * columns of the decimation of a TimeCurveData.
+ *
+ * A tile of level `l + 1` can be built from the two tiles of level `l`, that
+ * cover the same time range, without touching the samples again.
+ *
+ * NaN values are never reported as minimum or maximum, unless the bucket
+ * only contains NaNs.
+ */
+class EnvelopeTile
+{
+
+public:
+	struct Bucket {
+		size_t first_pos;
+		size_t min_pos;
+		size_t max_pos;
+		size_t last_pos;
+		double min;
+		double max;
+	};
+
+	EnvelopeTile(int level, int64_t index);
+
+	/**
+	 * Return the largest level with a bucket width not greater than
+	 * `width`, clamped to [`MinLevel`, `MaxLevel`].
+	 */
+	static int level_for_width(double width);
+	static double bucket_width(int level);
+	static double tile_width(int level);
+	/**
+	 * Return the index of the tile of the given level, that contains
+	 * `timestamp`.
+	 */
+	static int64_t index_for_time(int level, double timestamp);
+	/**
+	 * Build the tile of the next level from the two tiles with the indices
+	 * `2 * index` and `2 * index + 1`.
+	 */
+	static EnvelopeTile merge(const EnvelopeTile &first,
+		const EnvelopeTile &second);
+
+	int level() const;
+	int64_t index() const;
+	/** Start timestamp of the tile. */
+	double start() const;
+	/** End timestamp of the tile (not included). */
+	double end() const;
+
+	/**
+	 * Add `count` samples with the positions starting at `pos` to the tile.
+	 * The samples must be added in chronological order, samples with
+	 * timestamps outside of the tile are ignored.
+	 */
+	void add_samples(size_t pos, const double *timestamps,
+		const double *values, size_t count);
+
+	bool is_empty(size_t bucket) const;
+	const Bucket &bucket(size_t bucket) const;
+
+	/**
+	 * Append the first/min/max/last positions of the non-empty buckets, that
+	 * overlap the time range [`start`, `end`], to `positions`. Positions not
+	 * greater than the last element of `positions` are skipped, so the
+	 * positions stay in chronological order.
+	 */
+	void append_positions(double start, double end,
+		vector<size_t> &positions) const;
+
+	static const size_t BucketCount;
+	static const int MinLevel;
+	static const int MaxLevel;
+	/** Position of the samples of empty buckets. */
+	static const size_t EmptyPos;
+
+private:
+	/** Return the global index of the bucket, that contains `timestamp`. */
+	int64_t global_bucket(double timestamp) const;
+	static void merge_bucket(Bucket &bucket, const Bucket &other);
+
+	int level_;
+	int64_t index_;
+	vector<Bucket> buckets_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_ENVELOPETILE_HPP
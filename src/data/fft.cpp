@@ -0,0 +1,261 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "fft.hpp"
+
+using std::complex;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+vector<double> create_window(WindowFunction window_function, size_t size)
+{
+	vector<double> window(size, 1.);
+	if (size < 2)
+		return window;
+
+	// Periodic window, the denominator is `size` and not `size - 1`
+	const double pi2_n = 2 * M_PI / (double)size;
+	for (size_t i=0; i<size; ++i) {
+		double x = pi2_n * (double)i;
+		switch (window_function) {
+		case WindowFunction::Hann:
+			window[i] = 0.5 - 0.5 * std::cos(x);
+			break;
+		case WindowFunction::Hamming:
+			window[i] = 0.54 - 0.46 * std::cos(x);
+			break;
+		case WindowFunction::Blackman:
+			window[i] = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2 * x);
+			break;
+		case WindowFunction::FlatTop:
+			window[i] = 0.21557895 - 0.41663158 * std::cos(x) +
+				0.277263158 * std::cos(2 * x) - 0.083578947 * std::cos(3 * x) +
+				0.006947368 * std::cos(4 * x);
+			break;
+		case WindowFunction::Rectangular:
+		default:
+			window[i] = 1.;
+			break;
+		}
+	}
+	return window;
+}
+
+FFT::FFT(size_t size) :
+	size_(size)
+{
+	assert(size_ > 0);
+
+	twiddles_.reserve(size_);
+	for (size_t i=0; i<size_; ++i) {
+		double phase = -2 * M_PI * (double)i / (double)size_;
+		twiddles_.emplace_back(std::cos(phase), std::sin(phase));
+	}
+
+	// Factorize: radix 4 first, then 2, then the odd factors
+	size_t n = size_;
+	size_t p = 4;
+	do {
+		while (n % p) {
+			switch (p) {
+			case 4:
+				p = 2;
+				break;
+			case 2:
+				p = 3;
+				break;
+			default:
+				p += 2;
+				break;
+			}
+			if (p * p > n)
+				p = n;
+		}
+		n /= p;
+		factors_.push_back(p);
+		factors_.push_back(n);
+	} while (n > 1);
+}
+
+size_t FFT::size() const
+{
+	return size_;
+}
+
+void FFT::transform(const complex<double> *in, complex<double> *out) const
+{
+	assert(in != out);
+
+	if (size_ == 1) {
+		out[0] = in[0];
+		return;
+	}
+	work(out, in, 1, factors_.data());
+}
+
+void FFT::transform_real(const double *in, complex<double> *out,
+	vector<complex<double>> &buffer) const
+{
+	buffer.resize(size_);
+	for (size_t i=0; i<size_; ++i)
+		buffer[i] = complex<double>(in[i], 0.);
+	transform(buffer.data(), out);
+}
+
+void FFT::work(complex<double> *out, const complex<double> *in,
+	size_t fstride, const size_t *factors) const
+{
+	const size_t p = *factors++; // The radix
+	const size_t m = *factors++; // Stage length / radix
+	complex<double> *out_begin = out;
+	const complex<double> *out_end = out + p * m;
+
+	if (m == 1) {
+		do {
+			*out = *in;
+			in += fstride;
+		} while (++out != out_end);
+	}
+	else {
+		do {
+			// Recursive call: DFT of size m*p performed by doing
+			// p instances of smaller DFTs of size m, each one takes
+			// a decimated version of the input.
+			work(out, in, fstride * p, factors);
+			in += fstride;
+		} while ((out += m) != out_end);
+	}
+
+	out = out_begin;
+	switch (p) {
+	case 2:
+		butterfly_2(out, fstride, m);
+		break;
+	case 3:
+		butterfly_3(out, fstride, m);
+		break;
+	case 4:
+		butterfly_4(out, fstride, m);
+		break;
+	default:
+		butterfly_generic(out, fstride, m, p);
+		break;
+	}
+}
+
+void FFT::butterfly_2(complex<double> *out, size_t fstride, size_t m) const
+{
+	complex<double> *out2 = out + m;
+	const complex<double> *tw = twiddles_.data();
+	for (size_t k=0; k<m; ++k) {
+		complex<double> t = out2[k] * *tw;
+		tw += fstride;
+		out2[k] = out[k] - t;
+		out[k] += t;
+	}
+}
+
+void FFT::butterfly_3(complex<double> *out, size_t fstride, size_t m) const
+{
+	const size_t m2 = 2 * m;
+	const double epi3_imag = twiddles_[fstride * m].imag();
+	const complex<double> *tw1 = twiddles_.data();
+	const complex<double> *tw2 = twiddles_.data();
+	for (size_t k=0; k<m; ++k) {
+		complex<double> s1 = out[m] * *tw1;
+		complex<double> s2 = out[m2] * *tw2;
+		complex<double> s3 = s1 + s2;
+		complex<double> s0 = s1 - s2;
+		tw1 += fstride;
+		tw2 += fstride * 2;
+
+		out[m] = out[0] - s3 * 0.5;
+		s0 *= epi3_imag;
+		out[0] += s3;
+		out[m2] = complex<double>(
+			out[m].real() + s0.imag(), out[m].imag() - s0.real());
+		out[m] += complex<double>(-s0.imag(), s0.real());
+		++out;
+	}
+}
+
+void FFT::butterfly_4(complex<double> *out, size_t fstride, size_t m) const
+{
+	const size_t m2 = 2 * m;
+	const size_t m3 = 3 * m;
+	const complex<double> *tw1 = twiddles_.data();
+	const complex<double> *tw2 = twiddles_.data();
+	const complex<double> *tw3 = twiddles_.data();
+	for (size_t k=0; k<m; ++k) {
+		complex<double> s0 = out[m] * *tw1;
+		complex<double> s1 = out[m2] * *tw2;
+		complex<double> s2 = out[m3] * *tw3;
+		tw1 += fstride;
+		tw2 += fstride * 2;
+		tw3 += fstride * 3;
+
+		complex<double> s5 = out[0] - s1;
+		out[0] += s1;
+		complex<double> s3 = s0 + s2;
+		complex<double> s4 = s0 - s2;
+		out[m2] = out[0] - s3;
+		out[0] += s3;
+		out[m] = complex<double>(
+			s5.real() + s4.imag(), s5.imag() - s4.real());
+		out[m3] = complex<double>(
+			s5.real() - s4.imag(), s5.imag() + s4.real());
+		++out;
+	}
+}
+
+void FFT::butterfly_generic(complex<double> *out, size_t fstride, size_t m,
+	size_t p) const
+{
+	vector<complex<double>> scratch(p);
+	for (size_t u=0; u<m; ++u) {
+		size_t k = u;
+		for (size_t q1=0; q1<p; ++q1) {
+			scratch[q1] = out[k];
+			k += m;
+		}
+
+		k = u;
+		for (size_t q1=0; q1<p; ++q1) {
+			size_t tw_idx = 0;
+			out[k] = scratch[0];
+			for (size_t q=1; q<p; ++q) {
+				tw_idx += fstride * k;
+				if (tw_idx >= size_)
+					tw_idx -= size_;
+				out[k] += scratch[q] * twiddles_[tw_idx];
+			}
+			k += m;
+		}
+	}
+}
+
+} // namespace data
+} // namespace sv
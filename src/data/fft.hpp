@@ -0,0 +1,101 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_FFT_HPP
+#define DATA_FFT_HPP
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+using std::complex;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+enum class WindowFunction
+{
+	Rectangular,
+	Hann,
+	Hamming,
+	Blackman,
+	FlatTop,
+};
+
+/**
+ * Return the coefficients of the window function `window_function` with the
+ * length `size`. The window is periodic (DFT-even), as used for spectral
+ * analysis.
+ */
+vector<double> create_window(WindowFunction window_function, size_t size);
+
+/**
+ * Mixed-radix FFT (radix 4, 2, 3 and a generic radix for all other prime
+ * factors) with precomputed twiddle factors.
+ *
+ * The plan (factorization and twiddles) is created once in the ctor, so one
+ * FFT object should be reused for all transforms of the same size.
+ */
+class FFT
+{
+
+public:
+	explicit FFT(size_t size);
+
+	/**
+	 * Return the size of the transform.
+	 */
+	size_t size() const;
+
+	/**
+	 * Forward transform of `size()` complex values. `in` and `out` must not
+	 * overlap.
+	 */
+	void transform(const complex<double> *in, complex<double> *out) const;
+
+	/**
+	 * Forward transform of `size()` real values. `out` must hold `size()`
+	 * complex values, the scratch buffer `buffer` is resized as needed and
+	 * can be reused by the caller to avoid allocations.
+	 */
+	void transform_real(const double *in, complex<double> *out,
+		vector<complex<double>> &buffer) const;
+
+private:
+	void work(complex<double> *out, const complex<double> *in,
+		size_t fstride, const size_t *factors) const;
+	void butterfly_2(complex<double> *out, size_t fstride, size_t m) const;
+	void butterfly_3(complex<double> *out, size_t fstride, size_t m) const;
+	void butterfly_4(complex<double> *out, size_t fstride, size_t m) const;
+	void butterfly_generic(complex<double> *out, size_t fstride, size_t m,
+		size_t p) const;
+
+	size_t size_;
+	/** Pairs of radix p and remaining length m, from the outer stage on. */
+	vector<size_t> factors_;
+	/** exp(-2*pi*i*k/size) for k = 0..size-1 */
+	vector<complex<double>> twiddles_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_FFT_HPP
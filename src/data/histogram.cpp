@@ -0,0 +1,288 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "histogram.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+Histogram::Histogram(size_t bin_count) :
+	bin_count_(bin_count + (bin_count % 2)),
+	auto_range_(true),
+	lower_bound_(0.),
+	bin_width_(0.),
+	count_(0)
+{
+	assert(bin_count_ > 0);
+	init_values_.reserve(bin_count_);
+}
+
+Histogram::Histogram(size_t bin_count, double min, double max) :
+	bin_count_(bin_count),
+	auto_range_(false),
+	lower_bound_(min),
+	bin_width_((max - min) / (double)bin_count),
+	count_(0),
+	bins_(bin_count, 0.)
+{
+	assert(bin_count_ > 0);
+	assert(max > min);
+}
+
+void Histogram::add(double value)
+{
+	// Infinity (overflow) and NaN can't be binned
+	if (!std::isfinite(value))
+		return;
+
+	++count_;
+
+	if (auto_range_ && bins_.empty()) {
+		init_values_.push_back(value);
+		if (init_values_.size() >= bin_count_)
+			init_range();
+		return;
+	}
+
+	if (auto_range_)
+		extend_range(value);
+	count_value(value);
+}
+
+void Histogram::clear()
+{
+	count_ = 0;
+	init_values_.clear();
+	if (auto_range_) {
+		bins_.clear();
+		lower_bound_ = 0.;
+		bin_width_ = 0.;
+	}
+	else {
+		std::fill(bins_.begin(), bins_.end(), 0.);
+	}
+}
+
+size_t Histogram::bin_count() const
+{
+	return bin_count_;
+}
+
+double Histogram::lower_bound() const
+{
+	return lower_bound_;
+}
+
+double Histogram::bin_width() const
+{
+	return bin_width_;
+}
+
+uint64_t Histogram::count() const
+{
+	return count_;
+}
+
+const vector<double> &Histogram::bins() const
+{
+	return bins_;
+}
+
+void Histogram::init_range()
+{
+	auto minmax = std::minmax_element(init_values_.begin(), init_values_.end());
+	double min = *minmax.first;
+	double max = *minmax.second;
+	double range = max - min;
+	if (range > 0) {
+		// Add some headroom, so the range must not be doubled right away
+		lower_bound_ = min - 0.05 * range;
+		bin_width_ = 1.1 * range / (double)bin_count_;
+	}
+	else {
+		bin_width_ = std::max(std::fabs(min), 1.) * 1e-9;
+		lower_bound_ = min - bin_width_ * (double)(bin_count_ / 2);
+	}
+
+	bins_.assign(bin_count_, 0.);
+	for (const auto &value : init_values_)
+		count_value(value);
+	init_values_.clear();
+	init_values_.shrink_to_fit();
+}
+
+void Histogram::extend_range(double value)
+{
+	const size_t half = bin_count_ / 2;
+	while (value < lower_bound_ ||
+			value >= lower_bound_ + bin_width_ * (double)bin_count_) {
+
+		// Double the bin width by merging pairs of bins. When extending
+		// downwards, the merged bins are moved to the upper half, so the
+		// bins must be processed in reverse order.
+		bool extend_down = value < lower_bound_;
+		for (size_t j=0; j<half; ++j) {
+			size_t i = extend_down ? half - 1 - j : j;
+			double sum = bins_[2*i] + bins_[2*i + 1];
+			if (extend_down)
+				bins_[half + i] = sum;
+			else
+				bins_[i] = sum;
+		}
+		if (extend_down) {
+			// The merged bins have been moved to the upper half
+			std::fill(bins_.begin(), bins_.begin() + half, 0.);
+			lower_bound_ -= bin_width_ * (double)bin_count_;
+		}
+		else {
+			std::fill(bins_.begin() + half, bins_.end(), 0.);
+		}
+		bin_width_ *= 2;
+	}
+}
+
+void Histogram::count_value(double value)
+{
+	double pos = std::floor((value - lower_bound_) / bin_width_);
+	size_t index;
+	if (pos < 0)
+		index = 0;
+	else if (pos >= (double)bin_count_)
+		index = bin_count_ - 1;
+	else
+		index = (size_t)pos;
+	bins_[index] += 1;
+}
+
+P2QuantileEstimator::P2QuantileEstimator(double quantile) :
+	quantile_(quantile),
+	count_(0)
+{
+	clear();
+}
+
+void P2QuantileEstimator::add(double value)
+{
+	if (std::isnan(value))
+		return;
+
+	if (count_ < 5) {
+		q_[count_] = value;
+		++count_;
+		if (count_ == 5)
+			std::sort(q_, q_ + 5);
+		return;
+	}
+	++count_;
+
+	// Find the cell k of the value and adjust the extreme markers
+	int k;
+	if (value < q_[0]) {
+		q_[0] = value;
+		k = 0;
+	}
+	else if (value >= q_[4]) {
+		q_[4] = value;
+		k = 3;
+	}
+	else {
+		k = 0;
+		while (k < 3 && value >= q_[k + 1])
+			++k;
+	}
+
+	for (int i=k+1; i<5; ++i)
+		n_[i] += 1;
+	for (int i=0; i<5; ++i)
+		np_[i] += dn_[i];
+
+	// Adjust the heights of the middle markers
+	for (int i=1; i<4; ++i) {
+		double d = np_[i] - n_[i];
+		if ((d >= 1 && n_[i + 1] - n_[i] > 1) ||
+				(d <= -1 && n_[i - 1] - n_[i] < -1)) {
+			int ds = (d >= 0) ? 1 : -1;
+			double q = parabolic(i, ds);
+			if (q_[i - 1] < q && q < q_[i + 1])
+				q_[i] = q;
+			else
+				q_[i] = linear(i, ds);
+			n_[i] += ds;
+		}
+	}
+}
+
+void P2QuantileEstimator::clear()
+{
+	count_ = 0;
+	for (int i=0; i<5; ++i) {
+		q_[i] = 0.;
+		n_[i] = i;
+	}
+	np_[0] = 0;
+	np_[1] = 2 * quantile_;
+	np_[2] = 4 * quantile_;
+	np_[3] = 2 + 2 * quantile_;
+	np_[4] = 4;
+	dn_[0] = 0;
+	dn_[1] = quantile_ / 2;
+	dn_[2] = quantile_;
+	dn_[3] = (1 + quantile_) / 2;
+	dn_[4] = 1;
+}
+
+double P2QuantileEstimator::value() const
+{
+	if (count_ == 0)
+		return std::numeric_limits<double>::quiet_NaN();
+
+	if (count_ < 5) {
+		// Not enough values for the markers yet, use the exact quantile
+		double sorted[5];
+		std::copy(q_, q_ + count_, sorted);
+		std::sort(sorted, sorted + count_);
+		size_t index = (size_t)std::lround(quantile_ * (double)(count_ - 1));
+		return sorted[index];
+	}
+
+	return q_[2];
+}
+
+double P2QuantileEstimator::parabolic(int i, double d) const
+{
+	return q_[i] + d / (n_[i + 1] - n_[i - 1]) * (
+		(n_[i] - n_[i - 1] + d) * (q_[i + 1] - q_[i]) / (n_[i + 1] - n_[i]) +
+		(n_[i + 1] - n_[i] - d) * (q_[i] - q_[i - 1]) / (n_[i] - n_[i - 1]));
+}
+
+double P2QuantileEstimator::linear(int i, int d) const
+{
+	return q_[i] + d * (q_[i + d] - q_[i]) / (n_[i + d] - n_[i]);
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,128 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_HISTOGRAM_HPP
+#define DATA_HISTOGRAM_HPP
+
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Histogram with a fixed number of bins.
+ *
+ * With a fixed range, values outside the range are counted in the first or
+ * the last bin. With auto-ranging, the range is initialized from the first
+ * `bin_count` values and the bin width is doubled (by merging pairs of bins)
+ * whenever a value is outside the range. The memory usage only depends on
+ * the number of bins.
+ */
+class Histogram
+{
+
+public:
+	/**
+	 * Create an auto-ranging histogram. `bin_count` is rounded up to an even
+	 * number.
+	 */
+	explicit Histogram(size_t bin_count);
+
+	/**
+	 * Create a histogram with the fixed range [`min`, `max`).
+	 */
+	Histogram(size_t bin_count, double min, double max);
+
+	void add(double value);
+	void clear();
+
+	size_t bin_count() const;
+	/** The lower bound of the first bin. */
+	double lower_bound() const;
+	double bin_width() const;
+	/** The number of values (incl. the buffered values for auto-ranging). */
+	uint64_t count() const;
+	/**
+	 * The counts of all bins. Empty while an auto-ranging histogram is still
+	 * collecting the values for the initial range.
+	 */
+	const vector<double> &bins() const;
+
+private:
+	void init_range();
+	void extend_range(double value);
+	void count_value(double value);
+
+	size_t bin_count_;
+	bool auto_range_;
+	double lower_bound_;
+	double bin_width_;
+	uint64_t count_;
+	vector<double> bins_;
+	/** The first values for the initial range (auto-ranging only). */
+	vector<double> init_values_;
+
+};
+
+/**
+ * Streaming estimation of a quantile with the P² algorithm (R. Jain and
+ * I. Chlamtac, 1985). Only 5 markers are stored, regardless of the number
+ * of values.
+ */
+class P2QuantileEstimator
+{
+
+public:
+	/**
+	 * @param quantile The quantile to estimate, between 0 and 1.
+	 */
+	explicit P2QuantileEstimator(double quantile);
+
+	void add(double value);
+	void clear();
+
+	/**
+	 * Return the estimated quantile, NaN if there are no values.
+	 */
+	double value() const;
+
+private:
+	double parabolic(int i, double d) const;
+	double linear(int i, int d) const;
+
+	double quantile_;
+	uint64_t count_;
+	/** Marker heights */
+	double q_[5];
+	/** Marker positions */
+	double n_[5];
+	/** Desired marker positions */
+	double np_[5];
+	/** Increments of the desired marker positions */
+	double dn_[5];
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_HISTOGRAM_HPP
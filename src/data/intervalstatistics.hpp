@@ -0,0 +1,159 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_INTERVALSTATISTICS_HPP
+#define DATA_INTERVALSTATISTICS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace sv {
+namespace data {
+
+/**
+ * Min, max, mean and standard deviation (jitter) of the intervals between
+ * consecutive timestamps.
+ *
+ * The mean and variance are updated with Welford's algorithm, so they are
+ * stable for very long acquisitions. Non-finite timestamps are ignored.
+ */
+class IntervalStatistics
+{
+
+public:
+	IntervalStatistics() :
+		has_last_timestamp_(false),
+		last_timestamp_(0.),
+		count_(0),
+		min_(std::numeric_limits<double>::max()),
+		max_(std::numeric_limits<double>::lowest()),
+		mean_(0.),
+		m2_(0.)
+	{
+	}
+
+	/**
+	 * Add the next timestamp.
+	 */
+	void add(double timestamp)
+	{
+		if (!std::isfinite(timestamp))
+			return;
+		if (has_last_timestamp_)
+			add_intervals(timestamp - last_timestamp_, 1);
+		has_last_timestamp_ = true;
+		last_timestamp_ = timestamp;
+	}
+
+	/**
+	 * Add `count` timestamps with a constant interval, starting at
+	 * `timestamp`. This is O(1), no matter how many timestamps are added.
+	 */
+	void add_uniform(double timestamp, double interval, size_t count)
+	{
+		if (count == 0)
+			return;
+		add(timestamp);
+		if (count > 1 && std::isfinite(interval)) {
+			add_intervals(interval, count - 1);
+			last_timestamp_ = timestamp + interval * (double)(count - 1);
+		}
+	}
+
+	void reset()
+	{
+		*this = IntervalStatistics();
+	}
+
+	/** The number of intervals. */
+	size_t count() const
+	{
+		return count_;
+	}
+
+	/** Only valid, if count() is not 0. */
+	double min() const
+	{
+		return min_;
+	}
+
+	/** Only valid, if count() is not 0. */
+	double max() const
+	{
+		return max_;
+	}
+
+	/** Only valid, if count() is not 0. */
+	double mean() const
+	{
+		return mean_;
+	}
+
+	/**
+	 * The standard deviation of the intervals. Only valid, if count() is
+	 * not 0.
+	 */
+	double jitter() const
+	{
+		return std::sqrt(m2_ / (double)count_);
+	}
+
+	/**
+	 * The effective sample rate in Hz, 0 if it is unknown.
+	 */
+	double samplerate() const
+	{
+		if (count_ == 0 || mean_ <= 0.)
+			return 0.;
+		return 1. / mean_;
+	}
+
+private:
+	/** Add `count` equal intervals (Chan et al. parallel update). */
+	void add_intervals(double interval, size_t count)
+	{
+		if (interval < min_)
+			min_ = interval;
+		if (interval > max_)
+			max_ = interval;
+
+		const double n_a = (double)count_;
+		const double n_b = (double)count;
+		count_ += count;
+		const double delta = interval - mean_;
+		mean_ += delta * n_b / (double)count_;
+		m2_ += delta * delta * n_a * n_b / (double)count_;
+	}
+
+	bool has_last_timestamp_;
+	double last_timestamp_;
+	size_t count_;
+	double min_;
+	double max_;
+	double mean_;
+	/** Sum of the squared differences from the mean. */
+	double m2_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_INTERVALSTATISTICS_HPP
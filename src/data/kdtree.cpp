@@ -0,0 +1,199 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "kdtree.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+const size_t KdTree::LeafSize = 16;
+const size_t KdTree::MinTailSize = 4096;
+
+namespace {
+
+const size_t npos = std::numeric_limits<size_t>::max();
+
+} // namespace
+
+KdTree::KdTree() :
+	built_size_(0)
+{
+}
+
+void KdTree::append(double x, double y)
+{
+	// New points are added to the tail, the tree is rebuilt with the next
+	// query when the tail is too large.
+	x_.push_back(x);
+	y_.push_back(y);
+}
+
+void KdTree::clear()
+{
+	x_.clear();
+	y_.clear();
+	nodes_.clear();
+	order_.clear();
+	built_size_ = 0;
+}
+
+size_t KdTree::size() const
+{
+	return x_.size();
+}
+
+bool KdTree::find_closest(double pos_x, double pos_y, size_t &pos,
+	double &distance)
+{
+	const size_t tail_size = x_.size() - built_size_;
+	if (tail_size > std::max(MinTailSize, built_size_ / 16))
+		rebuild();
+
+	size_t best_pos = npos;
+	double best_d2 = std::numeric_limits<double>::infinity();
+	for (size_t i=built_size_; i<x_.size(); ++i)
+		check_point(i, pos_x, pos_y, best_pos, best_d2);
+	if (!nodes_.empty())
+		search(0, pos_x, pos_y, best_pos, best_d2);
+
+	if (best_pos == npos)
+		return false;
+
+	pos = best_pos;
+	distance = std::sqrt(best_d2);
+	return true;
+}
+
+void KdTree::rebuild()
+{
+	nodes_.clear();
+	order_.clear();
+	for (size_t i=0; i<x_.size(); ++i) {
+		if (std::isfinite(x_[i]) && std::isfinite(y_[i]))
+			order_.push_back(i);
+	}
+	built_size_ = x_.size();
+
+	if (!order_.empty()) {
+		nodes_.reserve(2 * order_.size() / LeafSize + 1);
+		build_node(0, order_.size());
+	}
+}
+
+size_t KdTree::build_node(size_t begin, size_t end)
+{
+	const double *x = x_.data();
+	const double *y = y_.data();
+	const size_t index = nodes_.size();
+	nodes_.push_back({});
+
+	Node node;
+	node.x_min = x[order_[begin]];
+	node.x_max = node.x_min;
+	node.y_min = y[order_[begin]];
+	node.y_max = node.y_min;
+	for (size_t i=begin+1; i<end; ++i) {
+		node.x_min = std::min(node.x_min, x[order_[i]]);
+		node.x_max = std::max(node.x_max, x[order_[i]]);
+		node.y_min = std::min(node.y_min, y[order_[i]]);
+		node.y_max = std::max(node.y_max, y[order_[i]]);
+	}
+	node.begin = begin;
+	node.end = end;
+	node.left = 0;
+	node.right = 0;
+
+	if (end - begin > LeafSize) {
+		// Split the larger extent of the bounding box at the median
+		const double *coords =
+			(node.x_max - node.x_min >= node.y_max - node.y_min) ? x : y;
+		const size_t mid = begin + (end - begin) / 2;
+		std::nth_element(order_.begin() + begin, order_.begin() + mid,
+			order_.begin() + end, [coords](size_t a, size_t b) {
+				return coords[a] < coords[b];
+			});
+		node.left = build_node(begin, mid);
+		node.right = build_node(mid, end);
+	}
+
+	nodes_[index] = node;
+	return index;
+}
+
+void KdTree::search(size_t node, double pos_x, double pos_y,
+	size_t &best_pos, double &best_d2) const
+{
+	const Node &n = nodes_[node];
+	if (n.left == 0) {
+		for (size_t i=n.begin; i<n.end; ++i)
+			check_point(order_[i], pos_x, pos_y, best_pos, best_d2);
+		return;
+	}
+
+	// Search the nearer child first, so the other one can be skipped more
+	// often. Equal distances must be searched for the smallest position.
+	size_t first = n.left;
+	size_t second = n.right;
+	double first_d2 = box_distance2(nodes_[first], pos_x, pos_y);
+	double second_d2 = box_distance2(nodes_[second], pos_x, pos_y);
+	if (second_d2 < first_d2) {
+		std::swap(first, second);
+		std::swap(first_d2, second_d2);
+	}
+	if (first_d2 <= best_d2)
+		search(first, pos_x, pos_y, best_pos, best_d2);
+	if (second_d2 <= best_d2)
+		search(second, pos_x, pos_y, best_pos, best_d2);
+}
+
+void KdTree::check_point(size_t i, double pos_x, double pos_y,
+	size_t &best_pos, double &best_d2) const
+{
+	const double d2 = (x_[i] - pos_x) * (x_[i] - pos_x) +
+		(y_[i] - pos_y) * (y_[i] - pos_y);
+	if (d2 < best_d2 || (d2 == best_d2 && i < best_pos)) {
+		best_pos = i;
+		best_d2 = d2;
+	}
+}
+
+double KdTree::box_distance2(const Node &node, double pos_x, double pos_y)
+{
+	double d_x = 0.;
+	if (pos_x < node.x_min)
+		d_x = node.x_min - pos_x;
+	else if (pos_x > node.x_max)
+		d_x = pos_x - node.x_max;
+	double d_y = 0.;
+	if (pos_y < node.y_min)
+		d_y = node.y_min - pos_y;
+	else if (pos_y > node.y_max)
+		d_y = pos_y - node.y_max;
+	return d_x * d_x + d_y * d_y;
+}
+
+} // namespace data
+} // namespace sv
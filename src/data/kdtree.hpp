@@ -0,0 +1,108 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_KDTREE_HPP
+#define DATA_KDTREE_HPP
+
+#include <cstddef>
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Bucketed 2D kd-tree over a growing set of points to find the closest
+ * point to a position without scanning all points.
+ *
+ * The tree is built lazily with the next query. Points that were added after
+ * the tree was built are kept in a tail, that is scanned linearly. When the
+ * tail grows too large, the tree is rebuilt. The tree keeps its own copy of
+ * the coordinates, so the points can be stored in any layout by the caller.
+ *
+ * Points with a non finite coordinate are never found.
+ */
+class KdTree
+{
+
+public:
+	KdTree();
+
+	/**
+	 * Add a point at position `size()`.
+	 */
+	void append(double x, double y);
+	void clear();
+
+	/**
+	 * Return the number of indexed points.
+	 */
+	size_t size() const;
+
+	/**
+	 * Find the position of the point with the smallest euclidean distance to
+	 * (`pos_x`, `pos_y`). When several points have the same distance, the
+	 * smallest position is returned. Returns false, when there is no point.
+	 */
+	bool find_closest(double pos_x, double pos_y, size_t &pos,
+		double &distance);
+
+	/** Maximum number of points in a leaf. */
+	static const size_t LeafSize;
+	/** Minimum number of tail points before the tree is rebuilt. */
+	static const size_t MinTailSize;
+
+private:
+	struct Node {
+		/** Bounding box of all points of the node. */
+		double x_min;
+		double x_max;
+		double y_min;
+		double y_max;
+		/** Range in `order_`. */
+		size_t begin;
+		size_t end;
+		/** Child nodes, 0 for leafs. */
+		size_t left;
+		size_t right;
+	};
+
+	void rebuild();
+	size_t build_node(size_t begin, size_t end);
+	void search(size_t node, double pos_x, double pos_y,
+		size_t &best_pos, double &best_d2) const;
+	void check_point(size_t i, double pos_x, double pos_y,
+		size_t &best_pos, double &best_d2) const;
+	static double box_distance2(const Node &node, double pos_x, double pos_y);
+
+	vector<double> x_;
+	vector<double> y_;
+	vector<Node> nodes_;
+	/** Positions of the finite points in the tree, ordered by node. */
+	vector<size_t> order_;
+	/** Number of points when the tree was built. */
+	size_t built_size_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_KDTREE_HPP
@@ -0,0 +1,172 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "minmaxindex.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+const size_t MinMaxIndex::BlockSize = 64;
+const size_t MinMaxIndex::FetchSize = 64 * 1024;
+
+MinMaxIndex::MinMaxIndex(fetch_func_t fetch) :
+	fetch_(fetch),
+	size_(0)
+{
+}
+
+void MinMaxIndex::update(size_t count)
+{
+	if (count < size_)
+		clear();
+	if (count == size_)
+		return;
+
+	if (levels_.empty())
+		levels_.emplace_back();
+
+	const size_t first_block = size_ / BlockSize;
+	vector<Entry> &blocks = levels_[0];
+	while (size_ < count) {
+		fetch_(size_, std::min(size_ + FetchSize, count), values_);
+		if (values_.empty())
+			break;
+
+		for (size_t j=0; j<values_.size(); ++j) {
+			const size_t i = size_ + j;
+			const Entry entry = { i, i, values_[j], values_[j] };
+			const size_t block = i / BlockSize;
+			if (block == blocks.size())
+				blocks.push_back(entry);
+			else
+				merge(blocks[block], entry);
+		}
+		size_ += values_.size();
+	}
+
+	// Update the affected entries of the upper levels
+	size_t first = first_block;
+	for (size_t l=1; levels_[l-1].size() > 1; ++l) {
+		if (levels_.size() == l)
+			levels_.emplace_back();
+		const vector<Entry> &lower = levels_[l-1];
+		vector<Entry> &upper = levels_[l];
+
+		first /= 2;
+		upper.resize((lower.size() + 1) / 2);
+		for (size_t j=first; j<upper.size(); ++j) {
+			Entry entry = lower[2*j];
+			if (2*j + 1 < lower.size())
+				merge(entry, lower[2*j + 1]);
+			upper[j] = entry;
+		}
+	}
+}
+
+void MinMaxIndex::clear()
+{
+	levels_.clear();
+	size_ = 0;
+}
+
+size_t MinMaxIndex::size() const
+{
+	return size_;
+}
+
+void MinMaxIndex::find(size_t pos, size_t end_pos,
+	size_t &min_pos, size_t &max_pos) const
+{
+	assert(pos < end_pos);
+	assert(end_pos <= size_);
+
+	// NaN is replaced by every other value
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	Entry result = { pos, pos, nan, nan };
+
+	// Only whole blocks can be looked up in the index
+	size_t block = (pos + BlockSize - 1) / BlockSize;
+	size_t end_block = end_pos / BlockSize;
+	if (block >= end_block) {
+		merge_range(result, pos, end_pos);
+		min_pos = result.min_pos;
+		max_pos = result.max_pos;
+		return;
+	}
+
+	merge_range(result, pos, block * BlockSize);
+	merge_range(result, end_block * BlockSize, end_pos);
+
+	for (size_t l=0; block<end_block; ++l) {
+		if (block & 1)
+			merge(result, levels_[l][block++]);
+		if (end_block & 1)
+			merge(result, levels_[l][--end_block]);
+		block >>= 1;
+		end_block >>= 1;
+	}
+
+	min_pos = result.min_pos;
+	max_pos = result.max_pos;
+}
+
+bool MinMaxIndex::less(double a, double b)
+{
+	return a < b || (std::isnan(b) && !std::isnan(a));
+}
+
+bool MinMaxIndex::greater(double a, double b)
+{
+	return a > b || (std::isnan(b) && !std::isnan(a));
+}
+
+void MinMaxIndex::merge(Entry &entry, const Entry &other)
+{
+	if (less(other.min, entry.min)) {
+		entry.min_pos = other.min_pos;
+		entry.min = other.min;
+	}
+	if (greater(other.max, entry.max)) {
+		entry.max_pos = other.max_pos;
+		entry.max = other.max;
+	}
+}
+
+void MinMaxIndex::merge_range(Entry &entry, size_t pos, size_t end_pos) const
+{
+	if (pos >= end_pos)
+		return;
+
+	fetch_(pos, end_pos, values_);
+	for (size_t j=0; j<values_.size(); ++j) {
+		const size_t i = pos + j;
+		merge(entry, { i, i, values_[j], values_[j] });
+	}
+}
+
+} // namespace data
+} // namespace sv
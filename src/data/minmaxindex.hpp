@@ -0,0 +1,113 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_MINMAXINDEX_HPP
+#define DATA_MINMAXINDEX_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+using std::function;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Index to find the positions of the minimum and maximum value in an
+ * arbitrary range of a growing sample column in O(log n).
+ *
+ * The column is divided into blocks of `BlockSize` samples. For every block
+ * the positions of the minimum and maximum are stored, and each further level
+ * stores the positions for pairs of the entries of the level below. The
+ * values are copied block wise by the `fetch` function (e.g. from
+ * AnalogTimeSignal::get_samples()), so the column can grow in another thread
+ * while it is indexed. The extreme values are stored next to their positions,
+ * only the values of the partial blocks at both ends of a range are fetched
+ * again by find().
+ *
+ * NaN values are never reported as minimum or maximum, unless the range only
+ * contains NaNs.
+ */
+class MinMaxIndex
+{
+
+public:
+	/**
+	 * Copy the values from `pos` up to (but not including) `end_pos` to
+	 * `values`. Less values may be returned, if the column has shrunk.
+	 */
+	typedef function<void(size_t pos, size_t end_pos, vector<double> &values)>
+		fetch_func_t;
+
+	explicit MinMaxIndex(fetch_func_t fetch);
+
+	/**
+	 * Add the positions from `size()` up to (but not including) `count` to
+	 * the index. When `count` is less than `size()`, the index is rebuilt.
+	 * When less values are fetched, only those are added.
+	 */
+	void update(size_t count);
+	void clear();
+
+	/**
+	 * Return the number of indexed samples.
+	 */
+	size_t size() const;
+
+	/**
+	 * Find the positions of the minimum and the maximum value in the range
+	 * from `pos` up to (but not including) `end_pos`. The range must not be
+	 * empty and `end_pos` must not exceed `size()`.
+	 */
+	void find(size_t pos, size_t end_pos,
+		size_t &min_pos, size_t &max_pos) const;
+
+	static const size_t BlockSize;
+
+private:
+	struct Entry {
+		size_t min_pos;
+		size_t max_pos;
+		double min;
+		double max;
+	};
+
+	/** Compare two values, NaN is ordered after all other values. */
+	static bool less(double a, double b);
+	static bool greater(double a, double b);
+	static void merge(Entry &entry, const Entry &other);
+	/** Fetch the values from `pos` up to `end_pos` and merge them. */
+	void merge_range(Entry &entry, size_t pos, size_t end_pos) const;
+
+	fetch_func_t fetch_;
+	vector<vector<Entry>> levels_;
+	size_t size_;
+	/** Buffer for the fetched values. */
+	mutable vector<double> values_;
+
+	static const size_t FetchSize;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_MINMAXINDEX_HPP
@@ -0,0 +1,276 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include "npyexporter.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/npyfile.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+const int NpyExporter::SidecarVersion = 1;
+const size_t NpyExporter::BlockSize = 1 << 20;
+
+NpyExporter::NpyExporter(const vector<shared_ptr<AnalogTimeSignal>> &signals,
+		const string &file_name, bool npz) :
+	BaseExporter(signals, file_name),
+	npz_(npz),
+	written_count_(0),
+	total_count_(0)
+{
+	QFileInfo file_info(QString::fromStdString(file_name_));
+	base_name_ = file_info.path() + "/" + file_info.completeBaseName();
+}
+
+NpyExporter::~NpyExporter()
+{
+	wait();
+}
+
+QString NpyExporter::export_proc()
+{
+	// Two columns per signal
+	for (const auto &sample_count : sample_counts_)
+		total_count_ += 2 * sample_count;
+
+	QJsonObject sidecar;
+	sidecar["version"] = SidecarVersion;
+	sidecar["format"] = npz_ ? "npz" : "npy";
+
+	QJsonArray signal_array;
+	if (npz_) {
+		QString error = write_npz_file();
+		if (!error.isEmpty())
+			return error;
+		sidecar["file"] = QFileInfo(base_name_ + ".npz").fileName();
+		for (size_t i=0; i<signals_.size(); ++i) {
+			QJsonObject signal_object = signal_metadata(i);
+			signal_object["time"] = QString("signal%1_time").arg(i);
+			signal_object["value"] = QString("signal%1_value").arg(i);
+			signal_array.append(signal_object);
+		}
+	}
+	else {
+		for (size_t i=0; i<signals_.size() && !abort_; ++i) {
+			QJsonObject signal_object = signal_metadata(i);
+			QString error = write_npy_files(signal_object, i);
+			if (!error.isEmpty())
+				return error;
+			signal_array.append(signal_object);
+		}
+	}
+	if (abort_)
+		return QString();
+
+	sidecar["signals"] = signal_array;
+	return write_sidecar(sidecar);
+}
+
+QString NpyExporter::write_npy_files(QJsonObject &signal_object,
+	size_t signal_index)
+{
+	const QString time_file_name =
+		QString("%1_signal%2_time.npy").arg(base_name_).arg(signal_index);
+	const QString value_file_name =
+		QString("%1_signal%2_value.npy").arg(base_name_).arg(signal_index);
+	signal_object["time"] = QFileInfo(time_file_name).fileName();
+	signal_object["value"] = QFileInfo(value_file_name).fileName();
+
+	FILE *time_file = fopen(time_file_name.toLocal8Bit().constData(), "wb");
+	if (!time_file)
+		return file_error(time_file_name);
+	FILE *value_file = fopen(value_file_name.toLocal8Bit().constData(), "wb");
+	if (!value_file) {
+		QString error = file_error(value_file_name);
+		fclose(time_file);
+		return error;
+	}
+
+	// Both columns are written simultaneously, so the samples are read once.
+	const string header = npy::header(sample_counts_[signal_index]);
+	bool time_ok = fwrite(header.data(), 1, header.size(), time_file) ==
+		header.size();
+	bool value_ok = fwrite(header.data(), 1, header.size(), value_file) ==
+		header.size();
+	size_t pos = 0;
+	while (time_ok && value_ok && !abort_) {
+		const size_t count = read_block(signal_index, pos);
+		if (count == 0)
+			break;
+		time_ok = fwrite(timestamps_.data(), sizeof(double), count,
+			time_file) == count;
+		value_ok = fwrite(values_.data(), sizeof(double), count,
+			value_file) == count;
+		pos += count;
+		add_progress(2 * count);
+	}
+
+	// The signal could have been cleared meanwhile
+	if (time_ok && value_ok && !abort_ && pos != sample_counts_[signal_index]) {
+		fclose(time_file);
+		fclose(value_file);
+		return tr("The signal %1 has been cleared during the export").
+			arg(signals_[signal_index]->display_name());
+	}
+
+	time_ok = (fclose(time_file) == 0) && time_ok;
+	if (!time_ok) {
+		QString error = file_error(time_file_name);
+		fclose(value_file);
+		return error;
+	}
+	value_ok = (fclose(value_file) == 0) && value_ok;
+	if (!value_ok)
+		return file_error(value_file_name);
+	return QString();
+}
+
+QString NpyExporter::write_npz_file()
+{
+	const QString file_name = base_name_ + ".npz";
+	FILE *file = fopen(file_name.toLocal8Bit().constData(), "wb");
+	if (!file)
+		return file_error(file_name);
+
+	npy::NpzWriter writer(file);
+	bool ok = true;
+	for (size_t i=0; i<signals_.size() && ok && !abort_; ++i) {
+		// The columns are written one after another, so the signal is read twice.
+		for (const auto &column : { "time", "value" }) {
+			const bool is_time = strcmp(column, "time") == 0;
+			ok = ok && writer.begin_array(
+				QString("signal%1_%2").arg(i).arg(column).toStdString(),
+				sample_counts_[i]);
+			size_t pos = 0;
+			while (ok && !abort_) {
+				const size_t count = read_block(i, pos);
+				if (count == 0)
+					break;
+				ok = writer.write(
+					is_time ? timestamps_.data() : values_.data(), count);
+				pos += count;
+				add_progress(count);
+			}
+			if (ok && !abort_ && pos != sample_counts_[i]) {
+				fclose(file);
+				return tr("The signal %1 has been cleared during the export").
+					arg(signals_[i]->display_name());
+			}
+			ok = ok && writer.end_array();
+		}
+	}
+	ok = ok && (abort_ || writer.finish());
+	ok = (fclose(file) == 0) && ok;
+
+	if (!ok) {
+		return tr("Could not write %1 (the size of a .npz file is limited "
+			"to 4 GiB): %2").arg(file_name,
+			QString::fromLocal8Bit(strerror(errno)));
+	}
+	return QString();
+}
+
+size_t NpyExporter::read_block(size_t signal_index, size_t pos)
+{
+	return signals_[signal_index]->get_samples(pos,
+		std::min(pos + BlockSize, sample_counts_[signal_index]),
+		timestamps_, values_, false);
+}
+
+QJsonObject NpyExporter::signal_metadata(size_t signal_index) const
+{
+	const auto &signal = signals_[signal_index];
+	const auto channel = signal->parent_channel();
+
+	QJsonArray channel_group_array;
+	for (const auto &chg_name : channel->channel_group_names())
+		channel_group_array.append(QString::fromStdString(chg_name));
+	QJsonArray quantity_flag_array;
+	for (const auto &quantity_flag : signal->quantity_flags()) {
+		quantity_flag_array.append(
+			datautil::format_quantity_flag(quantity_flag));
+	}
+
+	QJsonObject signal_object;
+	signal_object["device"] =
+		QString::fromStdString(channel->parent_device()->name());
+	signal_object["channel_groups"] = channel_group_array;
+	signal_object["channel"] = QString::fromStdString(channel->name());
+	signal_object["name"] = QString::fromStdString(signal->name());
+	signal_object["quantity"] = datautil::format_quantity(signal->quantity());
+	signal_object["quantity_flags"] = quantity_flag_array;
+	signal_object["unit"] = datautil::format_unit(signal->unit());
+	signal_object["total_digits"] = signal->total_digits();
+	signal_object["sr_digits"] = signal->sr_digits();
+	signal_object["start_timestamp"] = signal->signal_start_timestamp();
+	signal_object["sample_count"] = (double)sample_counts_[signal_index];
+	return signal_object;
+}
+
+QString NpyExporter::write_sidecar(const QJsonObject &sidecar) const
+{
+	const QString file_name = base_name_ + ".json";
+	const QByteArray json = QJsonDocument(sidecar).toJson();
+
+	FILE *file = fopen(file_name.toLocal8Bit().constData(), "wb");
+	if (!file)
+		return file_error(file_name);
+	bool ok = fwrite(json.constData(), 1, json.size(), file) ==
+		(size_t)json.size();
+	ok = (fclose(file) == 0) && ok;
+	if (!ok)
+		return file_error(file_name);
+	return QString();
+}
+
+QString NpyExporter::file_error(const QString &file_name) const
+{
+	return tr("Could not write %1: %2").arg(file_name,
+		QString::fromLocal8Bit(strerror(errno)));
+}
+
+void NpyExporter::add_progress(size_t count)
+{
+	written_count_ += count;
+	set_progress(written_count_, total_count_);
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_NPYEXPORTER_HPP
+#define DATA_NPYEXPORTER_HPP
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+
+#include "src/data/baseexporter.hpp"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+class AnalogTimeSignal;
+
+/**
+ * Exports AnalogTimeSignals to NumPy arrays in a worker thread.
+ *
+ * The absolute timestamps and the values of each signal are written as
+ * separate float64 arrays, either as single .npy files next to the given
+ * file name (`<name>_signal<n>_time.npy` and `<name>_signal<n>_value.npy`)
+ * or as members of one uncompressed .npz archive. The metadata of the
+ * signals (names, quantity, unit, ...) and the names of the arrays are
+ * written to a JSON sidecar file `<name>.json`, that can be imported again
+ * by NpyImporter.
+ *
+ * The samples are copied in large blocks and written without any
+ * formatting.
+ */
+class NpyExporter : public BaseExporter
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @param npz Write a .npz archive instead of single .npy files.
+	 */
+	NpyExporter(const vector<shared_ptr<AnalogTimeSignal>> &signals,
+		const string &file_name, bool npz);
+	~NpyExporter();
+
+	static const int SidecarVersion;
+
+protected:
+	QString export_proc() override;
+
+private:
+	QString write_npy_files(QJsonObject &signal_object, size_t signal_index);
+	QString write_npz_file();
+	/** Read the next block of a signal to `timestamps_` and `values_`. */
+	size_t read_block(size_t signal_index, size_t pos);
+	QJsonObject signal_metadata(size_t signal_index) const;
+	QString write_sidecar(const QJsonObject &sidecar) const;
+	QString file_error(const QString &file_name) const;
+	void add_progress(size_t count);
+
+	const bool npz_;
+	/** File name without the extension. */
+	QString base_name_;
+	vector<double> timestamps_;
+	vector<double> values_;
+	size_t written_count_;
+	size_t total_count_;
+
+	static const size_t BlockSize;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_NPYEXPORTER_HPP
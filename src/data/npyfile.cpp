@@ -0,0 +1,467 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "npyfile.hpp"
+
+using std::string;
+using std::to_string;
+using std::vector;
+
+namespace sv {
+namespace data {
+namespace npy {
+
+namespace {
+
+const char Magic[] = "\x93NUMPY";
+const size_t MagicSize = 6;
+const size_t Alignment = 64;
+
+bool is_little_endian()
+{
+	const uint16_t value = 1;
+	return *reinterpret_cast<const uint8_t *>(&value) == 1;
+}
+
+char byte_order()
+{
+	return is_little_endian() ? '<' : '>';
+}
+
+uint32_t read_u16(const char *data)
+{
+	const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8);
+}
+
+uint32_t read_u32(const char *data)
+{
+	const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+		((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+void put_u16(string &buffer, uint32_t value)
+{
+	buffer += (char)(value & 0xff);
+	buffer += (char)((value >> 8) & 0xff);
+}
+
+void put_u32(string &buffer, uint32_t value)
+{
+	put_u16(buffer, value & 0xffff);
+	put_u16(buffer, value >> 16);
+}
+
+/**
+ * Return the value of `key` in the header dictionary, up to the next ',' or
+ * '}' (or up to the closing ')' for tuples).
+ */
+bool find_value(const string &dict, const string &key, string &value)
+{
+	size_t pos = dict.find("'" + key + "'");
+	if (pos == string::npos)
+		return false;
+	pos = dict.find(':', pos);
+	if (pos == string::npos)
+		return false;
+	pos = dict.find_first_not_of(" ", pos + 1);
+	if (pos == string::npos)
+		return false;
+
+	size_t end;
+	if (dict[pos] == '(')
+		end = dict.find(')', pos) + 1;
+	else
+		end = dict.find_first_of(",}", pos);
+	if (end == string::npos || end == 0)
+		return false;
+
+	value = dict.substr(pos, end - pos);
+	while (!value.empty() && value.back() == ' ')
+		value.pop_back();
+	return true;
+}
+
+/** The CRC tables for slicing-by-8 with the reflected polynomial. */
+struct CrcTables
+{
+	CrcTables()
+	{
+		for (uint32_t i=0; i<256; ++i) {
+			uint32_t crc = i;
+			for (int j=0; j<8; ++j)
+				crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+			table[0][i] = crc;
+		}
+		for (uint32_t i=0; i<256; ++i) {
+			for (size_t t=1; t<8; ++t) {
+				table[t][i] = (table[t-1][i] >> 8) ^
+					table[0][table[t-1][i] & 0xff];
+			}
+		}
+	}
+
+	uint32_t table[8][256];
+};
+
+uint16_t dos_time(const struct tm &tm)
+{
+	return (uint16_t)((tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2));
+}
+
+uint16_t dos_date(const struct tm &tm)
+{
+	return (uint16_t)(((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) |
+		tm.tm_mday);
+}
+
+} // namespace
+
+string header(size_t count)
+{
+	string dict = "{'descr': '";
+	dict += byte_order();
+	dict += "f8', 'fortran_order': False, 'shape': (";
+	dict += to_string(count);
+	dict += ",), }";
+
+	// Magic (6), version (2), header length (2), dict and '\n'
+	const size_t prefix_size = MagicSize + 4;
+	size_t total_size = prefix_size + dict.size() + 1;
+	total_size = (total_size + Alignment - 1) / Alignment * Alignment;
+	dict.append(total_size - prefix_size - dict.size() - 1, ' ');
+	dict += '\n';
+
+	string header(Magic, MagicSize);
+	header += (char)1; // Major version
+	header += (char)0; // Minor version
+	put_u16(header, (uint32_t)dict.size());
+	header += dict;
+	return header;
+}
+
+bool parse_header(const char *data, size_t size, size_t &data_offset,
+	size_t &count, size_t &item_size, string &error)
+{
+	if (size < MagicSize + 4 || memcmp(data, Magic, MagicSize) != 0) {
+		error = "Not a NumPy array file";
+		return false;
+	}
+
+	const int major_version = (uint8_t)data[MagicSize];
+	size_t dict_offset;
+	size_t dict_size;
+	if (major_version == 1) {
+		dict_offset = MagicSize + 4;
+		dict_size = read_u16(data + MagicSize + 2);
+	}
+	else if ((major_version == 2 || major_version == 3) &&
+			size >= MagicSize + 6) {
+		dict_offset = MagicSize + 6;
+		dict_size = read_u32(data + MagicSize + 2);
+	}
+	else {
+		error = "Unsupported NumPy file version " + to_string(major_version);
+		return false;
+	}
+	if (dict_offset + dict_size > size) {
+		error = "Truncated NumPy file header";
+		return false;
+	}
+	const string dict(data + dict_offset, dict_size);
+
+	string descr;
+	string fortran_order;
+	string shape;
+	if (!find_value(dict, "descr", descr) ||
+			!find_value(dict, "fortran_order", fortran_order) ||
+			!find_value(dict, "shape", shape)) {
+		error = "Invalid NumPy file header";
+		return false;
+	}
+
+	const string native = string("'") + byte_order();
+	if (descr == native + "f8'")
+		item_size = 8;
+	else if (descr == native + "f4'")
+		item_size = 4;
+	else {
+		error = "Unsupported data type " + descr +
+			", only float64 and float32 arrays are supported";
+		return false;
+	}
+
+	// Only 1-dimensional arrays are supported, the order doesn't matter
+	(void)fortran_order;
+	if (shape.size() < 2 || shape.front() != '(' || shape.back() != ')') {
+		error = "Invalid shape " + shape;
+		return false;
+	}
+	string dims = shape.substr(1, shape.size() - 2);
+	while (!dims.empty() && (dims.back() == ',' || dims.back() == ' '))
+		dims.pop_back();
+	if (dims.empty()) {
+		count = 1;
+	}
+	else {
+		char *end;
+		count = (size_t)strtoull(dims.c_str(), &end, 10);
+		if (*end != '\0') {
+			error = "Unsupported shape " + shape +
+				", only 1-dimensional arrays are supported";
+			return false;
+		}
+	}
+
+	data_offset = dict_offset + dict_size;
+	if (count > (size - data_offset) / item_size) {
+		error = "Truncated NumPy file data";
+		return false;
+	}
+	return true;
+}
+
+bool find_member(const char *data, size_t size, const string &name,
+	size_t &member_offset, size_t &member_size, string &error)
+{
+	// The end of central directory record is followed by a comment of up to
+	// 64 KiB.
+	const size_t EndRecordSize = 22;
+	if (size < EndRecordSize) {
+		error = "Not a ZIP archive";
+		return false;
+	}
+	size_t end_record = size - EndRecordSize;
+	const size_t min_end_record =
+		size > EndRecordSize + 0xffff ? size - EndRecordSize - 0xffff : 0;
+	while (read_u32(data + end_record) != 0x06054b50) {
+		if (end_record == min_end_record) {
+			error = "Not a ZIP archive";
+			return false;
+		}
+		--end_record;
+	}
+
+	const size_t entry_count = read_u16(data + end_record + 10);
+	size_t entry = read_u32(data + end_record + 16);
+	for (size_t i=0; i<entry_count; ++i) {
+		if (entry + 46 > size || read_u32(data + entry) != 0x02014b50) {
+			error = "Invalid ZIP central directory";
+			return false;
+		}
+		const uint32_t method = read_u16(data + entry + 10);
+		const uint32_t compressed_size = read_u32(data + entry + 20);
+		const size_t name_size = read_u16(data + entry + 28);
+		const size_t extra_size = read_u16(data + entry + 30);
+		const size_t comment_size = read_u16(data + entry + 32);
+		const size_t local_header = read_u32(data + entry + 42);
+		if (entry + 46 + name_size > size) {
+			error = "Invalid ZIP central directory";
+			return false;
+		}
+
+		if (string(data + entry + 46, name_size) == name) {
+			if (method != 0) {
+				error = "The member " + name + " is compressed, only "
+					"uncompressed archives are supported";
+				return false;
+			}
+			if (local_header + 30 > size ||
+					read_u32(data + local_header) != 0x04034b50) {
+				error = "Invalid ZIP local header of " + name;
+				return false;
+			}
+			member_offset = local_header + 30 +
+				read_u16(data + local_header + 26) +
+				read_u16(data + local_header + 28);
+			member_size = compressed_size;
+			if (member_offset > size || member_size > size - member_offset) {
+				error = "Truncated ZIP member " + name;
+				return false;
+			}
+			return true;
+		}
+
+		entry += 46 + name_size + extra_size + comment_size;
+	}
+
+	error = "The member " + name + " was not found";
+	return false;
+}
+
+uint32_t crc32(uint32_t crc, const void *data, size_t size)
+{
+	static const CrcTables tables;
+	const uint32_t (&t)[8][256] = tables.table;
+
+	const auto *bytes = static_cast<const uint8_t *>(data);
+	crc = ~crc;
+	for (; size >= 8; size -= 8, bytes += 8) {
+		uint32_t low = crc ^ ((uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+			((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24));
+		crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^
+			t[5][(low >> 16) & 0xff] ^ t[4][low >> 24] ^
+			t[3][bytes[4]] ^ t[2][bytes[5]] ^ t[1][bytes[6]] ^ t[0][bytes[7]];
+	}
+	for (; size > 0; --size, ++bytes)
+		crc = (crc >> 8) ^ t[0][(crc ^ *bytes) & 0xff];
+	return ~crc;
+}
+
+const uint64_t NpzWriter::MaxSize = 0xffffffffu;
+
+NpzWriter::NpzWriter(FILE *file) :
+	file_(file),
+	offset_(0),
+	entry_size_(0),
+	error_(false)
+{
+	time_t now = time(nullptr);
+	struct tm tm;
+#ifdef _WIN32
+	localtime_s(&tm, &now);
+#else
+	localtime_r(&now, &tm);
+#endif
+	dos_time_ = dos_time(tm);
+	dos_date_ = dos_date(tm);
+}
+
+bool NpzWriter::begin_array(const string &name, size_t count)
+{
+	entry_.file_name = name + ".npy";
+	entry_.crc = 0;
+	entry_.size = 0;
+	entry_.offset = (uint32_t)offset_;
+	entry_size_ = 0;
+	if (offset_ > MaxSize)
+		error_ = true;
+
+	string local_header;
+	put_u32(local_header, 0x04034b50);
+	put_u16(local_header, 20); // Version needed to extract
+	put_u16(local_header, 0x0008); // Sizes and CRC in the data descriptor
+	put_u16(local_header, 0); // Stored
+	put_u16(local_header, dos_time_);
+	put_u16(local_header, dos_date_);
+	put_u32(local_header, 0); // CRC
+	put_u32(local_header, 0); // Compressed size
+	put_u32(local_header, 0); // Uncompressed size
+	put_u16(local_header, (uint32_t)entry_.file_name.size());
+	put_u16(local_header, 0); // Extra field length
+	local_header += entry_.file_name;
+	if (!write_raw(local_header.data(), local_header.size()))
+		return false;
+
+	const string npy_header = header(count);
+	entry_.crc = crc32(entry_.crc, npy_header.data(), npy_header.size());
+	entry_size_ += npy_header.size();
+	return write_raw(npy_header.data(), npy_header.size());
+}
+
+bool NpzWriter::write(const double *data, size_t count)
+{
+	const size_t size = count * sizeof(double);
+	entry_.crc = crc32(entry_.crc, data, size);
+	entry_size_ += size;
+	return write_raw(data, size);
+}
+
+bool NpzWriter::end_array()
+{
+	if (entry_size_ > MaxSize) {
+		error_ = true;
+		return false;
+	}
+	entry_.size = (uint32_t)entry_size_;
+
+	string descriptor;
+	put_u32(descriptor, 0x08074b50);
+	put_u32(descriptor, entry_.crc);
+	put_u32(descriptor, entry_.size); // Compressed size
+	put_u32(descriptor, entry_.size); // Uncompressed size
+	if (!write_raw(descriptor.data(), descriptor.size()))
+		return false;
+
+	entries_.push_back(entry_);
+	return true;
+}
+
+bool NpzWriter::finish()
+{
+	const uint64_t directory_offset = offset_;
+	string directory;
+	for (const auto &entry : entries_) {
+		put_u32(directory, 0x02014b50);
+		put_u16(directory, 20); // Version made by
+		put_u16(directory, 20); // Version needed to extract
+		put_u16(directory, 0x0008);
+		put_u16(directory, 0); // Stored
+		put_u16(directory, dos_time_);
+		put_u16(directory, dos_date_);
+		put_u32(directory, entry.crc);
+		put_u32(directory, entry.size); // Compressed size
+		put_u32(directory, entry.size); // Uncompressed size
+		put_u16(directory, (uint32_t)entry.file_name.size());
+		put_u16(directory, 0); // Extra field length
+		put_u16(directory, 0); // Comment length
+		put_u16(directory, 0); // Disk number
+		put_u16(directory, 0); // Internal attributes
+		put_u32(directory, 0); // External attributes
+		put_u32(directory, entry.offset);
+		directory += entry.file_name;
+	}
+
+	const size_t directory_size = directory.size();
+	put_u32(directory, 0x06054b50);
+	put_u16(directory, 0); // Disk number
+	put_u16(directory, 0); // Disk with the central directory
+	put_u16(directory, (uint32_t)entries_.size());
+	put_u16(directory, (uint32_t)entries_.size());
+	put_u32(directory, (uint32_t)directory_size);
+	put_u32(directory, (uint32_t)directory_offset);
+	put_u16(directory, 0); // Comment length
+
+	if (entries_.size() > 0xffff || directory_offset > MaxSize)
+		error_ = true;
+	return write_raw(directory.data(), directory.size());
+}
+
+bool NpzWriter::write_raw(const void *data, size_t size)
+{
+	if (error_)
+		return false;
+	if (fwrite(data, 1, size, file_) != size)
+		error_ = true;
+	offset_ += size;
+	return !error_;
+}
+
+} // namespace npy
+} // namespace data
+} // namespace sv
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_NPYFILE_HPP
+#define DATA_NPYFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+namespace npy {
+
+/**
+ * Return the header of a NumPy .npy file (format version 1.0) for a one
+ * dimensional array of `count` little endian doubles ('<f8'). The header is
+ * padded, so the data is 64 byte aligned.
+ */
+string header(size_t count);
+
+/**
+ * Parse the header of a .npy file.
+ *
+ * Only one dimensional arrays (or scalars) in C order of little endian
+ * doubles or floats ('<f8' or '<f4') are supported.
+ *
+ * @param data The start of the file.
+ * @param size The size of the file.
+ * @param data_offset The offset of the array data in the file.
+ * @param count The number of elements of the array.
+ * @param item_size The size of one element (8 or 4).
+ * @param error The error message, if the header is not supported.
+ *
+ * @return true, if the header is valid and the file contains all elements.
+ */
+bool parse_header(const char *data, size_t size, size_t &data_offset,
+	size_t &count, size_t &item_size, string &error);
+
+/**
+ * Find the member `name` of the uncompressed ZIP archive (e.g. a .npz file
+ * written by NpzWriter or by numpy.savez()) with the central directory.
+ * Compressed members (numpy.savez_compressed()) and ZIP64 are not supported.
+ *
+ * @param data The start of the archive.
+ * @param size The size of the archive.
+ * @param name The file name of the member, e.g. "signal0_time.npy".
+ * @param member_offset The offset of the member data in the archive.
+ * @param member_size The size of the member data.
+ * @param error The error message, if the member can't be found or read.
+ *
+ * @return true, if the member was found and is completely in the archive.
+ */
+bool find_member(const char *data, size_t size, const string &name,
+	size_t &member_offset, size_t &member_size, string &error);
+
+/**
+ * Update the CRC-32 (as used by ZIP) `crc` with `size` bytes of `data`.
+ * Start with a `crc` of 0.
+ */
+uint32_t crc32(uint32_t crc, const void *data, size_t size);
+
+/**
+ * Writes arrays as .npy members into an uncompressed ZIP archive (a NumPy
+ * .npz file).
+ *
+ * The members are streamed: The CRC is calculated while the data is written
+ * and stored in a data descriptor after the data, so no seeking is needed.
+ * ZIP64 is not supported, so the archive must be smaller than 4 GiB.
+ */
+class NpzWriter
+{
+
+public:
+	/**
+	 * The `file` must be opened in binary mode. It is not closed.
+	 */
+	explicit NpzWriter(FILE *file);
+
+	/**
+	 * Start a new array member `name` ("name.npy" in the archive) with
+	 * `count` doubles. The data must be written with `write()`.
+	 */
+	bool begin_array(const string &name, size_t count);
+	bool write(const double *data, size_t count);
+	bool end_array();
+	/** Write the central directory. */
+	bool finish();
+
+	static const uint64_t MaxSize;
+
+private:
+	struct Entry
+	{
+		string file_name;
+		uint32_t crc;
+		uint32_t size;
+		uint32_t offset;
+	};
+
+	bool write_raw(const void *data, size_t size);
+
+	FILE *file_;
+	uint64_t offset_;
+	vector<Entry> entries_;
+	/** The member, that is currently written. */
+	Entry entry_;
+	uint64_t entry_size_;
+	uint16_t dos_time_;
+	uint16_t dos_date_;
+	bool error_;
+
+};
+
+} // namespace npy
+} // namespace data
+} // namespace sv
+
+#endif // DATA_NPYFILE_HPP
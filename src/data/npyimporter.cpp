@@ -0,0 +1,280 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QString>
+
+#include "npyimporter.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/channels/userchannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/datautil.hpp"
+#include "src/data/npyfile.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::dynamic_pointer_cast;
+using std::map;
+using std::set;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+namespace {
+
+/** Reverse lookup of a name in one of the name maps of datautil. */
+template<typename T>
+T find_by_name(const map<T, QString> &name_map, const QString &name,
+	T default_value)
+{
+	for (const auto &name_pair : name_map) {
+		if (name_pair.second == name)
+			return name_pair.first;
+	}
+	return default_value;
+}
+
+} // namespace
+
+const size_t NpyImporter::BlockSize = 1 << 20;
+
+NpyImporter::NpyImporter(const QString &file_name) :
+	file_name_(file_name)
+{
+}
+
+QString NpyImporter::import(shared_ptr<devices::BaseDevice> device)
+{
+	QFile file(file_name_);
+	if (!file.open(QIODevice::ReadOnly))
+		return tr("Could not open %1: %2").arg(file_name_, file.errorString());
+
+	QJsonParseError parse_error;
+	const QJsonDocument document =
+		QJsonDocument::fromJson(file.readAll(), &parse_error);
+	if (document.isNull()) {
+		return tr("Could not parse %1: %2").
+			arg(file_name_, parse_error.errorString());
+	}
+
+	const QJsonObject sidecar = document.object();
+	const QString format = sidecar["format"].toString();
+	if (format != "npy" && format != "npz")
+		return tr("%1 is not a NumPy export").arg(file_name_);
+
+	// The archive is mapped once for all signals
+	QFile archive_file;
+	const char *archive = nullptr;
+	size_t archive_size = 0;
+	if (format == "npz") {
+		archive_file.setFileName(QFileInfo(file_name_).dir().filePath(
+			sidecar["file"].toString()));
+		if (!archive_file.open(QIODevice::ReadOnly)) {
+			return tr("Could not open %1: %2").
+				arg(archive_file.fileName(), archive_file.errorString());
+		}
+		archive_size = (size_t)archive_file.size();
+		archive = reinterpret_cast<const char *>(
+			archive_file.map(0, archive_file.size()));
+		if (!archive) {
+			return tr("Could not map %1: %2").
+				arg(archive_file.fileName(), archive_file.errorString());
+		}
+	}
+
+	for (const auto &signal_value : sidecar["signals"].toArray()) {
+		QString error = import_signal(signal_value.toObject(), device,
+			archive, archive_size);
+		if (!error.isEmpty())
+			return error;
+	}
+	return QString();
+}
+
+QString NpyImporter::import_signal(const QJsonObject &signal_object,
+	shared_ptr<devices::BaseDevice> device,
+	const char *archive, size_t archive_size)
+{
+	const QDir dir = QFileInfo(file_name_).dir();
+	Column time_column;
+	Column value_column;
+	for (const auto &column_pair : { std::make_pair("time", &time_column),
+			std::make_pair("value", &value_column) }) {
+		const QString name = signal_object[column_pair.first].toString();
+		QString error;
+		if (archive) {
+			// The members are named like the arrays plus ".npy"
+			const string member_name = name.toStdString() + ".npy";
+			size_t member_offset;
+			size_t member_size;
+			string member_error;
+			if (!npy::find_member(archive, archive_size, member_name,
+					member_offset, member_size, member_error)) {
+				return tr("Could not read %1: %2").
+					arg(name, QString::fromStdString(member_error));
+			}
+			error = column_pair.second->open(
+				archive + member_offset, member_size, name);
+		}
+		else {
+			error = column_pair.second->open(dir.filePath(name));
+		}
+		if (!error.isEmpty())
+			return error;
+	}
+	if (time_column.count() != value_column.count()) {
+		return tr("The time and value columns of the signal %1 have "
+			"different lengths").arg(signal_object["name"].toString());
+	}
+
+	const Quantity quantity = find_by_name(datautil::get_quantity_name_map(),
+		signal_object["quantity"].toString(), Quantity::Unknown);
+	set<QuantityFlag> quantity_flags;
+	const auto quantity_flag_name_map = datautil::get_quantity_flag_name_map();
+	for (const auto &flag_value : signal_object["quantity_flags"].toArray()) {
+		quantity_flags.insert(find_by_name(quantity_flag_name_map,
+			flag_value.toString(), QuantityFlag::Unknown));
+	}
+	const Unit unit = find_by_name(datautil::get_unit_name_map(),
+		signal_object["unit"].toString(), Unit::Unknown);
+
+	string channel_group_name;
+	const QJsonArray channel_group_array =
+		signal_object["channel_groups"].toArray();
+	if (!channel_group_array.isEmpty())
+		channel_group_name = channel_group_array[0].toString().toStdString();
+	const string channel_name = signal_object["channel"].toString().toStdString();
+
+	// Signals of the same channel are added to the same user channel
+	shared_ptr<channels::BaseChannel> channel;
+	const auto channel_map = device->channel_map();
+	const auto channel_it = channel_map.find(channel_name);
+	if (channel_it != channel_map.end())
+		channel = channel_it->second;
+	else
+		channel = device->add_user_channel(channel_name, channel_group_name);
+
+	auto signal = dynamic_pointer_cast<AnalogTimeSignal>(channel->add_signal(
+		quantity, quantity_flags, unit,
+		signal_object["name"].toString().toStdString()));
+	if (!signal)
+		return tr("Could not create the signal for %1").arg(
+			QString::fromStdString(channel_name));
+
+	const int total_digits = signal_object["total_digits"].toInt(
+		DefaultTotalDigits);
+	const int sr_digits = signal_object["sr_digits"].toInt(
+		DefaultDecimalPlaces);
+	vector<double> time_buffer;
+	vector<double> value_buffer;
+	for (size_t pos=0; pos<time_column.count(); pos+=BlockSize) {
+		const size_t count = std::min(BlockSize, time_column.count() - pos);
+		signal->push_samples(
+			time_column.data(pos, count, time_buffer),
+			value_column.data(pos, count, value_buffer),
+			count, total_digits, sr_digits);
+	}
+
+	return QString();
+}
+
+NpyImporter::Column::Column() :
+	data_(nullptr),
+	count_(0),
+	item_size_(0)
+{
+}
+
+QString NpyImporter::Column::open(const QString &file_name)
+{
+	file_.setFileName(file_name);
+	if (!file_.open(QIODevice::ReadOnly))
+		return tr("Could not open %1: %2").arg(file_name, file_.errorString());
+
+	const uchar *mapped = file_.map(0, file_.size());
+	if (!mapped) {
+		return tr("Could not map %1: %2").
+			arg(file_name, file_.errorString());
+	}
+
+	return open(reinterpret_cast<const char *>(mapped),
+		(size_t)file_.size(), file_name);
+}
+
+QString NpyImporter::Column::open(const char *data, size_t size,
+	const QString &name)
+{
+	size_t data_offset;
+	string error;
+	if (!npy::parse_header(data, size, data_offset, count_, item_size_,
+			error)) {
+		return tr("Could not read %1: %2").
+			arg(name, QString::fromStdString(error));
+	}
+	data_ = data + data_offset;
+	return QString();
+}
+
+size_t NpyImporter::Column::count() const
+{
+	return count_;
+}
+
+const double *NpyImporter::Column::data(size_t pos, size_t count,
+	vector<double> &buffer)
+{
+	const char *start = data_ + pos * item_size_;
+	if (item_size_ == sizeof(double) &&
+			reinterpret_cast<uintptr_t>(start) % alignof(double) == 0)
+		return reinterpret_cast<const double *>(start);
+
+	buffer.resize(count);
+	if (item_size_ == sizeof(double)) {
+		memcpy(buffer.data(), start, count * sizeof(double));
+	}
+	else {
+		for (size_t i=0; i<count; ++i) {
+			float value;
+			memcpy(&value, start + i * sizeof(float), sizeof(float));
+			buffer[i] = value;
+		}
+	}
+	return buffer.data();
+}
+
+} // namespace data
+} // namespace sv
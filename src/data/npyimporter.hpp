@@ -0,0 +1,113 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_NPYIMPORTER_HPP
+#define DATA_NPYIMPORTER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonObject>
+#include <QString>
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+
+namespace sv {
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace data {
+
+class AnalogTimeSignal;
+
+/**
+ * Imports the signals of a NumPy export (see NpyExporter) into user channels
+ * of a device.
+ *
+ * The JSON sidecar file is read and the .npy files (or the .npz archive) of
+ * the signals are memory mapped, the samples are copied from the mapped files
+ * directly into the signals. Only uncompressed .npz archives are supported,
+ * like the ones written by NpyExporter.
+ */
+class NpyImporter
+{
+	Q_DECLARE_TR_FUNCTIONS(NpyImporter)
+
+public:
+	/**
+	 * @param file_name The file name of the JSON sidecar file.
+	 */
+	explicit NpyImporter(const QString &file_name);
+
+	/**
+	 * Import all signals of the sidecar file into new user channels of
+	 * `device`.
+	 *
+	 * @return An empty string on success, otherwise the error message.
+	 */
+	QString import(shared_ptr<devices::BaseDevice> device);
+
+private:
+	/** A memory mapped .npy file or a .npy member of a mapped archive. */
+	class Column
+	{
+	public:
+		Column();
+		QString open(const QString &file_name);
+		/** Use the .npy data at `data`, that is mapped by the caller. */
+		QString open(const char *data, size_t size, const QString &name);
+		size_t count() const;
+		/**
+		 * Return a pointer to the elements [pos, pos + count) as doubles. The
+		 * elements are converted to `buffer`, if they can't be used directly.
+		 */
+		const double *data(size_t pos, size_t count, vector<double> &buffer);
+
+	private:
+		QFile file_;
+		const char *data_;
+		size_t count_;
+		size_t item_size_;
+	};
+
+	/**
+	 * Import one signal. When `archive` is set, the columns are read from
+	 * the members of the mapped .npz archive.
+	 */
+	QString import_signal(const QJsonObject &signal_object,
+		shared_ptr<devices::BaseDevice> device,
+		const char *archive, size_t archive_size);
+
+	const QString file_name_;
+
+	static const size_t BlockSize;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_NPYIMPORTER_HPP
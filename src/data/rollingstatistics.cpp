@@ -0,0 +1,170 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <utility>
+
+#include "rollingstatistics.hpp"
+
+using std::make_pair;
+
+namespace sv {
+namespace data {
+
+RollingStatistics::RollingStatistics(
+		size_t window_sample_count, double window_time) :
+	window_sample_count_(window_sample_count),
+	window_time_(window_time),
+	first_index_(0),
+	reference_(0.),
+	sum_(0.),
+	sum_squares_(0.),
+	removed_since_renormalize_(0)
+{
+}
+
+void RollingStatistics::add(double timestamp, double value)
+{
+	if (samples_.empty())
+		reference_ = value;
+
+	const uint64_t index = first_index_ + samples_.size();
+	samples_.push_back(make_pair(timestamp, value));
+
+	while (!min_deque_.empty() && min_deque_.back().second >= value)
+		min_deque_.pop_back();
+	min_deque_.push_back(make_pair(index, value));
+	while (!max_deque_.empty() && max_deque_.back().second <= value)
+		max_deque_.pop_back();
+	max_deque_.push_back(make_pair(index, value));
+
+	double shifted = value - reference_;
+	sum_ += shifted;
+	sum_squares_ += shifted * shifted;
+
+	// Remove the samples that have left the window
+	while (samples_.size() > 1 &&
+		((window_sample_count_ > 0 && samples_.size() > window_sample_count_) ||
+		(window_time_ > 0 && samples_.front().first < timestamp - window_time_))) {
+
+		shifted = samples_.front().second - reference_;
+		sum_ -= shifted;
+		sum_squares_ -= shifted * shifted;
+		samples_.pop_front();
+
+		if (min_deque_.front().first == first_index_)
+			min_deque_.pop_front();
+		if (max_deque_.front().first == first_index_)
+			max_deque_.pop_front();
+
+		++first_index_;
+		++removed_since_renormalize_;
+	}
+
+	if (removed_since_renormalize_ >= samples_.size())
+		renormalize();
+}
+
+void RollingStatistics::clear()
+{
+	first_index_ += samples_.size();
+	samples_.clear();
+	min_deque_.clear();
+	max_deque_.clear();
+	reference_ = 0.;
+	sum_ = 0.;
+	sum_squares_ = 0.;
+	removed_since_renormalize_ = 0;
+}
+
+size_t RollingStatistics::count() const
+{
+	return samples_.size();
+}
+
+double RollingStatistics::min() const
+{
+	if (min_deque_.empty())
+		return std::numeric_limits<double>::quiet_NaN();
+	return min_deque_.front().second;
+}
+
+double RollingStatistics::max() const
+{
+	if (max_deque_.empty())
+		return std::numeric_limits<double>::quiet_NaN();
+	return max_deque_.front().second;
+}
+
+double RollingStatistics::peak_to_peak() const
+{
+	return max() - min();
+}
+
+double RollingStatistics::mean() const
+{
+	if (samples_.empty())
+		return std::numeric_limits<double>::quiet_NaN();
+	return reference_ + sum_ / (double)samples_.size();
+}
+
+double RollingStatistics::stddev() const
+{
+	if (samples_.empty())
+		return std::numeric_limits<double>::quiet_NaN();
+
+	const double n = (double)samples_.size();
+	const double shifted_mean = sum_ / n;
+	double variance = sum_squares_ / n - shifted_mean * shifted_mean;
+	if (variance < 0)
+		variance = 0;
+	return std::sqrt(variance);
+}
+
+double RollingStatistics::rms() const
+{
+	if (samples_.empty())
+		return std::numeric_limits<double>::quiet_NaN();
+
+	// sum(x^2) = sum((x-r)^2) + 2*r*sum(x-r) + n*r^2
+	const double n = (double)samples_.size();
+	double mean_squares = sum_squares_ / n +
+		2 * reference_ * sum_ / n + reference_ * reference_;
+	if (mean_squares < 0)
+		mean_squares = 0;
+	return std::sqrt(mean_squares);
+}
+
+void RollingStatistics::renormalize()
+{
+	reference_ = mean();
+	sum_ = 0.;
+	sum_squares_ = 0.;
+	for (const auto &sample : samples_) {
+		double shifted = sample.second - reference_;
+		sum_ += shifted;
+		sum_squares_ += shifted * shifted;
+	}
+	removed_since_renormalize_ = 0;
+}
+
+} // namespace data
+} // namespace sv
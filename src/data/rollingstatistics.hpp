@@ -0,0 +1,100 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_ROLLINGSTATISTICS_HPP
+#define DATA_ROLLINGSTATISTICS_HPP
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+using std::deque;
+using std::pair;
+
+namespace sv {
+namespace data {
+
+/**
+ * Statistics over a sliding window of samples, the window is defined by a
+ * sample count or by a time span.
+ *
+ * Adding a sample costs O(1) amortized:
+ * - Min/max are tracked with monotonic deques.
+ * - Mean/stddev/RMS are calculated from running sums of the samples, shifted
+ *   by a reference value to avoid cancellation for signals with a large
+ *   offset. The sums (and the reference value) are recalculated after the
+ *   window has been replaced completely, so rounding errors don't accumulate.
+ */
+class RollingStatistics
+{
+
+public:
+	/**
+	 * @param window_sample_count The maximum number of samples in the
+	 *        window, 0 for no limit.
+	 * @param window_time The maximum time span of the window in seconds, 0
+	 *        for no limit.
+	 */
+	RollingStatistics(size_t window_sample_count, double window_time);
+
+	/**
+	 * Add a sample to the window and remove the samples that are not in the
+	 * window anymore. The timestamps must be in ascending order.
+	 */
+	void add(double timestamp, double value);
+
+	/**
+	 * Remove all samples from the window.
+	 */
+	void clear();
+
+	size_t count() const;
+	double min() const;
+	double max() const;
+	double peak_to_peak() const;
+	double mean() const;
+	/** The (population) standard deviation of the samples in the window. */
+	double stddev() const;
+	double rms() const;
+
+private:
+	void renormalize();
+
+	size_t window_sample_count_;
+	double window_time_;
+
+	/** Timestamp and value of all samples in the window. */
+	deque<pair<double, double>> samples_;
+	/** Index of the first sample in the window. */
+	uint64_t first_index_;
+	/** Index and value of the min/max candidates. */
+	deque<pair<uint64_t, double>> min_deque_;
+	deque<pair<uint64_t, double>> max_deque_;
+
+	double reference_;
+	double sum_;
+	double sum_squares_;
+	size_t removed_since_renormalize_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_ROLLINGSTATISTICS_HPP
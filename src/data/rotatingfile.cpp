@@ -0,0 +1,204 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "rotatingfile.hpp"
+
+using std::string;
+using std::to_string;
+
+namespace sv {
+namespace data {
+
+RotatingFile::RotatingFile(const string &base_name, const string &extension,
+		uint64_t max_size, double max_duration, double sync_interval) :
+	base_name_(base_name),
+	extension_(extension),
+	max_size_(max_size),
+	max_duration_(max_duration),
+	sync_interval_(sync_interval),
+	file_(nullptr),
+	file_index_(0),
+	file_count_(0),
+	file_size_(0),
+	file_start_(0.),
+	last_sync_(0.),
+	unsynced_(false)
+{
+}
+
+RotatingFile::~RotatingFile()
+{
+	close();
+}
+
+void RotatingFile::set_header(const string &header)
+{
+	header_ = header;
+}
+
+bool RotatingFile::write(const char *data, size_t size, double now)
+{
+	if (!error_.empty())
+		return false;
+
+	bool rotate = false;
+	if (file_ && max_size_ > 0 && file_size_ > header_.size() &&
+			file_size_ + size > max_size_)
+		rotate = true;
+	if (file_ && max_duration_ > 0 && now - file_start_ >= max_duration_)
+		rotate = true;
+	if (rotate && !close())
+		return false;
+	if (!file_ && !open(now))
+		return false;
+
+	if (fwrite(data, 1, size, file_) != size) {
+		set_error("Could not write " + file_name_);
+		return false;
+	}
+	file_size_ += size;
+	unsynced_ = true;
+	return true;
+}
+
+bool RotatingFile::flush(double now)
+{
+	if (!file_ || !error_.empty())
+		return error_.empty();
+
+	if (fflush(file_) != 0) {
+		set_error("Could not write " + file_name_);
+		return false;
+	}
+	if (unsynced_ && now - last_sync_ >= sync_interval_) {
+		last_sync_ = now;
+		return sync();
+	}
+	return true;
+}
+
+bool RotatingFile::close()
+{
+	if (!file_)
+		return error_.empty();
+
+	bool ok = fflush(file_) == 0 && sync();
+	ok = fclose(file_) == 0 && ok;
+	file_ = nullptr;
+	if (!ok && error_.empty())
+		set_error("Could not write " + file_name_);
+	return ok;
+}
+
+const string &RotatingFile::file_name() const
+{
+	return file_name_;
+}
+
+const string &RotatingFile::error() const
+{
+	return error_;
+}
+
+size_t RotatingFile::file_count() const
+{
+	return file_count_;
+}
+
+bool RotatingFile::open(double now)
+{
+	if (name_prefix_.empty()) {
+		// All files of this logging session share the start time in the name
+		time_t start = (time_t)now;
+		struct tm tm;
+#ifdef _WIN32
+		localtime_s(&tm, &start);
+#else
+		localtime_r(&start, &tm);
+#endif
+		char date_time[32];
+		strftime(date_time, sizeof(date_time), "%Y%m%d-%H%M%S", &tm);
+		name_prefix_ = base_name_ + "_" + date_time + "_";
+	}
+
+	// Don't overwrite existing files (e.g. of a logger with the same name)
+	while (true) {
+		file_name_ = name_prefix_ + to_string(file_index_++) + "." + extension_;
+		FILE *existing_file = fopen(file_name_.c_str(), "rb");
+		if (!existing_file)
+			break;
+		fclose(existing_file);
+	}
+
+	file_ = fopen(file_name_.c_str(), "wb");
+	if (!file_) {
+		set_error("Could not open " + file_name_);
+		return false;
+	}
+	++file_count_;
+	file_size_ = 0;
+	file_start_ = now;
+	last_sync_ = now;
+
+	if (!header_.empty()) {
+		if (fwrite(header_.data(), 1, header_.size(), file_) !=
+				header_.size()) {
+			set_error("Could not write " + file_name_);
+			return false;
+		}
+		file_size_ = header_.size();
+	}
+	return true;
+}
+
+bool RotatingFile::sync()
+{
+	unsynced_ = false;
+#ifdef _WIN32
+	int result = _commit(_fileno(file_));
+#else
+	int result = fsync(fileno(file_));
+#endif
+	if (result != 0) {
+		set_error("Could not sync " + file_name_);
+		return false;
+	}
+	return true;
+}
+
+void RotatingFile::set_error(const string &what)
+{
+	error_ = what + ": " + strerror(errno);
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_ROTATINGFILE_HPP
+#define DATA_ROTATINGFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+using std::string;
+
+namespace sv {
+namespace data {
+
+/**
+ * An append only file, that is rotated by size and/or by time.
+ *
+ * The files are named `<base_name>_<date>-<time>_<n>.<extension>`, where the
+ * date and time are the start of the first file and `n` counts the files.
+ * Existing files are never overwritten.
+ * Every file starts with the same header. The data is handed to the OS with
+ * `flush()`, and is synced to the disk (fsync) in the given interval.
+ *
+ * All times are in seconds since the epoch and are passed by the caller, so
+ * the class doesn't depend on a clock.
+ */
+class RotatingFile
+{
+
+public:
+	/**
+	 * @param max_size Rotate, when a file exceeds this size in bytes.
+	 *                 0 disables the rotation by size.
+	 * @param max_duration Rotate after this time span in seconds.
+	 *                     0 disables the rotation by time.
+	 * @param sync_interval The min. time span in seconds between two syncs
+	 *                      to the disk. 0 syncs with every `flush()`.
+	 */
+	RotatingFile(const string &base_name, const string &extension,
+		uint64_t max_size, double max_duration, double sync_interval);
+	~RotatingFile();
+
+	RotatingFile(const RotatingFile &) = delete;
+	RotatingFile &operator=(const RotatingFile &) = delete;
+
+	/** The header, that is written at the start of every file. */
+	void set_header(const string &header);
+
+	/**
+	 * Append the data to the current file. A new file is opened first, if
+	 * there is no file yet or if the current file has to be rotated. The
+	 * data is never split between two files.
+	 */
+	bool write(const char *data, size_t size, double now);
+	/**
+	 * Hand the buffered data to the OS and sync it to the disk, if the
+	 * sync interval has elapsed.
+	 */
+	bool flush(double now);
+	/** Sync and close the current file. */
+	bool close();
+
+	/** The name of the current (or the last) file. */
+	const string &file_name() const;
+	/** The last error, empty if there was no error. */
+	const string &error() const;
+	/** The number of opened files. */
+	size_t file_count() const;
+
+private:
+	bool open(double now);
+	bool sync();
+	void set_error(const string &what);
+
+	const string base_name_;
+	const string extension_;
+	const uint64_t max_size_;
+	const double max_duration_;
+	const double sync_interval_;
+	string header_;
+	string name_prefix_;
+
+	FILE *file_;
+	string file_name_;
+	/** The number `n` in the name of the next file. */
+	size_t file_index_;
+	size_t file_count_;
+	uint64_t file_size_;
+	double file_start_;
+	double last_sync_;
+	bool unsynced_;
+	string error_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_ROTATINGFILE_HPP
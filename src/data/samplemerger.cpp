@@ -0,0 +1,180 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "samplemerger.hpp"
+
+using std::pair;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+namespace {
+
+/** Heap order for a min-heap, equal timestamps are ordered by source. */
+bool heap_greater(const pair<double, size_t> &a, const pair<double, size_t> &b)
+{
+	return a > b;
+}
+
+} // namespace
+
+const size_t SampleMerger::BlockSize = 4096;
+
+SampleMerger::SampleMerger(const vector<size_t> &sample_counts,
+		fetch_func_t fetch, double timeframe) :
+	fetch_(fetch),
+	timeframe_(timeframe),
+	cursors_(sample_counts.size()),
+	row_has_value_(sample_counts.size(), 0),
+	row_values_(sample_counts.size(), 0.),
+	row_timestamp_(0.),
+	merged_count_(0),
+	total_count_(0)
+{
+	heap_.reserve(cursors_.size());
+	for (size_t i=0; i<cursors_.size(); ++i) {
+		cursors_[i].pos = 0;
+		cursors_[i].end = sample_counts[i];
+		cursors_[i].block_pos = 0;
+		total_count_ += sample_counts[i];
+		if (fill(i))
+			push(i);
+	}
+}
+
+void SampleMerger::set_timeframe(double timeframe)
+{
+	timeframe_ = timeframe;
+}
+
+double SampleMerger::timeframe() const
+{
+	return timeframe_;
+}
+
+bool SampleMerger::next()
+{
+	for (const auto &source : row_sources_)
+		row_has_value_[source] = 0;
+	row_sources_.clear();
+
+	if (heap_.empty())
+		return false;
+
+	row_timestamp_ = heap_.front().first;
+	const double max_timestamp = row_timestamp_ + timeframe_;
+	while (!heap_.empty() && heap_.front().first <= max_timestamp) {
+		size_t source = pop();
+		Cursor &cursor = cursors_[source];
+		row_has_value_[source] = 1;
+		row_values_[source] = cursor.values[cursor.pos - cursor.block_pos];
+		row_sources_.push_back(source);
+		++cursor.pos;
+		++merged_count_;
+	}
+
+	// Sources are pushed back after the row, so each has one value at most
+	for (const auto &source : row_sources_) {
+		if (fill(source))
+			push(source);
+	}
+
+	return true;
+}
+
+double SampleMerger::timestamp() const
+{
+	return row_timestamp_;
+}
+
+size_t SampleMerger::source_count() const
+{
+	return cursors_.size();
+}
+
+bool SampleMerger::has_value(size_t source) const
+{
+	return row_has_value_[source] != 0;
+}
+
+double SampleMerger::value(size_t source) const
+{
+	return row_values_[source];
+}
+
+size_t SampleMerger::merged_count() const
+{
+	return merged_count_;
+}
+
+size_t SampleMerger::total_count() const
+{
+	return total_count_;
+}
+
+bool SampleMerger::fill(size_t source)
+{
+	Cursor &cursor = cursors_[source];
+	if (cursor.pos >= cursor.end)
+		return false;
+	if (cursor.pos < cursor.block_pos + cursor.timestamps.size())
+		return true;
+
+	cursor.block_pos = cursor.pos;
+	fetch_(source, cursor.pos, std::min(cursor.pos + BlockSize, cursor.end),
+		cursor.timestamps, cursor.values);
+	assert(cursor.timestamps.size() == cursor.values.size());
+
+	// The source could have fewer samples than expected (e.g. cleared)
+	if (cursor.timestamps.empty()) {
+		cursor.end = cursor.pos;
+		return false;
+	}
+	return true;
+}
+
+double SampleMerger::head_timestamp(size_t source) const
+{
+	const Cursor &cursor = cursors_[source];
+	return cursor.timestamps[cursor.pos - cursor.block_pos];
+}
+
+void SampleMerger::push(size_t source)
+{
+	heap_.emplace_back(head_timestamp(source), source);
+	std::push_heap(heap_.begin(), heap_.end(), heap_greater);
+}
+
+size_t SampleMerger::pop()
+{
+	std::pop_heap(heap_.begin(), heap_.end(), heap_greater);
+	size_t source = heap_.back().second;
+	heap_.pop_back();
+	return source;
+}
+
+} // namespace data
+} // namespace sv
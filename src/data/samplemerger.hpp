@@ -0,0 +1,125 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_SAMPLEMERGER_HPP
+#define DATA_SAMPLEMERGER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using std::function;
+using std::pair;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * K-way merge of the samples of several time signals into rows with a
+ * common timestamp.
+ *
+ * The timestamp of a row is the smallest timestamp of all the next samples.
+ * Every source, whose next sample is not later than the row timestamp plus
+ * the `timeframe`, contributes this sample to the row, the other sources have
+ * no value in this row. Each source contributes at most one sample per row.
+ *
+ * The next sample of every source is kept in a min-heap, so a row costs
+ * O(k log n) for k values out of n sources. The samples are fetched block
+ * wise by the `fetch` function, which must copy the samples [pos, end) of
+ * the source to the timestamps and values vectors (like
+ * AnalogTimeSignal::get_samples()). The timestamps of a source must be
+ * ascending.
+ */
+class SampleMerger
+{
+
+public:
+	typedef function<void(size_t source, size_t pos, size_t end,
+		vector<double> &timestamps, vector<double> &values)> fetch_func_t;
+
+	/**
+	 * @param sample_counts The number of samples to merge for each source.
+	 * @param fetch The function that fetches the samples of a source.
+	 * @param timeframe The time span in which samples are combined into
+	 *                  one row.
+	 */
+	SampleMerger(const vector<size_t> &sample_counts, fetch_func_t fetch,
+		double timeframe = 0.);
+
+	void set_timeframe(double timeframe);
+	double timeframe() const;
+
+	/**
+	 * Advance to the next row.
+	 *
+	 * @return false, if all samples have been merged.
+	 */
+	bool next();
+
+	/** The timestamp of the current row. */
+	double timestamp() const;
+	size_t source_count() const;
+	/** Return true, if the source has a value in the current row. */
+	bool has_value(size_t source) const;
+	double value(size_t source) const;
+	/** The number of samples, that have been merged so far. */
+	size_t merged_count() const;
+	/** The number of samples to merge for all sources. */
+	size_t total_count() const;
+
+	static const size_t BlockSize;
+
+private:
+	struct Cursor
+	{
+		size_t pos;
+		size_t end;
+		/** Position of `timestamps[0]` in the source. */
+		size_t block_pos;
+		vector<double> timestamps;
+		vector<double> values;
+	};
+
+	/** Fetch the next block of a cursor, if the current one is exhausted. */
+	bool fill(size_t source);
+	double head_timestamp(size_t source) const;
+	void push(size_t source);
+	size_t pop();
+
+	fetch_func_t fetch_;
+	double timeframe_;
+	vector<Cursor> cursors_;
+	/** Min-heap of (next timestamp, source). */
+	vector<pair<double, size_t>> heap_;
+	/** The sources with a value in the current row. */
+	vector<size_t> row_sources_;
+	vector<char> row_has_value_;
+	vector<double> row_values_;
+	double row_timestamp_;
+	size_t merged_count_;
+	size_t total_count_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_SAMPLEMERGER_HPP
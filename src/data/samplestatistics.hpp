@@ -0,0 +1,99 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_SAMPLESTATISTICS_HPP
+#define DATA_SAMPLESTATISTICS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "src/data/compensatedsum.hpp"
+
+namespace sv {
+namespace data {
+
+/**
+ * Min, max, mean and count of all samples since the last reset.
+ *
+ * Non-finite values (NaN and overflows) are ignored.
+ */
+class SampleStatistics
+{
+
+public:
+	SampleStatistics() :
+		count_(0),
+		min_(std::numeric_limits<double>::max()),
+		max_(std::numeric_limits<double>::lowest())
+	{
+	}
+
+	void add(double value)
+	{
+		if (!std::isfinite(value))
+			return;
+		++count_;
+		if (value < min_)
+			min_ = value;
+		if (value > max_)
+			max_ = value;
+		sum_.add(value);
+	}
+
+	void reset()
+	{
+		*this = SampleStatistics();
+	}
+
+	size_t count() const
+	{
+		return count_;
+	}
+
+	/** Only valid, if count() is not 0. */
+	double min() const
+	{
+		return min_;
+	}
+
+	/** Only valid, if count() is not 0. */
+	double max() const
+	{
+		return max_;
+	}
+
+	/** Only valid, if count() is not 0. */
+	double mean() const
+	{
+		return sum_.value() / (double)count_;
+	}
+
+private:
+	size_t count_;
+	double min_;
+	double max_;
+	CompensatedSum sum_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_SAMPLESTATISTICS_HPP
@@ -0,0 +1,266 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QString>
+
+#include "signallogger.hpp"
+#include "src/channels/basechannel.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/samplemerger.hpp"
+#include "src/devices/basedevice.hpp"
+
+using std::atomic;
+using std::lock_guard;
+using std::mutex;
+using std::shared_ptr;
+using std::string;
+using std::unique_lock;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+namespace {
+
+double now_seconds()
+{
+	return std::chrono::duration<double>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void append_u32(vector<char> &buffer, uint32_t value)
+{
+	const char *bytes = reinterpret_cast<const char *>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+} // namespace
+
+const std::chrono::milliseconds SignalLogger::WriteInterval(250);
+const size_t SignalLogger::FlushSize = 1 << 20;
+
+SignalLogger::SignalLogger(const vector<shared_ptr<AnalogTimeSignal>> &signals,
+		const string &base_name, LogFormat format, uint64_t max_file_size,
+		double max_file_duration, double sync_interval) :
+	signals_(signals),
+	format_(format),
+	file_(base_name, format == LogFormat::Csv ? "csv" : "svlog",
+		max_file_size, max_file_duration, sync_interval),
+	clear_counts_(new atomic<size_t>[signals.size()]),
+	seen_clear_counts_(signals.size(), 0),
+	positions_(signals.size(), 0),
+	failed_(false),
+	abort_(false)
+{
+	for (size_t i=0; i<signals_.size(); ++i) {
+		clear_counts_[i] = 0;
+		// The signals are cleared in the acquisition thread
+		connect(signals_[i].get(), &AnalogTimeSignal::samples_cleared,
+			this, [this, i]() { ++clear_counts_[i]; }, Qt::DirectConnection);
+
+		string label = signal_label(i);
+		string quoted_label = "\"";
+		for (const char c : label) {
+			if (c == '"')
+				quoted_label += '"';
+			quoted_label += c;
+		}
+		quoted_label += '"';
+		csv_labels_.push_back(quoted_label);
+	}
+
+	if (format_ == LogFormat::Csv)
+		file_.set_header(csv_header());
+	else
+		file_.set_header(binary_header());
+}
+
+SignalLogger::~SignalLogger()
+{
+	stop();
+	if (writer_thread_.joinable())
+		writer_thread_.join();
+}
+
+void SignalLogger::start()
+{
+	assert(!writer_thread_.joinable());
+
+	// Only the new samples are logged
+	for (size_t i=0; i<signals_.size(); ++i)
+		positions_[i] = signals_[i]->sample_count();
+
+	abort_ = false;
+	writer_thread_ = std::thread(&SignalLogger::write_proc, this);
+}
+
+void SignalLogger::stop()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		abort_ = true;
+	}
+	abort_condition_.notify_one();
+}
+
+void SignalLogger::write_proc()
+{
+	unique_lock<mutex> lock(mutex_);
+	while (!abort_) {
+		abort_condition_.wait_for(lock, WriteInterval, [this] {
+			return abort_;
+		});
+		lock.unlock();
+		write_new_samples();
+		lock.lock();
+	}
+
+	if (!file_.close() && !failed_) {
+		failed_ = true;
+		Q_EMIT error_occurred(QString::fromStdString(file_.error()));
+	}
+	Q_EMIT finished();
+}
+
+void SignalLogger::write_new_samples()
+{
+	if (failed_)
+		return;
+
+	vector<size_t> sample_counts(signals_.size());
+	for (size_t i=0; i<signals_.size(); ++i) {
+		const size_t clear_count = clear_counts_[i];
+		if (clear_count != seen_clear_counts_[i]) {
+			seen_clear_counts_[i] = clear_count;
+			positions_[i] = 0;
+		}
+		const size_t sample_count = signals_[i]->sample_count();
+		if (sample_count < positions_[i])
+			positions_[i] = 0;
+		sample_counts[i] = sample_count - positions_[i];
+	}
+
+	SampleMerger merger(sample_counts,
+		[this](size_t source, size_t pos, size_t end,
+				vector<double> &timestamps, vector<double> &values) {
+			signals_[source]->get_samples(positions_[source] + pos,
+				positions_[source] + end, timestamps, values, false);
+		});
+	const double now = now_seconds();
+	while (merger.next()) {
+		for (size_t i=0; i<merger.source_count(); ++i) {
+			if (merger.has_value(i))
+				append_record(i, merger.timestamp(), merger.value(i));
+		}
+		if (csv_formatter_.size() + binary_buffer_.size() >= FlushSize &&
+				!write_buffer(now))
+			return;
+	}
+	if (!write_buffer(now))
+		return;
+
+	for (size_t i=0; i<signals_.size(); ++i)
+		positions_[i] += sample_counts[i];
+
+	if (!file_.flush(now)) {
+		failed_ = true;
+		Q_EMIT error_occurred(QString::fromStdString(file_.error()));
+	}
+}
+
+void SignalLogger::append_record(size_t signal_index, double timestamp,
+	double value)
+{
+	if (format_ == LogFormat::Csv) {
+		csv_formatter_.append_fixed(timestamp, 6);
+		csv_formatter_.append(',');
+		csv_formatter_.append(csv_labels_[signal_index]);
+		csv_formatter_.append(',');
+		csv_formatter_.append_double(value, 17);
+		csv_formatter_.end_line();
+	}
+	else {
+		char record[24];
+		const uint32_t index = (uint32_t)signal_index;
+		const uint32_t padding = 0;
+		memcpy(record, &timestamp, 8);
+		memcpy(record + 8, &value, 8);
+		memcpy(record + 16, &index, 4);
+		memcpy(record + 20, &padding, 4);
+		binary_buffer_.insert(binary_buffer_.end(), record, record + 24);
+	}
+}
+
+bool SignalLogger::write_buffer(double now)
+{
+	bool ok = true;
+	if (csv_formatter_.size() > 0) {
+		ok = file_.write(csv_formatter_.data(), csv_formatter_.size(), now);
+		csv_formatter_.clear();
+	}
+	if (!binary_buffer_.empty()) {
+		ok = file_.write(binary_buffer_.data(), binary_buffer_.size(), now);
+		binary_buffer_.clear();
+	}
+	if (!ok) {
+		failed_ = true;
+		Q_EMIT error_occurred(QString::fromStdString(file_.error()));
+	}
+	return ok;
+}
+
+string SignalLogger::signal_label(size_t signal_index) const
+{
+	const auto &signal = signals_[signal_index];
+	const auto channel = signal->parent_channel();
+	return channel->parent_device()->name() + "/" + channel->name() + "/" +
+		signal->name() + " [" + signal->unit_name().toStdString() + "]";
+}
+
+string SignalLogger::csv_header() const
+{
+	return "Time,Signal,Value\n";
+}
+
+string SignalLogger::binary_header() const
+{
+	vector<char> header = { 'S', 'M', 'U', 'V', 'L', 'O', 'G', '\x01' };
+	append_u32(header, 0x01020304);
+	append_u32(header, (uint32_t)signals_.size());
+	for (size_t i=0; i<signals_.size(); ++i) {
+		const string label = signal_label(i);
+		append_u32(header, (uint32_t)label.size());
+		header.insert(header.end(), label.begin(), label.end());
+	}
+	return string(header.begin(), header.end());
+}
+
+} // namespace data
+} // namespace sv
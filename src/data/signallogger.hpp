@@ -0,0 +1,156 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_SIGNALLOGGER_HPP
+#define DATA_SIGNALLOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+
+#include "src/data/csvformatter.hpp"
+#include "src/data/rotatingfile.hpp"
+
+using std::atomic;
+using std::condition_variable;
+using std::mutex;
+using std::shared_ptr;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace sv {
+namespace data {
+
+class AnalogTimeSignal;
+
+enum class LogFormat
+{
+	Csv,
+	Binary
+};
+
+/**
+ * Continuously appends the new samples of AnalogTimeSignals to log files.
+ *
+ * A writer thread wakes up every `WriteInterval`, reads the samples that
+ * were appended since its last run and merges them by timestamp (see
+ * SampleMerger). So the acquisition and the GUI threads never wait for the
+ * disk. The files are rotated by size and/or time and synced to the disk in
+ * the given interval (see RotatingFile). Only samples, that are pushed after
+ * the logger has been started, are logged.
+ *
+ * Both formats have one record per sample:
+ *
+ * - CSV: A "Time,Signal,Value" header line and the lines
+ *   `<timestamp>,"<signal>",<value>`, the timestamp in seconds since epoch.
+ *   The values are written with 17 significant digits, so they are exact.
+ * - Binary: The header is the 8 byte magic "SMUVLOG\x01", the uint32 byte
+ *   order mark 0x01020304, the uint32 number of signals and for every signal
+ *   the uint32 length and the UTF-8 name. The records are 24 bytes:
+ *   float64 timestamp (seconds since epoch), float64 value, uint32 signal
+ *   index and 4 bytes padding. All numbers are in the byte order of the
+ *   writing machine.
+ *
+ * Errors are reported by `error_occurred()`, which is emitted in the writer
+ * thread. The logger stops writing after an error.
+ *
+ * stop() doesn't wait for the writer thread, so the caller never blocks on
+ * the final write, flush and sync. `finished()` is emitted, when the file is
+ * closed. Only the destructor joins the thread.
+ */
+class SignalLogger : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @param base_name The path and the base name of the log files. The
+	 *                  start time, a counter and the extension are appended.
+	 * @param max_file_size Rotate the file at this size in bytes, 0 disables.
+	 * @param max_file_duration Rotate the file after this time span in
+	 *                          seconds, 0 disables.
+	 * @param sync_interval The interval in seconds to sync to the disk.
+	 */
+	SignalLogger(const vector<shared_ptr<AnalogTimeSignal>> &signals,
+		const string &base_name, LogFormat format, uint64_t max_file_size,
+		double max_file_duration, double sync_interval);
+	/** Stop the logger and wait for the writer thread. */
+	~SignalLogger();
+
+	void start();
+	/**
+	 * Request the writer thread to write the remaining samples and to close
+	 * the file. The thread isn't joined, see `finished()`.
+	 */
+	void stop();
+
+	static const std::chrono::milliseconds WriteInterval;
+
+private:
+	void write_proc();
+	void write_new_samples();
+	void append_record(size_t signal_index, double timestamp, double value);
+	bool write_buffer(double now);
+	string signal_label(size_t signal_index) const;
+	string csv_header() const;
+	string binary_header() const;
+
+	const vector<shared_ptr<AnalogTimeSignal>> signals_;
+	const LogFormat format_;
+	RotatingFile file_;
+
+	/** Incremented, when a signal is cleared. */
+	unique_ptr<atomic<size_t>[]> clear_counts_;
+	/** The following members are only used by the writer thread. */
+	vector<size_t> seen_clear_counts_;
+	vector<size_t> positions_;
+	/** The quoted signal labels for the CSV lines. */
+	vector<string> csv_labels_;
+	CsvFormatter csv_formatter_;
+	vector<char> binary_buffer_;
+	bool failed_;
+
+	std::thread writer_thread_;
+	mutable mutex mutex_;
+	condition_variable abort_condition_;
+	bool abort_;
+
+	static const size_t FlushSize;
+
+Q_SIGNALS:
+	void error_occurred(const QString &error);
+	/** The file is closed and the writer thread has finished. */
+	void finished();
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_SIGNALLOGGER_HPP
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "timealigner.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+TimeAligner::TimeAligner() :
+	has_last_first_(false),
+	last_first_timestamp_(0.),
+	last_first_value_(0.),
+	has_last_second_(false),
+	last_second_timestamp_(0.),
+	last_second_value_(0.)
+{
+}
+
+void TimeAligner::clear()
+{
+	first_timestamps_.clear();
+	first_values_.clear();
+	second_timestamps_.clear();
+	second_values_.clear();
+	has_last_first_ = false;
+	has_last_second_ = false;
+}
+
+void TimeAligner::add_first(const vector<double> &timestamps,
+	const vector<double> &values)
+{
+	first_timestamps_.insert(first_timestamps_.end(),
+		timestamps.begin(), timestamps.end());
+	first_values_.insert(first_values_.end(), values.begin(), values.end());
+}
+
+void TimeAligner::add_second(const vector<double> &timestamps,
+	const vector<double> &values)
+{
+	second_timestamps_.insert(second_timestamps_.end(),
+		timestamps.begin(), timestamps.end());
+	second_values_.insert(second_values_.end(), values.begin(), values.end());
+}
+
+void TimeAligner::combine(vector<double> &timestamps,
+	vector<double> &first_values, vector<double> &second_values)
+{
+	size_t first_i = 0;
+	size_t second_i = 0;
+	while (first_i < first_timestamps_.size() &&
+			second_i < second_timestamps_.size()) {
+		const double first_ts = first_timestamps_[first_i];
+		const double first_value = first_values_[first_i];
+		const double second_ts = second_timestamps_[second_i];
+		const double second_value = second_values_[second_i];
+
+		if (first_ts == second_ts) {
+			timestamps.push_back(first_ts);
+			first_values.push_back(first_value);
+			second_values.push_back(second_value);
+			has_last_first_ = true;
+			last_first_timestamp_ = first_ts;
+			last_first_value_ = first_value;
+			has_last_second_ = true;
+			last_second_timestamp_ = second_ts;
+			last_second_value_ = second_value;
+			++first_i;
+			++second_i;
+		}
+		else if (first_ts < second_ts) {
+			if (has_last_second_) {
+				timestamps.push_back(first_ts);
+				first_values.push_back(first_value);
+				second_values.push_back(last_second_value_ +
+					(second_value - last_second_value_) *
+					(first_ts - last_second_timestamp_) /
+					(second_ts - last_second_timestamp_));
+			}
+			has_last_first_ = true;
+			last_first_timestamp_ = first_ts;
+			last_first_value_ = first_value;
+			++first_i;
+		}
+		else {
+			if (has_last_first_) {
+				timestamps.push_back(second_ts);
+				first_values.push_back(last_first_value_ +
+					(first_value - last_first_value_) *
+					(second_ts - last_first_timestamp_) /
+					(first_ts - last_first_timestamp_));
+				second_values.push_back(second_value);
+			}
+			has_last_second_ = true;
+			last_second_timestamp_ = second_ts;
+			last_second_value_ = second_value;
+			++second_i;
+		}
+	}
+
+	first_timestamps_.erase(first_timestamps_.begin(),
+		first_timestamps_.begin() + first_i);
+	first_values_.erase(first_values_.begin(), first_values_.begin() + first_i);
+	second_timestamps_.erase(second_timestamps_.begin(),
+		second_timestamps_.begin() + second_i);
+	second_values_.erase(second_values_.begin(),
+		second_values_.begin() + second_i);
+}
+
+} // namespace data
+} // namespace sv
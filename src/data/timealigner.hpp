@@ -0,0 +1,82 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_TIMEALIGNER_HPP
+#define DATA_TIMEALIGNER_HPP
+
+#include <vector>
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Incrementally combines the samples of two time signals into time aligned
+ * pairs.
+ *
+ * The result is the same as AnalogTimeSignal::combine_signals(): Each sample
+ * of one signal is combined with the value of the other signal, linearly
+ * interpolated between the last and the next sample. Samples with the same
+ * timestamp are combined directly, samples before the first sample of the
+ * other signal are ignored.
+ *
+ * The new samples of the signals can be added in chunks of any size. A
+ * sample is only combined, when the next sample of the other signal is
+ * known, so it stays pending until then.
+ */
+class TimeAligner
+{
+
+public:
+	TimeAligner();
+
+	void clear();
+
+	void add_first(const vector<double> &timestamps,
+		const vector<double> &values);
+	void add_second(const vector<double> &timestamps,
+		const vector<double> &values);
+
+	/**
+	 * Combine the pending samples and append the pairs to `timestamps`,
+	 * `first_values` and `second_values`.
+	 */
+	void combine(vector<double> &timestamps,
+		vector<double> &first_values, vector<double> &second_values);
+
+private:
+	vector<double> first_timestamps_;
+	vector<double> first_values_;
+	vector<double> second_timestamps_;
+	vector<double> second_values_;
+	/** The last combined sample of each signal, for the interpolation. */
+	bool has_last_first_;
+	double last_first_timestamp_;
+	double last_first_value_;
+	bool has_last_second_;
+	double last_second_timestamp_;
+	double last_second_value_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_TIMEALIGNER_HPP
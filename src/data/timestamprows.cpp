@@ -0,0 +1,120 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "timestamprows.hpp"
+#include "src/data/chunkedbuffer.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+TimestampRows::TimestampRows() :
+	horizon_(0.),
+	has_horizon_(false),
+	first_moved_row_(std::numeric_limits<size_t>::max())
+{
+}
+
+void TimestampRows::clear()
+{
+	final_rows_.clear();
+	tail_rows_.clear();
+	has_horizon_ = false;
+	reset_moved_rows();
+}
+
+bool TimestampRows::add(double timestamp)
+{
+	const size_t final_size = final_rows_.size();
+	if (final_size > 0 && timestamp <= final_rows_.at(final_size - 1))
+		return contains_final(timestamp);
+
+	// All tail rows are newer than the horizon, so the timestamp can become
+	// a final row directly.
+	if (has_horizon_ && timestamp <= horizon_) {
+		if (!tail_rows_.empty())
+			set_moved_row(final_size);
+		final_rows_.push_back(timestamp);
+		return true;
+	}
+
+	auto it = std::lower_bound(
+		tail_rows_.begin(), tail_rows_.end(), timestamp);
+	if (it != tail_rows_.end() && *it == timestamp)
+		return true;
+	if (it != tail_rows_.end())
+		set_moved_row(final_size + (size_t)(it - tail_rows_.begin()));
+	tail_rows_.insert(it, timestamp);
+	return true;
+}
+
+void TimestampRows::set_horizon(double horizon)
+{
+	if (has_horizon_ && horizon <= horizon_)
+		return;
+	horizon_ = horizon;
+	has_horizon_ = true;
+
+	auto end = std::upper_bound(tail_rows_.begin(), tail_rows_.end(), horizon);
+	for (auto it = tail_rows_.begin(); it != end; ++it)
+		final_rows_.push_back(*it);
+	tail_rows_.erase(tail_rows_.begin(), end);
+}
+
+size_t TimestampRows::size() const
+{
+	return final_rows_.size() + tail_rows_.size();
+}
+
+size_t TimestampRows::first_moved_row() const
+{
+	return std::min(first_moved_row_, size());
+}
+
+void TimestampRows::reset_moved_rows()
+{
+	first_moved_row_ = std::numeric_limits<size_t>::max();
+}
+
+bool TimestampRows::contains_final(double timestamp) const
+{
+	size_t first = 0;
+	size_t last = final_rows_.size();
+	while (first < last) {
+		const size_t middle = first + (last - first) / 2;
+		if (final_rows_.at(middle) < timestamp)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+	return first < final_rows_.size() && final_rows_.at(first) == timestamp;
+}
+
+void TimestampRows::set_moved_row(size_t row)
+{
+	first_moved_row_ = std::min(first_moved_row_, row);
+}
+
+} // namespace data
+} // namespace sv
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATA_TIMESTAMPROWS_HPP
+#define DATA_TIMESTAMPROWS_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "src/data/chunkedbuffer.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace data {
+
+/**
+ * Sorted set of the distinct timestamps of several signals, one row per
+ * timestamp, e.g. for the rows of a table that shows the signals side by
+ * side.
+ *
+ * The signals don't arrive in lockstep, so a new timestamp of one signal may
+ * belong before timestamps of other signals, that are already rows. Rows up
+ * to the horizon (the oldest last timestamp of all signals) are final and
+ * stored in a ChunkedBuffer, so they are never moved. Newer rows are kept in
+ * a small sorted tail, where rows can still be inserted.
+ */
+class TimestampRows
+{
+
+public:
+	TimestampRows();
+
+	void clear();
+
+	/**
+	 * Add a timestamp, that isn't a row yet. Timestamps should be added in
+	 * ascending order. Returns false when the timestamp is older than the
+	 * final rows and isn't a row already, then the rows must be rebuilt.
+	 */
+	bool add(double timestamp);
+
+	/**
+	 * No timestamps up to `horizon` will be added anymore (except for
+	 * rebuilds), so the rows up to `horizon` are final.
+	 */
+	void set_horizon(double horizon);
+
+	size_t size() const;
+	double at(size_t row) const
+	{
+		if (row < final_rows_.size())
+			return final_rows_.at(row);
+		return tail_rows_[row - final_rows_.size()];
+	}
+
+	/**
+	 * Return the first row, that was moved by an inserted row since the
+	 * last call of reset_moved_rows(), or size() if no row was moved.
+	 */
+	size_t first_moved_row() const;
+	void reset_moved_rows();
+
+private:
+	bool contains_final(double timestamp) const;
+	void set_moved_row(size_t row);
+
+	ChunkedBuffer final_rows_;
+	vector<double> tail_rows_;
+	double horizon_;
+	bool has_horizon_;
+	size_t first_moved_row_;
+
+};
+
+} // namespace data
+} // namespace sv
+
+#endif // DATA_TIMESTAMPROWS_HPP
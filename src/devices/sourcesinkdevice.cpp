@@ -290,6 +290,7 @@ void SourceSinkDevice::init_channels()
 					set<data::QuantityFlag>(),
 					data::Unit::WattHour,
 					power_signal,
+					channels::IntegrationMethod::Trapezoidal,
 					shared_from_this(),
 					chg_names, "Wh" + ch_suffix,
 					aquisition_start_timestamp_);
@@ -304,6 +305,7 @@ void SourceSinkDevice::init_channels()
 					set<data::QuantityFlag>(),
 					data::Unit::AmpereHour,
 					current_signal,
+					channels::IntegrationMethod::Trapezoidal,
 					shared_from_this(),
 					chg_names, "Ah" + ch_suffix,
 					aquisition_start_timestamp_);
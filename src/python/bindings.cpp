@@ -21,6 +21,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 #include <pybind11/embed.h>
 #include <pybind11/stl.h>
 
@@ -35,6 +36,7 @@
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/samplemerger.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/configurable.hpp"
 #include "src/devices/deviceutil.hpp"
@@ -378,6 +380,51 @@ void init_Signal(py::module &module)
 		"    The total number of digits.\n"
 		"decimal_places : int\n"
 		"    The number of decimal places.");
+
+	module.def("get_merged_samples",
+		[](const std::vector<std::shared_ptr<sv::data::AnalogTimeSignal>> &signals,
+				double timeframe, bool relative_time) {
+			std::vector<size_t> sample_counts;
+			for (const auto &signal : signals)
+				sample_counts.push_back(signal->sample_count());
+
+			sv::data::SampleMerger merger(sample_counts,
+				[&signals, relative_time](size_t source, size_t pos, size_t end,
+						std::vector<double> &timestamps, std::vector<double> &values) {
+					signals[source]->get_samples(pos, end, timestamps, values,
+						relative_time);
+				},
+				timeframe);
+
+			py::list rows;
+			while (merger.next()) {
+				py::list values;
+				for (size_t i=0; i<merger.source_count(); ++i) {
+					if (merger.has_value(i))
+						values.append(merger.value(i));
+					else
+						values.append(py::none());
+				}
+				rows.append(py::make_tuple(merger.timestamp(), values));
+			}
+			return rows;
+		},
+		py::arg("signals"), py::arg("timeframe"), py::arg("relative_time"),
+		"Return the samples of multiple signals, merged into rows with a common timestamp.\n\n"
+		"The timestamp of a row is the smallest timestamp of the next samples. Every signal, whose "
+		"next sample is within `timeframe` of the row timestamp, has a value in this row.\n\n"
+		"Parameters\n"
+		"----------\n"
+		"signals : List[AnalogTimeSignal]\n"
+		"    The signals to merge.\n"
+		"timeframe : float\n"
+		"    The time span in seconds, in which samples are combined into one row.\n"
+		"relative_time : bool\n"
+		"    When `True`, the returned timestamps are relative to the start of the SmuView session.\n\n"
+		"Returns\n"
+		"-------\n"
+		"List[Tuple[float, List[Optional[float]]]]\n"
+		"    The rows with 1. the timestamp and 2. the values of the signals (`None` if a signal has no value in this row).");
 }
 
 void init_Configurable(py::module &module)
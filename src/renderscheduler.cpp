@@ -0,0 +1,198 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <QWidget>
+
+#include "renderscheduler.hpp"
+
+namespace sv {
+
+const int RenderScheduler::TickInterval = 50;
+const int RenderScheduler::MaxInterval = 2000;
+const double RenderScheduler::CpuBudget = 0.5;
+
+RenderScheduler::RenderScheduler(QObject *parent) :
+	QObject(parent),
+	in_tick_(false)
+{
+	timer_.setTimerType(Qt::PreciseTimer);
+	connect(&timer_, &QTimer::timeout, this, &RenderScheduler::on_tick);
+	clock_.start();
+}
+
+void RenderScheduler::add_client(QWidget *widget, int min_interval,
+	UpdateFunction update)
+{
+	assert(widget);
+
+	if (min_interval < TickInterval)
+		min_interval = TickInterval;
+
+	for (auto &client : clients_) {
+		if (client.widget == widget) {
+			client.update = update;
+			client.min_interval = min_interval;
+			client.interval = std::max(client.interval, min_interval);
+			return;
+		}
+	}
+
+	Client client;
+	client.widget = widget;
+	client.update = update;
+	client.min_interval = min_interval;
+	client.interval = min_interval;
+	client.next_time = clock_.elapsed() + min_interval;
+	client.update_time = 0.;
+	client.stale = false;
+	clients_.push_back(client);
+
+	if (!timer_.isActive())
+		timer_.start(TickInterval);
+}
+
+void RenderScheduler::remove_client(QWidget *widget)
+{
+	for (auto it = clients_.begin(); it != clients_.end(); ++it) {
+		if (it->widget != widget)
+			continue;
+		// Don't invalidate the iteration in on_tick(), the client is erased
+		// at the end of the tick.
+		if (in_tick_)
+			it->widget = nullptr;
+		else
+			clients_.erase(it);
+		break;
+	}
+
+	if (clients_.empty())
+		timer_.stop();
+}
+
+bool RenderScheduler::has_client(QWidget *widget) const
+{
+	for (const auto &client : clients_) {
+		if (client.widget == widget)
+			return true;
+	}
+	return false;
+}
+
+int RenderScheduler::interval(QWidget *widget) const
+{
+	for (const auto &client : clients_) {
+		if (client.widget == widget)
+			return client.interval;
+	}
+	return -1;
+}
+
+bool RenderScheduler::is_visible(const QWidget *widget)
+{
+	if (!widget->isVisible())
+		return false;
+	if (widget->window()->isMinimized())
+		return false;
+	// Covered by other widgets or scrolled out of a scroll area
+	return !widget->visibleRegion().isEmpty();
+}
+
+void RenderScheduler::update_client(Client &client, qint64 now, bool catch_up)
+{
+	// Copy the function, the client may be changed by the update function.
+	UpdateFunction update = client.update;
+	QWidget *widget = client.widget;
+	client.stale = false;
+	client.next_time = now + client.interval;
+
+	QElapsedTimer update_timer;
+	update_timer.start();
+	update(catch_up);
+	double update_time = (double)update_timer.nsecsElapsed() / 1000000.;
+
+	// The reference is not valid anymore, when a client was added.
+	for (auto &c : clients_) {
+		if (c.widget != widget)
+			continue;
+		if (c.update_time <= 0.)
+			c.update_time = update_time;
+		else
+			c.update_time = 0.8 * c.update_time + 0.2 * update_time;
+		break;
+	}
+}
+
+void RenderScheduler::adapt_intervals()
+{
+	size_t visible_count = 0;
+	for (const auto &client : clients_) {
+		if (client.widget && !client.stale)
+			++visible_count;
+	}
+	if (visible_count == 0)
+		return;
+
+	// Every visible client gets the same share of the budget.
+	const double share = CpuBudget / (double)visible_count;
+	for (auto &client : clients_) {
+		double interval = std::ceil(client.update_time / share);
+		client.interval = std::max(client.min_interval,
+			std::min((int)interval, MaxInterval));
+	}
+}
+
+void RenderScheduler::on_tick()
+{
+	in_tick_ = true;
+
+	// The clients vector may grow in an update function, so iterate by index.
+	for (size_t i=0; i<clients_.size(); ++i) {
+		if (!clients_[i].widget)
+			continue;
+
+		qint64 now = clock_.elapsed();
+		if (!is_visible(clients_[i].widget)) {
+			clients_[i].stale = true;
+			continue;
+		}
+		if (clients_[i].stale) {
+			update_client(clients_[i], now, true);
+			continue;
+		}
+		if (now >= clients_[i].next_time)
+			update_client(clients_[i], now, false);
+	}
+
+	in_tick_ = false;
+
+	// Erase removed and deleted clients.
+	clients_.erase(std::remove_if(clients_.begin(), clients_.end(),
+			[](const Client &client) { return !client.widget; }),
+		clients_.end());
+	if (clients_.empty())
+		timer_.stop();
+
+	adapt_intervals();
+}
+
+} // namespace sv
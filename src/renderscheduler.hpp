@@ -0,0 +1,109 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RENDERSCHEDULER_HPP
+#define RENDERSCHEDULER_HPP
+
+#include <functional>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QWidget>
+
+using std::function;
+using std::vector;
+
+namespace sv {
+
+/**
+ * One clock for the periodic updates of all views.
+ *
+ * Every client is a widget with an update function and a minimum update
+ * interval. On each tick, the clients that are due are updated. Clients whose
+ * widget isn't visible (hidden tab, closed dock, minimized window) are
+ * skipped and marked as stale. When a stale widget becomes visible again, it
+ * is updated once with `catch_up` set, so e.g. a plot can do a single full
+ * replot instead of painting the whole backlog incrementally.
+ *
+ * The duration of each update is measured. The interval of a client is
+ * stretched, so that all visible clients together don't use more than
+ * `CpuBudget` of the GUI thread's time.
+ */
+class RenderScheduler : public QObject
+{
+	Q_OBJECT
+
+public:
+	/** The update function. `catch_up` is set after a period of invisibility. */
+	typedef function<void(bool catch_up)> UpdateFunction;
+
+	/** Interval of the scheduler clock in ms. */
+	static const int TickInterval;
+	/** Upper limit for the adapted interval of a client in ms. */
+	static const int MaxInterval;
+	/** Fraction of the GUI thread time, that may be used for updates. */
+	static const double CpuBudget;
+
+public:
+	explicit RenderScheduler(QObject *parent = nullptr);
+
+	/**
+	 * Add a client. When `widget` is already a client, only the update
+	 * function and the interval are replaced.
+	 */
+	void add_client(QWidget *widget, int min_interval, UpdateFunction update);
+	void remove_client(QWidget *widget);
+	bool has_client(QWidget *widget) const;
+
+	/** Return the current (adapted) update interval of a client in ms. */
+	int interval(QWidget *widget) const;
+
+private:
+	struct Client
+	{
+		QPointer<QWidget> widget;
+		UpdateFunction update;
+		int min_interval;
+		int interval;
+		qint64 next_time;
+		/** Smoothed duration of the update function in ms. */
+		double update_time;
+		bool stale;
+	};
+
+	static bool is_visible(const QWidget *widget);
+	void update_client(Client &client, qint64 now, bool catch_up);
+	void adapt_intervals();
+
+	vector<Client> clients_;
+	QTimer timer_;
+	QElapsedTimer clock_;
+	bool in_tick_;
+
+private Q_SLOTS:
+	void on_tick();
+
+};
+
+} // namespace sv
+
+#endif // RENDERSCHEDULER_HPP
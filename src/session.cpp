@@ -30,6 +30,7 @@
 #include "session.hpp"
 #include "config.h"
 #include "src/devicemanager.hpp"
+#include "src/renderscheduler.hpp"
 #include "src/util.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/hardwaredevice.hpp"
@@ -54,7 +55,8 @@ shared_ptr<sigrok::Context> Session::sr_context;
 double Session::session_start_timestamp = .0;
 
 Session::Session(DeviceManager &device_manager) :
-	device_manager_(device_manager)
+	device_manager_(device_manager),
+	render_scheduler_(new RenderScheduler(this))
 {
 	smu_script_runner_ = make_shared<python::SmuScriptRunner>(*this);
 	connect(smu_script_runner_.get(), &python::SmuScriptRunner::script_error,
@@ -173,6 +175,11 @@ MainWindow *Session::main_window() const
 	return main_window_;
 }
 
+RenderScheduler *Session::render_scheduler() const
+{
+	return render_scheduler_;
+}
+
 void Session::error_handler(const std::string &sender, const std::string &msg)
 {
 	qCritical() << QString::fromStdString(sender) <<
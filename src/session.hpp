@@ -41,6 +41,7 @@ namespace sv {
 
 class DeviceManager;
 class MainWindow;
+class RenderScheduler;
 
 namespace devices {
 class BaseDevice;
@@ -81,11 +82,15 @@ public:
 	void set_main_window(MainWindow *main_window);
 	MainWindow *main_window() const;
 
+	/** Return the scheduler, that drives the periodic updates of all views. */
+	RenderScheduler *render_scheduler() const;
+
 private:
 	DeviceManager &device_manager_;
 	map<string, shared_ptr<devices::BaseDevice>> device_map_;
 	MainWindow *main_window_;
 	shared_ptr<python::SmuScriptRunner> smu_script_runner_;
+	RenderScheduler *render_scheduler_;
 
 	void free_unused_memory();
 
@@ -17,12 +17,16 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <QDebug>
+#include <QModelIndex>
 #include <QStandardItem>
 #include <QStandardItemModel>
 #include <QString>
@@ -31,15 +35,19 @@
 #include "devicetreemodel.hpp"
 #include "src/session.hpp"
 #include "src/data/properties/baseproperty.hpp"
+#include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/configurable.hpp"
 #include "src/channels/basechannel.hpp"
 #include "src/ui/devices/devicetree/treeitem.hpp"
 
+using std::dynamic_pointer_cast;
+using std::make_pair;
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::vector;
 
 Q_DECLARE_SMART_POINTER_METATYPE(std::shared_ptr)
 
@@ -82,33 +90,43 @@ void DeviceTreeModel::setup_model()
 		shared_ptr<sv::devices::BaseDevice> device = device_pair.second;
 		add_device(device);
 	}
+}
 
-	invisibleRootItem()->sortChildren(0);
+void DeviceTreeModel::insert_item(QStandardItem *parent_item, TreeItem *item)
+{
+	// Binary search for the position after all items that are not greater
+	// than the new item (upper bound), the siblings are always sorted.
+	int first = 0;
+	int count = parent_item->rowCount();
+	while (count > 0) {
+		int step = count / 2;
+		int mid = first + step;
+		if (!(*item < *parent_item->child(mid))) {
+			first = mid + 1;
+			count -= step + 1;
+		}
+		else {
+			count = step;
+		}
+	}
+	parent_item->insertRow(first, item);
 }
 
 void DeviceTreeModel::add_device(shared_ptr<sv::devices::BaseDevice> device)
 {
 	std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-	/*
-	this->setFirstItemColumnSpanned(device_item, true);
-	*/
-
 	// Look for existing device
 	TreeItem *device_item = find_device(device);
-	if (!device_item) {
-		beginInsertRows(invisibleRootItem()->index(),
-			invisibleRootItem()->rowCount(), invisibleRootItem()->rowCount()+1);
+	const bool is_new_item = !device_item;
+	if (is_new_item) {
 		device_item = new TreeItem(TreeItemType::DeviceItem);
-		device_item->setText(device->full_name());
+		device_item->set_item_text(device->full_name());
 		device_item->setData(QVariant::fromValue(device), DeviceTreeModel::DataRole);
-		device_item->setData(device->full_name(), DeviceTreeModel::SortRole);
+		device_item->set_sort_key(device->full_name());
 		device_item->setCheckable(is_device_checkable_);
 		device_item->setEditable(false);
-		invisibleRootItem()->appendRow(device_item);
-		endInsertRows();
-
-		invisibleRootItem()->sortChildren(0);
+		device_items_[device.get()] = device_item;
 
 		connect(device.get(), &sv::devices::BaseDevice::channel_added,
 			this, &DeviceTreeModel::on_channel_added);
@@ -124,6 +142,10 @@ void DeviceTreeModel::add_device(shared_ptr<sv::devices::BaseDevice> device)
 	for (const auto &configurable_pair : device->configurable_map()) {
 		add_configurable(configurable_pair.second, device_item);
 	}
+
+	// The new device is inserted with all children at once.
+	if (is_new_item)
+		insert_item(invisibleRootItem(), device_item);
 }
 
 TreeItem *DeviceTreeModel::add_channel_group(const string &channel_group_name,
@@ -140,18 +162,14 @@ TreeItem *DeviceTreeModel::add_channel_group(const string &channel_group_name,
 	std::lock_guard<std::recursive_mutex> lock(mutex_);
 
 	QString chg_name_qstr = QString::fromStdString(channel_group_name);
-	beginInsertRows(device_item->index(),
-		device_item->rowCount(), device_item->rowCount()+1);
 	chg_item = new TreeItem(TreeItemType::ChannelGroupItem);
-	chg_item->setText(chg_name_qstr);
+	chg_item->set_item_text(chg_name_qstr);
 	chg_item->setData(chg_name_qstr, DeviceTreeModel::DataRole);
-	chg_item->setData(chg_name_qstr, DeviceTreeModel::SortRole);
+	chg_item->set_sort_key(chg_name_qstr);
 	chg_item->setCheckable(is_channel_group_checkable_);
 	chg_item->setEditable(false);
-	device_item->appendRow(chg_item);
-	endInsertRows();
-
-	device_item->sortChildren(0);
+	channel_group_items_[make_pair(device_item, channel_group_name)] = chg_item;
+	insert_item(device_item, chg_item);
 
 	return chg_item;
 }
@@ -161,9 +179,17 @@ void DeviceTreeModel::add_channel(shared_ptr<channels::BaseChannel> channel,
 {
 	std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-	// Find existing channel in all channel groups
-	// NOLINTNEXTLINE(readability-implicit-bool-conversion)
-	if (!find_channel(channel, channel->channel_group_names(), parent_item)) {
+	// Connect the channel only once, regardless of its channel groups
+	bool is_new_channel = true;
+	for (const auto &chg_name : channel->channel_group_names()) {
+		QStandardItem *chg_item = chg_name.empty() ?
+			parent_item : find_channel_group(chg_name, parent_item);
+		if (chg_item && find_child(chg_item, channel.get())) {
+			is_new_channel = false;
+			break;
+		}
+	}
+	if (is_new_channel) {
 		connect(channel.get(), &channels::BaseChannel::signal_added,
 			this, &DeviceTreeModel::on_signal_added);
 	}
@@ -172,21 +198,16 @@ void DeviceTreeModel::add_channel(shared_ptr<channels::BaseChannel> channel,
 		TreeItem *new_parent_item = add_channel_group(chg_name, parent_item);
 
 		// Look for existing channel
-		set<string> chg_names { chg_name };
-		TreeItem *channel_item = find_channel(channel, chg_names, parent_item);
-		if (!channel_item) {
-			beginInsertRows(new_parent_item->index(),
-				new_parent_item->rowCount(), new_parent_item->rowCount()+1);
+		TreeItem *channel_item = find_child(new_parent_item, channel.get());
+		const bool is_new_item = !channel_item;
+		if (is_new_item) {
 			channel_item = new TreeItem(TreeItemType::ChannelItem);
-			channel_item->setText(QString::fromStdString(channel->name()));
+			channel_item->set_item_text(QString::fromStdString(channel->name()));
 			channel_item->setData(QVariant::fromValue(channel), DeviceTreeModel::DataRole);
-			channel_item->setData(channel->index(), DeviceTreeModel::SortRole);
+			channel_item->set_sort_key((int)channel->index());
 			channel_item->setCheckable(is_channel_checkable_);
 			channel_item->setEditable(false);
-			new_parent_item->appendRow(channel_item);
-			endInsertRows();
-
-			new_parent_item->sortChildren(0);
+			child_items_[make_pair(new_parent_item, channel.get())] = channel_item;
 		}
 
 		// Signals
@@ -195,30 +216,34 @@ void DeviceTreeModel::add_channel(shared_ptr<channels::BaseChannel> channel,
 				add_signal(signal, channel_item);
 			}
 		}
+
+		// The new channel is inserted with all signals at once.
+		if (is_new_item)
+			insert_item(new_parent_item, channel_item);
 	}
 }
 
 void DeviceTreeModel::add_signal(shared_ptr<sv::data::BaseSignal> signal,
 	TreeItem *parent_item)
 {
+	// The views can only display time signals for now
+	if (!dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal))
+		return;
+
 	std::lock_guard<std::recursive_mutex> lock(mutex_);
 
 	// Look for existing signal
-	TreeItem *signal_item = find_signal(signal, parent_item);
-	if (!signal_item) {
-		beginInsertRows(parent_item->index(),
-			parent_item->rowCount(), parent_item->rowCount()+1);
-		signal_item = new TreeItem(TreeItemType::SignalItem);
-		signal_item->setText(signal->display_name());
-		signal_item->setData(QVariant::fromValue(signal), DeviceTreeModel::DataRole);
-		signal_item->setData(signal->display_name(), DeviceTreeModel::SortRole); // TODO: signal->index()
-		signal_item->setCheckable(is_signal_checkable_);
-		signal_item->setEditable(false);
-		parent_item->appendRow(signal_item);
-		endInsertRows();
-
-		parent_item->sortChildren(0);
-	}
+	if (find_child(parent_item, signal.get()))
+		return;
+
+	TreeItem *signal_item = new TreeItem(TreeItemType::SignalItem);
+	signal_item->set_item_text(signal->display_name());
+	signal_item->setData(QVariant::fromValue(signal), DeviceTreeModel::DataRole);
+	signal_item->set_sort_key(signal->display_name()); // TODO: signal->index()
+	signal_item->setCheckable(is_signal_checkable_);
+	signal_item->setEditable(false);
+	child_items_[make_pair(parent_item, signal.get())] = signal_item;
+	insert_item(parent_item, signal_item);
 }
 
 void DeviceTreeModel::add_configurable(
@@ -235,21 +260,23 @@ void DeviceTreeModel::add_configurable(
 		TreeItem *new_parent_item = add_channel_group(
 			configurable->name(), device_item);
 
-		// Add configurable item
-		beginInsertRows(new_parent_item->index(),
-			new_parent_item->rowCount(), new_parent_item->rowCount()+1);
+		// Add configurable item, the properties are added when the item is
+		// expanded (see fetchMore()).
 		conf_item = new TreeItem(TreeItemType::ConfigurableItem);
-		conf_item->setText(configurable->display_name());
+		conf_item->set_item_text(configurable->display_name());
 		conf_item->setData(QVariant::fromValue(configurable), DeviceTreeModel::DataRole);
-		conf_item->setData(configurable->index(), DeviceTreeModel::SortRole);
+		conf_item->set_sort_key((int)configurable->index());
 		conf_item->setCheckable(false);
 		conf_item->setEditable(false);
-		new_parent_item->appendRow(conf_item);
-		endInsertRows();
-
-		new_parent_item->sortChildren(0);
+		child_items_[make_pair(new_parent_item, configurable.get())] = conf_item;
+		unpopulated_items_.insert(conf_item);
+		insert_item(new_parent_item, conf_item);
+		return;
 	}
 
+	if (unpopulated_items_.count(conf_item) > 0)
+		return;
+
 	// ConfigKeys
 	for (const auto &property_pair : configurable->property_map()) {
 		add_property(property_pair.second, conf_item);
@@ -266,135 +293,142 @@ void DeviceTreeModel::add_property(
 	std::lock_guard<std::recursive_mutex> lock(mutex_);
 
 	// Look for existing property
-	TreeItem *property_item = find_property(property, configurable_item);
-	if (!property_item) {
-		beginInsertRows(configurable_item->index(),
-			configurable_item->rowCount(), configurable_item->rowCount()+1);
-		property_item = new TreeItem(TreeItemType::PropertyItem);
-		property_item->setText(property->display_name());
-		property_item->setData(QVariant::fromValue(property), DeviceTreeModel::DataRole);
-		property_item->setData(property->display_name(), DeviceTreeModel::SortRole);
-		property_item->setCheckable(is_signal_checkable_);
-		property_item->setEditable(false);
-		configurable_item->appendRow(property_item);
-		endInsertRows();
-
-		configurable_item->sortChildren(0);
-	}
+	if (find_child(configurable_item, property.get()))
+		return;
+
+	TreeItem *property_item = new TreeItem(TreeItemType::PropertyItem);
+	property_item->set_item_text(property->display_name());
+	property_item->setData(QVariant::fromValue(property), DeviceTreeModel::DataRole);
+	property_item->set_sort_key(property->display_name());
+	property_item->setCheckable(is_signal_checkable_);
+	property_item->setEditable(false);
+	child_items_[make_pair(configurable_item, property.get())] = property_item;
+	insert_item(configurable_item, property_item);
 }
 
 TreeItem *DeviceTreeModel::find_device(
 	shared_ptr<sv::devices::BaseDevice> device) const
 {
-	for (int i=0; i<invisibleRootItem()->rowCount(); ++i) {
-		auto *child = invisibleRootItem()->child(i);
-		if (child->type() != (int)TreeItemType::DeviceItem)
-			continue;
-
-		if (device.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::devices::BaseDevice>>().get())
-			return static_cast<TreeItem *>(child);
-	}
-	return nullptr;
+	auto it = device_items_.find(device.get());
+	if (it == device_items_.end())
+		return nullptr;
+	return it->second;
 }
 
-TreeItem *DeviceTreeModel::find_channel_group(const string &channel_group_name,
-	TreeItem *parent_item) const
+vector<TreeItem *> DeviceTreeModel::items(TreeItemType type) const
 {
-	for (int i=0; i<parent_item->rowCount(); ++i) {
-		auto *child = parent_item->child(i);
-		if (child->type() != (int)TreeItemType::ChannelGroupItem)
-			continue;
-
-		QString chg_name_qstr = QString::fromStdString(channel_group_name);
-		if (chg_name_qstr == child->data(DeviceTreeModel::DataRole).toString())
-			return static_cast<TreeItem *>(child);
+	vector<TreeItem *> items;
+	if (type == TreeItemType::DeviceItem) {
+		for (const auto &item_pair : device_items_)
+			items.push_back(item_pair.second);
+	}
+	else if (type == TreeItemType::ChannelGroupItem) {
+		for (const auto &item_pair : channel_group_items_)
+			items.push_back(item_pair.second);
 	}
-	return nullptr;
+	else {
+		for (const auto &item_pair : child_items_) {
+			if (item_pair.second->type() == (int)type)
+				items.push_back(item_pair.second);
+		}
+	}
+	return items;
 }
 
-TreeItem *DeviceTreeModel::find_channel(
-	shared_ptr<sv::channels::BaseChannel> channel,
-	const set<string> &channel_group_names, TreeItem *parent_item) const
+TreeItem *DeviceTreeModel::find_channel_group(const string &channel_group_name,
+	QStandardItem *parent_item) const
 {
-	TreeItem *new_parent_item;
-	for (const auto &chg_name : channel_group_names) {
-		if (!chg_name.empty()) {
-			new_parent_item = find_channel_group(chg_name, parent_item);
-			if (!new_parent_item)
-				continue;
-		}
-		else
-			new_parent_item = parent_item;
-
-		for (int i=0; i<new_parent_item->rowCount(); ++i) {
-			auto *child = new_parent_item->child(i);
-			if (child->type() != (int)TreeItemType::ChannelItem)
-				continue;
-
-			if (channel.get() == child->data(DeviceTreeModel::DataRole).
-					value<shared_ptr<sv::channels::BaseChannel>>().get())
-				return static_cast<TreeItem *>(child);
-		}
-	}
-	return nullptr;
+	auto it = channel_group_items_.find(
+		make_pair(parent_item, channel_group_name));
+	if (it == channel_group_items_.end())
+		return nullptr;
+	return it->second;
 }
 
-TreeItem *DeviceTreeModel::find_signal (
-	shared_ptr<sv::data::BaseSignal> signal, TreeItem *parent_item) const
+TreeItem *DeviceTreeModel::find_child(QStandardItem *parent_item,
+	const void *object) const
 {
-	for (int i=0; i<parent_item->rowCount(); ++i) {
-		auto *child = parent_item->child(i);
-		if (child->type() != (int)TreeItemType::SignalItem)
-			continue;
-
-		if (signal.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::data::BaseSignal>>().get())
-			return static_cast<TreeItem *>(child);
-	}
-	return nullptr;
+	auto it = child_items_.find(make_pair(parent_item, object));
+	if (it == child_items_.end())
+		return nullptr;
+	return it->second;
 }
 
 TreeItem *DeviceTreeModel::find_configurable(
 	shared_ptr<sv::devices::Configurable> configurable,
 	TreeItem *device_item) const
 {
-	TreeItem *new_parent_item;
+	QStandardItem *parent_item = device_item;
 	if (!configurable->name().empty()) {
-		new_parent_item = find_channel_group(configurable->name(), device_item);
-		if (!new_parent_item)
+		parent_item = find_channel_group(configurable->name(), device_item);
+		if (!parent_item)
 			return nullptr;
 	}
-	else {
-		new_parent_item = device_item;
-	}
+	return find_child(parent_item, configurable.get());
+}
+
+void DeviceTreeModel::collect_items(QStandardItem *item,
+	set<const QStandardItem *> &items)
+{
+	items.insert(item);
+	for (int i=0; i<item->rowCount(); ++i)
+		collect_items(item->child(i), items);
+}
 
-	for (int i=0; i<new_parent_item->rowCount(); ++i) {
-		auto *child = new_parent_item->child(i);
-		if (child->type() != (int)TreeItemType::ConfigurableItem)
-			continue;
+void DeviceTreeModel::forget_items(QStandardItem *item)
+{
+	set<const QStandardItem *> items;
+	collect_items(item, items);
 
-		if (configurable.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::devices::Configurable>>().get())
-			return static_cast<TreeItem *>(child);
+	for (auto it = device_items_.begin(); it != device_items_.end(); ) {
+		if (items.count(it->second) > 0)
+			it = device_items_.erase(it);
+		else
+			++it;
 	}
-	return nullptr;
+	for (auto it = channel_group_items_.begin();
+			it != channel_group_items_.end(); ) {
+		if (items.count(it->first.first) > 0)
+			it = channel_group_items_.erase(it);
+		else
+			++it;
+	}
+	for (auto it = child_items_.begin(); it != child_items_.end(); ) {
+		if (items.count(it->first.first) > 0)
+			it = child_items_.erase(it);
+		else
+			++it;
+	}
+	for (const auto *removed_item : items)
+		unpopulated_items_.erase(removed_item);
 }
 
-TreeItem *DeviceTreeModel::find_property(
-	shared_ptr<sv::data::properties::BaseProperty> property,
-	TreeItem *configurable_item) const
+bool DeviceTreeModel::hasChildren(const QModelIndex &parent) const
+{
+	// Show the expand indicator for configurables without property items yet
+	if (parent.isValid() && unpopulated_items_.count(itemFromIndex(parent)) > 0)
+		return true;
+	return QStandardItemModel::hasChildren(parent);
+}
+
+bool DeviceTreeModel::canFetchMore(const QModelIndex &parent) const
 {
-	for (int i=0; i<configurable_item->rowCount(); ++i) {
-		auto *child = configurable_item->child(i);
-		if (child->type() != (int)TreeItemType::PropertyItem)
-			continue;
-
-		if (property.get() == child->data(DeviceTreeModel::DataRole).
-				value<shared_ptr<sv::data::properties::BaseProperty>>().get())
-			return static_cast<TreeItem *>(child);
+	return parent.isValid() && unpopulated_items_.count(itemFromIndex(parent)) > 0;
+}
+
+void DeviceTreeModel::fetchMore(const QModelIndex &parent)
+{
+	std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+	QStandardItem *item = itemFromIndex(parent);
+	if (!item || unpopulated_items_.erase(item) == 0)
+		return;
+
+	auto configurable = item->data(DeviceTreeModel::DataRole).
+		value<shared_ptr<sv::devices::Configurable>>();
+	for (const auto &property_pair : configurable->property_map()) {
+		add_property(property_pair.second, static_cast<TreeItem *>(item));
 	}
-	return nullptr;
 }
 
 void DeviceTreeModel::on_device_added(
@@ -410,6 +444,7 @@ void DeviceTreeModel::on_device_removed(
 
 	TreeItem *item = find_device(device);
 	if (item) {
+		forget_items(item);
 		removeRow(item->row(), invisibleRootItem()->index());
 	}
 }
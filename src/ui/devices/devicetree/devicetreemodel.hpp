@@ -20,15 +20,20 @@
 #ifndef UI_DEVICES_DEVICETREE_DEVICETREEMODEL_HPP
 #define UI_DEVICES_DEVICETREE_DEVICETREEMODEL_HPP
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <QModelIndex>
 #include <QStandardItem>
 #include <QStandardItemModel>
 
+using std::map;
+using std::pair;
 using std::set;
 using std::shared_ptr;
 using std::string;
@@ -57,7 +62,19 @@ namespace devices {
 namespace devicetree {
 
 class TreeItem;
+enum class TreeItemType;
 
+/**
+ * Tree model of all devices, channel groups, channels, signals and
+ * configurables of the session.
+ *
+ * The items are looked up by index maps and inserted at their sorted
+ * position, so adding an item doesn't scan or sort its siblings. New
+ * devices and channels are completely built before they are inserted into
+ * the model, so the views only get one notification for each of them. The
+ * properties of a configurable are only created, when the configurable item
+ * is expanded.
+ */
 class DeviceTreeModel : public QStandardItemModel
 {
 	Q_OBJECT
@@ -70,12 +87,23 @@ public:
 		bool show_configurable, QObject *parent = nullptr);
 
 	TreeItem *find_device(shared_ptr<sv::devices::BaseDevice> device) const;
+	/** Return all items of the given type. */
+	vector<TreeItem *> items(TreeItemType type) const;
+
+	bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+	bool canFetchMore(const QModelIndex &parent) const override;
+	void fetchMore(const QModelIndex &parent) override;
 
 	const static int DataRole = Qt::UserRole + 1;
 	const static int SortRole = Qt::UserRole + 2;
 
 private:
 	void setup_model();
+	/** Insert the item at its sorted position. */
+	void insert_item(QStandardItem *parent_item, TreeItem *item);
+	/** Remove the item and all its children from the index maps. */
+	void forget_items(QStandardItem *item);
+	void collect_items(QStandardItem *item, set<const QStandardItem *> &items);
 
 	void add_device(shared_ptr<sv::devices::BaseDevice> device);
 	TreeItem *add_channel_group(
@@ -90,17 +118,11 @@ private:
 		TreeItem *configurable_item);
 
 	TreeItem *find_channel_group(const string &channel_group_name,
-		TreeItem *parent_item) const;
-	TreeItem *find_channel(shared_ptr<sv::channels::BaseChannel> channel,
-		const set<string> &channel_group_names, TreeItem *parent_item) const;
-	TreeItem *find_signal(shared_ptr<sv::data::BaseSignal> signal,
-		TreeItem *parent_item) const;
+		QStandardItem *parent_item) const;
+	TreeItem *find_child(QStandardItem *parent_item, const void *object) const;
 	TreeItem *find_configurable(
 		shared_ptr<sv::devices::Configurable> configurable,
 		TreeItem *device_item) const;
-	TreeItem *find_property(
-		shared_ptr<sv::data::properties::BaseProperty> property,
-		TreeItem *configurable_item) const;
 
 	const Session &session_;
 	bool is_device_checkable_;
@@ -112,6 +134,16 @@ private:
 	bool show_configurable_;
 	std::recursive_mutex mutex_;
 
+	map<const sv::devices::BaseDevice *, TreeItem *> device_items_;
+	map<pair<const QStandardItem *, string>, TreeItem *> channel_group_items_;
+	/**
+	 * Channel, signal, configurable and property items by their parent item
+	 * and their object.
+	 */
+	map<pair<const QStandardItem *, const void *>, TreeItem *> child_items_;
+	/** Configurable items, whose property items are not yet created. */
+	set<const QStandardItem *> unpopulated_items_;
+
 private Q_SLOTS:
 	void on_device_added(shared_ptr<sv::devices::BaseDevice> device);
 	void on_device_removed(shared_ptr<sv::devices::BaseDevice> device);
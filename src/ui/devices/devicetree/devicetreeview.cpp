@@ -18,12 +18,14 @@
  */
 
 #include <memory>
+#include <set>
 
 #include <QDebug>
 #include <QItemSelectionModel>
 #include <QList>
 #include <QModelIndex>
 #include <QModelIndexList>
+#include <QString>
 #include <QTreeView>
 #include <QVariant>
 
@@ -35,6 +37,7 @@
 #include "src/ui/devices/devicetree/devicetreemodel.hpp"
 #include "src/ui/devices/devicetree/treeitem.hpp"
 
+using std::set;
 using std::shared_ptr;
 
 Q_DECLARE_SMART_POINTER_METATYPE(std::shared_ptr)
@@ -94,26 +97,15 @@ void DeviceTreeView::check_channels(
 	if (!is_channel_checkable_)
 		return;
 
-	const QList<QStandardItem *> all_items =
-		tree_model_->findItems("", Qt::MatchContains | Qt::MatchRecursive);
+	set<const sv::channels::BaseChannel *> channel_set;
+	for (const auto &channel : channels)
+		channel_set.insert(channel.get());
 
-	// First uncheck all channels
-	for (const auto &item : all_items) {
-		if (item->type() == (int)TreeItemType::ChannelItem) {
-			item->setCheckState(Qt::Unchecked);
-		}
-	}
-
-	// Now check all channels that are in the channels vector
-	for (const auto &item : all_items) {
-		if (item->type() == (int)TreeItemType::ChannelItem) {
-			auto item_data =
-				item->data().value<shared_ptr<sv::channels::BaseChannel>>();
-			for (const auto &channel :channels) {
-				if (item_data.get() == channel.get())
-					item->setCheckState(Qt::Checked);
-			}
-		}
+	for (const auto &item : tree_model_->items(TreeItemType::ChannelItem)) {
+		auto item_data = item->data(DeviceTreeModel::DataRole).
+			value<shared_ptr<sv::channels::BaseChannel>>();
+		item->setCheckState(channel_set.count(item_data.get()) > 0 ?
+			Qt::Checked : Qt::Unchecked);
 	}
 }
 
@@ -125,13 +117,10 @@ vector<shared_ptr<sv::channels::BaseChannel>>
 	if (!is_channel_checkable_)
 		return channels;
 
-	const QList<QStandardItem *> all_items =
-		tree_model_->findItems("", Qt::MatchContains | Qt::MatchRecursive);
-	for (const auto &item : all_items) {
-		if (item->checkState() > 0 &&
-				item->type() == (int)TreeItemType::ChannelItem) {
-			channels.push_back(
-				item->data().value<shared_ptr<sv::channels::BaseChannel>>());
+	for (const auto &item : tree_model_->items(TreeItemType::ChannelItem)) {
+		if (item->checkState() > 0) {
+			channels.push_back(item->data(DeviceTreeModel::DataRole).
+				value<shared_ptr<sv::channels::BaseChannel>>());
 		}
 	}
 	return channels;
@@ -143,26 +132,15 @@ void DeviceTreeView::check_signals(
 	if (!is_signal_checkable_)
 		return;
 
-	const QList<QStandardItem *> all_items =
-		tree_model_->findItems("", Qt::MatchContains | Qt::MatchRecursive);
+	set<const sv::data::BaseSignal *> signal_set;
+	for (const auto &signal : signals)
+		signal_set.insert(signal.get());
 
-	// First uncheck all signals
-	for (const auto &item : all_items) {
-		if (item->type() == (int)TreeItemType::SignalItem) {
-			item->setCheckState(Qt::Unchecked);
-		}
-	}
-
-	// Now check all signals that are in the signals vector
-	for (const auto &item : all_items) {
-		if (item->type() == (int)TreeItemType::SignalItem) {
-			auto item_data =
-				item->data().value<shared_ptr<sv::data::BaseSignal>>();
-			for (const auto &signal : signals) {
-				if (item_data.get() == signal.get())
-					item->setCheckState(Qt::Checked);
-			}
-		}
+	for (const auto &item : tree_model_->items(TreeItemType::SignalItem)) {
+		auto item_data = item->data(DeviceTreeModel::DataRole).
+			value<shared_ptr<sv::data::BaseSignal>>();
+		item->setCheckState(signal_set.count(item_data.get()) > 0 ?
+			Qt::Checked : Qt::Unchecked);
 	}
 }
 
@@ -174,18 +152,41 @@ vector<shared_ptr<sv::data::BaseSignal>>
 	if (!is_signal_checkable_)
 		return signals;
 
-	const QList<QStandardItem *> all_items =
-		tree_model_->findItems("", Qt::MatchContains | Qt::MatchRecursive);
-	for (const auto &item : all_items) {
-		if (item->checkState() > 0 &&
-				item->type() == (int)TreeItemType::SignalItem) {
-			signals.push_back(
-				item->data().value<shared_ptr<sv::data::BaseSignal>>());
+	for (const auto &item : tree_model_->items(TreeItemType::SignalItem)) {
+		if (item->checkState() > 0) {
+			signals.push_back(item->data(DeviceTreeModel::DataRole).
+				value<shared_ptr<sv::data::BaseSignal>>());
 		}
 	}
 	return signals;
 }
 
+void DeviceTreeView::set_filter(const QString &filter)
+{
+	filter_ = filter.toLower();
+	QStandardItem *root_item = tree_model_->invisibleRootItem();
+	for (int i=0; i<root_item->rowCount(); ++i)
+		apply_filter(root_item->child(i), false);
+}
+
+bool DeviceTreeView::apply_filter(QStandardItem *item, bool parent_matches)
+{
+	const bool matches = parent_matches ||
+		static_cast<TreeItem *>(item)->matches_filter(filter_);
+
+	// An item is visible, when it or one of its parents matches the filter,
+	// or when one of its children is visible.
+	bool is_visible = matches;
+	for (int i=0; i<item->rowCount(); ++i) {
+		if (apply_filter(item->child(i), matches))
+			is_visible = true;
+	}
+
+	QModelIndex index = tree_model_->indexFromItem(item);
+	setRowHidden(index.row(), index.parent(), !is_visible);
+	return is_visible;
+}
+
 void DeviceTreeView::expand_device(shared_ptr<sv::devices::BaseDevice> device)
 {
 	TreeItem *item = tree_model_->find_device(device);
@@ -229,11 +230,17 @@ void DeviceTreeView::expand_recursive(QStandardItem *item)
 void DeviceTreeView::on_rows_inserted(const QModelIndex &model_index,
 	int first, int last)
 {
-	(void)first;
-	(void)last;
-
 	if (is_auto_expand_)
 		this->expand_recursive(tree_model_->itemFromIndex(model_index));
+
+	// Apply the filter to the new items
+	if (!filter_.isEmpty()) {
+		QStandardItem *parent_item = model_index.isValid() ?
+			tree_model_->itemFromIndex(model_index) :
+			tree_model_->invisibleRootItem();
+		for (int i=first; i<=last; ++i)
+			apply_filter(parent_item->child(i), false);
+	}
 }
 
 } // namespace devicetree
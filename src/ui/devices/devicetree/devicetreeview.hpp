@@ -25,6 +25,7 @@
 
 #include <QModelIndex>
 #include <QStandardItem>
+#include <QString>
 #include <QTreeView>
 
 using std::shared_ptr;
@@ -74,9 +75,16 @@ public:
 
 	void expand_device(shared_ptr<sv::devices::BaseDevice> device);
 
+	/**
+	 * Only show the items whose name contains `filter` (case insensitive),
+	 * their parents and their children. An empty filter shows all items.
+	 */
+	void set_filter(const QString &filter);
+
 private:
 	void setup_ui();
 	void expand_recursive(QStandardItem *item);
+	bool apply_filter(QStandardItem *item, bool parent_matches);
 
 	const Session &session_;
 	bool is_device_checkable_;
@@ -88,6 +96,7 @@ private:
 	bool show_configurable_;
 	bool is_auto_expand_;
 	DeviceTreeModel *tree_model_;
+	QString filter_;
 
 private Q_SLOTS:
 	void on_rows_inserted(const QModelIndex &model_index, int first, int last);
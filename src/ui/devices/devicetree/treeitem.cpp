@@ -19,8 +19,10 @@
 
 #include <QIcon>
 #include <QStandardItem>
+#include <QString>
 
 #include "treeitem.hpp"
+#include "src/ui/devices/devicetree/devicetreemodel.hpp"
 
 namespace sv {
 namespace ui {
@@ -29,7 +31,9 @@ namespace devicetree {
 
 TreeItem::TreeItem(TreeItemType type) :
 	QStandardItem(),
-	type_(type)
+	type_(type),
+	has_sort_index_(false),
+	sort_index_(0)
 {
 	if (type == TreeItemType::DeviceItem) {
 		setIcon(QIcon(":/icons/smuview.png"));
@@ -61,6 +65,41 @@ int TreeItem::type() const
 	return (int)type_;
 }
 
+void TreeItem::set_sort_key(int index)
+{
+	has_sort_index_ = true;
+	sort_index_ = index;
+	sort_name_ = QString::number(index);
+	setData(index, DeviceTreeModel::SortRole);
+}
+
+void TreeItem::set_sort_key(const QString &name)
+{
+	has_sort_index_ = false;
+	sort_name_ = name;
+	setData(name, DeviceTreeModel::SortRole);
+}
+
+bool TreeItem::operator<(const QStandardItem &other) const
+{
+	// All items of the device tree are TreeItems.
+	const TreeItem &other_item = static_cast<const TreeItem &>(other);
+	if (has_sort_index_ && other_item.has_sort_index_)
+		return sort_index_ < other_item.sort_index_;
+	return sort_name_ < other_item.sort_name_;
+}
+
+void TreeItem::set_item_text(const QString &text)
+{
+	setText(text);
+	filter_text_ = text.toLower();
+}
+
+bool TreeItem::matches_filter(const QString &filter) const
+{
+	return filter_text_.contains(filter);
+}
+
 } // namespace devicetree
 } // namespace devices
 } // namespace ui
@@ -22,6 +22,7 @@
 
 #include <QStandardItem>
 #include <QIcon>
+#include <QString>
 
 namespace sv {
 namespace ui {
@@ -45,8 +46,30 @@ public:
 
 	int type() const override;
 
+	/**
+	 * Set the key for sorting the item. The key is cached in the item, so
+	 * the items can be compared without accessing the item data. The key is
+	 * also set as `DeviceTreeModel::SortRole`.
+	 */
+	void set_sort_key(int index);
+	void set_sort_key(const QString &name);
+	/**
+	 * Compare the cached sort keys. Items with an index are compared by the
+	 * index, all other items by the name.
+	 */
+	bool operator<(const QStandardItem &other) const override;
+
+	/** Set the text and the cached lower case text for filtering. */
+	void set_item_text(const QString &text);
+	/** `filter` must be lower case. */
+	bool matches_filter(const QString &filter) const;
+
 protected:
 	TreeItemType type_;
+	bool has_sort_index_;
+	int sort_index_;
+	QString sort_name_;
+	QString filter_text_;
 
 };
 
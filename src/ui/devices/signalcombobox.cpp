@@ -25,9 +25,11 @@
 #include <QVariant>
 
 #include "signalcombobox.hpp"
+#include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
 #include "src/channels/basechannel.hpp"
 
+using std::dynamic_pointer_cast;
 using std::shared_ptr;
 
 Q_DECLARE_METATYPE(shared_ptr<sv::data::BaseSignal>)
@@ -91,6 +93,9 @@ void SignalComboBox::fill_signals()
 
 	for (const auto &signal_pair : channel_->signal_map()) {
 		for (const auto &signal : signal_pair.second) {
+			// The views can only display time signals for now
+			if (!dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal))
+				continue;
 			if (filter_active_ && filter_quantity_ != signal->quantity())
 				continue;
 			this->addItem(signal->display_name(), QVariant::fromValue(signal));
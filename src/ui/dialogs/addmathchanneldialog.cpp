@@ -22,6 +22,7 @@
 #include <set>
 #include <string>
 
+#include <QCheckBox>
 #include <QComboBox>
 #include <QDebug>
 #include <QFormLayout>
@@ -37,14 +38,20 @@
 #include "addmathchanneldialog.hpp"
 #include "src/channels/addscchannel.hpp"
 #include "src/channels/basechannel.hpp"
+#include "src/channels/derivativechannel.hpp"
 #include "src/channels/dividechannel.hpp"
+#include "src/channels/histogramchannel.hpp"
 #include "src/channels/integratechannel.hpp"
 #include "src/channels/mathchannel.hpp"
 #include "src/channels/movingavgchannel.hpp"
 #include "src/channels/multiplysfchannel.hpp"
 #include "src/channels/multiplysschannel.hpp"
+#include "src/channels/resamplechannel.hpp"
+#include "src/channels/rollingstatschannel.hpp"
+#include "src/channels/spectrumchannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/fft.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/data/quantitycombobox.hpp"
 #include "src/ui/data/quantityflagslist.hpp"
@@ -53,9 +60,9 @@
 #include "src/ui/devices/devicecombobox.hpp"
 #include "src/ui/devices/selectsignalwidget.hpp"
 
+using std::dynamic_pointer_cast;
 using std::make_shared;
 using std::set;
-using std::static_pointer_cast;
 using std::string;
 
 Q_DECLARE_SMART_POINTER_METATYPE(std::shared_ptr)
@@ -126,7 +133,12 @@ void AddMathChannelDialog::setup_ui()
 	this->setup_ui_divide_signals_tab();
 	this->setup_ui_add_signal_tab();
 	this->setup_ui_integrate_signal_tab();
+	this->setup_ui_derivative_signal_tab();
 	this->setup_ui_movingavg_signal_tab();
+	this->setup_ui_spectrum_signal_tab();
+	this->setup_ui_resample_signal_tab();
+	this->setup_ui_rolling_stats_signal_tab();
+	this->setup_ui_histogram_signal_tab();
 	tab_widget_->setCurrentIndex(0);
 	main_layout->addWidget(tab_widget_);
 
@@ -259,6 +271,44 @@ void AddMathChannelDialog::setup_ui_integrate_signal_tab()
 	signal_group->setLayout(s_layout);
 	layout->addWidget(signal_group);
 
+	QFormLayout *m_layout = new QFormLayout();
+	i_s_method_box_ = new QComboBox();
+	i_s_method_box_->addItem(tr("Rectangular"),
+		QVariant::fromValue((int)channels::IntegrationMethod::Rectangular));
+	i_s_method_box_->addItem(tr("Trapezoidal"),
+		QVariant::fromValue((int)channels::IntegrationMethod::Trapezoidal));
+	i_s_method_box_->addItem(tr("Simpson"),
+		QVariant::fromValue((int)channels::IntegrationMethod::Simpson));
+	i_s_method_box_->setCurrentIndex(1);
+	m_layout->addRow(tr("Method"), i_s_method_box_);
+	layout->addLayout(m_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_derivative_signal_tab()
+{
+	QString title(tr("dS(t) / dt"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	der_signal_ = new ui::devices::SelectSignalWidget(session_);
+	der_signal_->select_device(device_);
+	s_layout->addWidget(der_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *sm_layout = new QFormLayout();
+	der_smooth_box_ = new QSpinBox();
+	der_smooth_box_->setMinimum(1);
+	der_smooth_box_->setMaximum(100000);
+	sm_layout->addRow(tr("Smoothing (samples)"), der_smooth_box_);
+	layout->addLayout(sm_layout);
+
 	widget->setLayout(layout);
 	tab_widget_->addTab(widget, title);
 }
@@ -288,6 +338,168 @@ void AddMathChannelDialog::setup_ui_movingavg_signal_tab()
 	tab_widget_->addTab(widget, title);
 }
 
+void AddMathChannelDialog::setup_ui_spectrum_signal_tab()
+{
+	QString title(tr("Spectrum"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	spec_signal_ = new ui::devices::SelectSignalWidget(session_);
+	spec_signal_->select_device(device_);
+	s_layout->addWidget(spec_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *f_layout = new QFormLayout();
+	spec_window_size_box_ = new QSpinBox();
+	spec_window_size_box_->setRange(4, 1048576);
+	spec_window_size_box_->setValue(1024);
+	f_layout->addRow(tr("Window size"), spec_window_size_box_);
+	spec_window_function_box_ = new QComboBox();
+	spec_window_function_box_->addItem(tr("Rectangular"),
+		QVariant::fromValue((int)sv::data::WindowFunction::Rectangular));
+	spec_window_function_box_->addItem(tr("Hann"),
+		QVariant::fromValue((int)sv::data::WindowFunction::Hann));
+	spec_window_function_box_->addItem(tr("Hamming"),
+		QVariant::fromValue((int)sv::data::WindowFunction::Hamming));
+	spec_window_function_box_->addItem(tr("Blackman"),
+		QVariant::fromValue((int)sv::data::WindowFunction::Blackman));
+	spec_window_function_box_->addItem(tr("Flat top"),
+		QVariant::fromValue((int)sv::data::WindowFunction::FlatTop));
+	spec_window_function_box_->setCurrentIndex(1);
+	f_layout->addRow(tr("Window function"), spec_window_function_box_);
+	spec_overlap_box_ = new QSpinBox();
+	spec_overlap_box_->setRange(0, 95);
+	spec_overlap_box_->setValue(50);
+	spec_overlap_box_->setSuffix(" %");
+	f_layout->addRow(tr("Overlap"), spec_overlap_box_);
+	spec_avg_count_box_ = new QSpinBox();
+	spec_avg_count_box_->setRange(1, 1000);
+	f_layout->addRow(tr("Averaged frames"), spec_avg_count_box_);
+	spec_phase_check_ = new QCheckBox();
+	f_layout->addRow(tr("Phase signal"), spec_phase_check_);
+	layout->addLayout(f_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_resample_signal_tab()
+{
+	QString title(tr("Resample"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	rs_signal_ = new ui::devices::SelectSignalWidget(session_);
+	rs_signal_->select_device(device_);
+	s_layout->addWidget(rs_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *f_layout = new QFormLayout();
+	rs_samplerate_edit_ = new QLineEdit();
+	f_layout->addRow(tr("Samplerate [Hz]"), rs_samplerate_edit_);
+	rs_interpolation_box_ = new QComboBox();
+	rs_interpolation_box_->addItem(tr("Linear"),
+		QVariant::fromValue((int)channels::InterpolationMethod::Linear));
+	rs_interpolation_box_->addItem(tr("Cubic"),
+		QVariant::fromValue((int)channels::InterpolationMethod::Cubic));
+	f_layout->addRow(tr("Interpolation"), rs_interpolation_box_);
+	layout->addLayout(f_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_rolling_stats_signal_tab()
+{
+	QString title(tr("Rolling Statistics"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	rst_signal_ = new ui::devices::SelectSignalWidget(session_);
+	rst_signal_->select_device(device_);
+	s_layout->addWidget(rst_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *f_layout = new QFormLayout();
+	rst_statistic_box_ = new QComboBox();
+	rst_statistic_box_->addItem(tr("Minimum"),
+		QVariant::fromValue((int)channels::RollingStatistic::Min));
+	rst_statistic_box_->addItem(tr("Maximum"),
+		QVariant::fromValue((int)channels::RollingStatistic::Max));
+	rst_statistic_box_->addItem(tr("Peak-to-peak"),
+		QVariant::fromValue((int)channels::RollingStatistic::PeakToPeak));
+	rst_statistic_box_->addItem(tr("Mean"),
+		QVariant::fromValue((int)channels::RollingStatistic::Mean));
+	rst_statistic_box_->addItem(tr("Standard deviation"),
+		QVariant::fromValue((int)channels::RollingStatistic::StdDev));
+	rst_statistic_box_->addItem(tr("RMS"),
+		QVariant::fromValue((int)channels::RollingStatistic::RMS));
+	f_layout->addRow(tr("Statistic"), rst_statistic_box_);
+	rst_window_type_box_ = new QComboBox();
+	rst_window_type_box_->addItem(tr("Sample count"));
+	rst_window_type_box_->addItem(tr("Time [s]"));
+	f_layout->addRow(tr("Window type"), rst_window_type_box_);
+	rst_window_edit_ = new QLineEdit();
+	f_layout->addRow(tr("Window size"), rst_window_edit_);
+	layout->addLayout(f_layout);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
+void AddMathChannelDialog::setup_ui_histogram_signal_tab()
+{
+	QString title(tr("Histogram"));
+
+	QWidget *widget = new QWidget();
+	QVBoxLayout *layout = new QVBoxLayout();
+
+	QGroupBox *signal_group = new QGroupBox(tr("Signal"));
+	QVBoxLayout *s_layout = new QVBoxLayout();
+	h_signal_ = new ui::devices::SelectSignalWidget(session_);
+	h_signal_->select_device(device_);
+	s_layout->addWidget(h_signal_);
+	signal_group->setLayout(s_layout);
+	layout->addWidget(signal_group);
+
+	QFormLayout *f_layout = new QFormLayout();
+	h_bin_count_box_ = new QSpinBox();
+	h_bin_count_box_->setMinimum(2);
+	h_bin_count_box_->setMaximum(100000);
+	h_bin_count_box_->setValue(100);
+	f_layout->addRow(tr("Number of bins"), h_bin_count_box_);
+	h_auto_range_check_ = new QCheckBox();
+	h_auto_range_check_->setChecked(true);
+	f_layout->addRow(tr("Auto range"), h_auto_range_check_);
+	h_min_edit_ = new QLineEdit();
+	h_min_edit_->setEnabled(false);
+	f_layout->addRow(tr("Minimum"), h_min_edit_);
+	h_max_edit_ = new QLineEdit();
+	h_max_edit_->setEnabled(false);
+	f_layout->addRow(tr("Maximum"), h_max_edit_);
+	layout->addLayout(f_layout);
+
+	connect(h_auto_range_check_, &QCheckBox::toggled,
+		h_min_edit_, &QLineEdit::setDisabled);
+	connect(h_auto_range_check_, &QCheckBox::toggled,
+		h_max_edit_, &QLineEdit::setDisabled);
+
+	widget->setLayout(layout);
+	tab_widget_->addTab(widget, title);
+}
+
 shared_ptr<channels::MathChannel> AddMathChannelDialog::channel() const
 {
 	return channel_;
@@ -318,25 +530,25 @@ void AddMathChannelDialog::accept()
 
 	switch (tab_widget_->currentIndex()) {
 	case 0: {
-			if (m_ss_signal1_->selected_signal() == nullptr) {
+			auto signal_1 = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				m_ss_signal1_->selected_signal());
+			if (!signal_1) {
 				QMessageBox::warning(this,
 					tr("Signal missing"),
 					tr("Please choose signal 1 for the signal multiplication."),
 					QMessageBox::Ok);
 				return;
 			}
-			auto signal_1 = static_pointer_cast<sv::data::AnalogTimeSignal>(
-				m_ss_signal1_->selected_signal());
 
-			if (m_ss_signal2_->selected_signal() == nullptr) {
+			auto signal_2 = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				m_ss_signal2_->selected_signal());
+			if (!signal_2) {
 				QMessageBox::warning(this,
 					tr("Signal missing"),
 					tr("Please choose signal 2 for the signal multiplication."),
 					QMessageBox::Ok);
 				return;
 			}
-			auto signal_2 = static_pointer_cast<sv::data::AnalogTimeSignal>(
-				m_ss_signal2_->selected_signal());
 
 			double start_timestamp = signal_1->signal_start_timestamp();
 			if (signal_2->signal_start_timestamp() < start_timestamp)
@@ -350,15 +562,15 @@ void AddMathChannelDialog::accept()
 		}
 		break;
 	case 1: {
-			if (m_sf_signal_->selected_signal() == nullptr) {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				m_sf_signal_->selected_signal());
+			if (!signal) {
 				QMessageBox::warning(this,
 					tr("Signal missing"),
 					tr("Please choose a signal for the factor multiplication."),
 					QMessageBox::Ok);
 				return;
 			}
-			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
-				m_sf_signal_->selected_signal());
 
 			if (m_sf_factor_edit_->text().size() == 0) {
 				QMessageBox::warning(this,
@@ -386,25 +598,25 @@ void AddMathChannelDialog::accept()
 		}
 		break;
 	case 2: {
-			if (d_ss_signal1_->selected_signal() == nullptr) {
+			auto signal1 = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				d_ss_signal1_->selected_signal());
+			if (!signal1) {
 				QMessageBox::warning(this,
 					tr("Signal missing"),
 					tr("Please choose signal 1 for the signal division."),
 					QMessageBox::Ok);
 				return;
 			}
-			auto signal1 = static_pointer_cast<sv::data::AnalogTimeSignal>(
-				d_ss_signal1_->selected_signal());
 
-			if (d_ss_signal2_->selected_signal() == nullptr) {
+			auto signal2 = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				d_ss_signal2_->selected_signal());
+			if (!signal2) {
 				QMessageBox::warning(this,
 					tr("Signal missing"),
 					tr("Please choose signal 2 for the signal division."),
 					QMessageBox::Ok);
 				return;
 			}
-			auto signal2 = static_pointer_cast<sv::data::AnalogTimeSignal>(
-				d_ss_signal2_->selected_signal());
 
 			double start_timestamp = signal1->signal_start_timestamp();
 			if (signal2->signal_start_timestamp() < start_timestamp)
@@ -418,15 +630,15 @@ void AddMathChannelDialog::accept()
 		}
 		break;
 	case 3: {
-			if (a_sc_signal_->selected_signal() == nullptr) {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				a_sc_signal_->selected_signal());
+			if (!signal) {
 				QMessageBox::warning(this,
 					tr("Signal missing"),
 					tr("Please choose a signal for the constant addition."),
 					QMessageBox::Ok);
 				return;
 			}
-			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
-				a_sc_signal_->selected_signal());
 
 			if (a_sc_constant_edit_->text().size() == 0) {
 				QMessageBox::warning(this,
@@ -454,33 +666,56 @@ void AddMathChannelDialog::accept()
 		}
 		break;
 	case 4: {
-			if (i_s_signal_->selected_signal() == nullptr) {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				i_s_signal_->selected_signal());
+			if (!signal) {
 				QMessageBox::warning(this,
 					tr("Signal missing"),
 					tr("Please choose a signal for the integration."),
 					QMessageBox::Ok);
 				return;
 			}
-			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
-				i_s_signal_->selected_signal());
+
+			auto method = (channels::IntegrationMethod)
+				i_s_method_box_->currentData().toInt();
 
 			channel_ = make_shared<channels::IntegrateChannel>(
 				quantity, quantity_flags, unit,
-				signal,
+				signal, method,
 				device, channel_group_names, name_edit_->text().toStdString(),
 				signal->signal_start_timestamp());
 		}
 		break;
 	case 5: {
-			if (ma_signal_->selected_signal() == nullptr) {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				der_signal_->selected_signal());
+			if (!signal) {
 				QMessageBox::warning(this,
 					tr("Signal missing"),
-					tr("Please choose a signal for the moving average."),
+					tr("Please choose a signal for the derivative."),
 					QMessageBox::Ok);
 				return;
 			}
-			auto signal = static_pointer_cast<sv::data::AnalogTimeSignal>(
+
+			uint smooth_count = der_smooth_box_->value();
+
+			channel_ = make_shared<channels::DerivativeChannel>(
+				quantity, quantity_flags, unit,
+				signal, smooth_count,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 6: {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
 				ma_signal_->selected_signal());
+			if (!signal) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the moving average."),
+					QMessageBox::Ok);
+				return;
+			}
 
 			uint num_samples = ma_num_samples_box_->value();
 
@@ -491,6 +726,146 @@ void AddMathChannelDialog::accept()
 				signal->signal_start_timestamp());
 		}
 		break;
+	case 7: {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				spec_signal_->selected_signal());
+			if (!signal) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the spectrum."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			auto window_function = (sv::data::WindowFunction)
+				spec_window_function_box_->currentData().toInt();
+
+			channel_ = make_shared<channels::SpectrumChannel>(
+				quantity, quantity_flags, unit,
+				signal, spec_window_size_box_->value(), window_function,
+				spec_overlap_box_->value() / 100., spec_avg_count_box_->value(),
+				spec_phase_check_->isChecked(),
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 8: {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				rs_signal_->selected_signal());
+			if (!signal) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the resampling."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			bool ok;
+			double samplerate =
+				QString(rs_samplerate_edit_->text()).toDouble(&ok);
+			if (!ok || samplerate <= 0) {
+				QMessageBox::warning(this,
+					tr("Samplerate not valid"),
+					tr("Please enter a positive number as samplerate for the resampling."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			auto interpolation = (channels::InterpolationMethod)
+				rs_interpolation_box_->currentData().toInt();
+
+			channel_ = make_shared<channels::ResampleChannel>(
+				quantity, quantity_flags, unit,
+				signal, samplerate, interpolation,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 9: {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				rst_signal_->selected_signal());
+			if (!signal) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the rolling statistics."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			bool ok;
+			double window = QString(rst_window_edit_->text()).toDouble(&ok);
+			if (!ok || window <= 0) {
+				QMessageBox::warning(this,
+					tr("Window size not valid"),
+					tr("Please enter a positive number as window size for the rolling statistics."),
+					QMessageBox::Ok);
+				return;
+			}
+			size_t window_sample_count = 0;
+			double window_time = 0.;
+			if (rst_window_type_box_->currentIndex() == 0)
+				window_sample_count = (size_t)window;
+			else
+				window_time = window;
+			if (window_sample_count == 0 && window_time <= 0) {
+				QMessageBox::warning(this,
+					tr("Window size not valid"),
+					tr("Please enter a positive number as window size for the rolling statistics."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			auto statistic = (channels::RollingStatistic)
+				rst_statistic_box_->currentData().toInt();
+
+			channel_ = make_shared<channels::RollingStatsChannel>(
+				quantity, quantity_flags, unit,
+				signal, statistic, window_sample_count, window_time,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
+	case 10: {
+			auto signal = dynamic_pointer_cast<sv::data::AnalogTimeSignal>(
+				h_signal_->selected_signal());
+			if (!signal) {
+				QMessageBox::warning(this,
+					tr("Signal missing"),
+					tr("Please choose a signal for the histogram."),
+					QMessageBox::Ok);
+				return;
+			}
+			size_t bin_count = (size_t)h_bin_count_box_->value();
+
+			if (h_auto_range_check_->isChecked()) {
+				channel_ = make_shared<channels::HistogramChannel>(
+					quantity, quantity_flags, unit,
+					signal, bin_count,
+					device, channel_group_names,
+					name_edit_->text().toStdString(),
+					signal->signal_start_timestamp());
+				break;
+			}
+
+			bool min_ok;
+			bool max_ok;
+			double min = QString(h_min_edit_->text()).toDouble(&min_ok);
+			double max = QString(h_max_edit_->text()).toDouble(&max_ok);
+			if (!min_ok || !max_ok || min >= max) {
+				QMessageBox::warning(this,
+					tr("Range not valid"),
+					tr("Please enter a valid range for the histogram, the minimum must be less than the maximum."),
+					QMessageBox::Ok);
+				return;
+			}
+
+			channel_ = make_shared<channels::HistogramChannel>(
+				quantity, quantity_flags, unit,
+				signal, bin_count, min, max,
+				device, channel_group_names, name_edit_->text().toStdString(),
+				signal->signal_start_timestamp());
+		}
+		break;
 	default:
 		break;
 	}
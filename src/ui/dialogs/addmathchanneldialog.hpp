@@ -22,6 +22,8 @@
 
 #include <memory>
 
+#include <QCheckBox>
+#include <QComboBox>
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QLineEdit>
@@ -76,7 +78,12 @@ private:
 	void setup_ui_divide_signal_tab();
 	void setup_ui_add_signal_tab();
 	void setup_ui_integrate_signal_tab();
+	void setup_ui_derivative_signal_tab();
 	void setup_ui_movingavg_signal_tab();
+	void setup_ui_spectrum_signal_tab();
+	void setup_ui_resample_signal_tab();
+	void setup_ui_rolling_stats_signal_tab();
+	void setup_ui_histogram_signal_tab();
 
 	const Session &session_;
 	shared_ptr<sv::devices::BaseDevice> device_;
@@ -98,8 +105,29 @@ private:
 	ui::devices::SelectSignalWidget *a_sc_signal_;
 	QLineEdit *a_sc_constant_edit_;
 	ui::devices::SelectSignalWidget *i_s_signal_;
+	QComboBox *i_s_method_box_;
+	ui::devices::SelectSignalWidget *der_signal_;
+	QSpinBox *der_smooth_box_;
 	ui::devices::SelectSignalWidget *ma_signal_;
 	QSpinBox *ma_num_samples_box_;
+	ui::devices::SelectSignalWidget *spec_signal_;
+	QSpinBox *spec_window_size_box_;
+	QComboBox *spec_window_function_box_;
+	QSpinBox *spec_overlap_box_;
+	QSpinBox *spec_avg_count_box_;
+	QCheckBox *spec_phase_check_;
+	ui::devices::SelectSignalWidget *rs_signal_;
+	QLineEdit *rs_samplerate_edit_;
+	QComboBox *rs_interpolation_box_;
+	ui::devices::SelectSignalWidget *rst_signal_;
+	QComboBox *rst_statistic_box_;
+	QComboBox *rst_window_type_box_;
+	QLineEdit *rst_window_edit_;
+	ui::devices::SelectSignalWidget *h_signal_;
+	QSpinBox *h_bin_count_box_;
+	QCheckBox *h_auto_range_check_;
+	QLineEdit *h_min_edit_;
+	QLineEdit *h_max_edit_;
 	QDialogButtonBox *button_box_;
 
 public Q_SLOTS:
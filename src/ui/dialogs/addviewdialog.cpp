@@ -48,6 +48,7 @@
 #include "src/ui/views/viewhelper.hpp"
 #include "src/ui/views/xyplotview.hpp"
 
+using std::dynamic_pointer_cast;
 using std::set;
 using std::static_pointer_cast;
 
@@ -279,21 +280,25 @@ void AddViewDialog::accept()
 			views_.push_back(conf_views);
 		}
 		for (const auto &signal : time_plot_channel_tree_->checked_signals()) {
+			auto time_signal =
+				dynamic_pointer_cast<data::AnalogTimeSignal>(signal);
+			if (!time_signal)
+				continue;
 			auto *conf_views = new ui::views::TimePlotView(session_);
-			conf_views->add_signal(static_pointer_cast<data::AnalogTimeSignal>(signal));
+			conf_views->add_signal(time_signal);
 			views_.push_back(conf_views);
 		}
 		break;
 	case 4:
 		// Add x/y plot view
 		{
-			auto x_signal = xy_plot_x_signal_widget_->selected_signal();
-			auto y_signal = xy_plot_y_signal_widget_->selected_signal();
+			auto x_signal = dynamic_pointer_cast<data::AnalogTimeSignal>(
+				xy_plot_x_signal_widget_->selected_signal());
+			auto y_signal = dynamic_pointer_cast<data::AnalogTimeSignal>(
+				xy_plot_y_signal_widget_->selected_signal());
 			if (x_signal != nullptr && y_signal != nullptr) {
 				auto *view = new ui::views::XYPlotView(session_);
-				view->add_signals(
-					static_pointer_cast<data::AnalogTimeSignal>(x_signal),
-					static_pointer_cast<data::AnalogTimeSignal>(y_signal));
+				view->add_signals(x_signal, y_signal);
 				views_.push_back(view);
 			}
 		}
@@ -301,27 +306,30 @@ void AddViewDialog::accept()
 	case 5:
 		// Add data table view
 		{
-			auto signals = data_table_signal_tree_->checked_signals();
-			if (!signals.empty()) {
-				auto *view = new ui::views::DataView(session_);
-				for (const auto &signal : signals) {
-					view->add_signal(
-						static_pointer_cast<data::AnalogTimeSignal>(signal));
-				}
-				views_.push_back(view);
+			ui::views::DataView *view = nullptr;
+			for (const auto &signal : data_table_signal_tree_->checked_signals()) {
+				auto time_signal =
+					dynamic_pointer_cast<data::AnalogTimeSignal>(signal);
+				if (!time_signal)
+					continue;
+				if (!view)
+					view = new ui::views::DataView(session_);
+				view->add_signal(time_signal);
 			}
+			if (view)
+				views_.push_back(view);
 		}
 		break;
 	case 6:
 		// Add power panel view
 		{
-			auto v_signal = ppanel_voltage_signal_widget_->selected_signal();
-			auto c_signal = ppanel_current_signal_widget_->selected_signal();
+			auto v_signal = dynamic_pointer_cast<data::AnalogTimeSignal>(
+				ppanel_voltage_signal_widget_->selected_signal());
+			auto c_signal = dynamic_pointer_cast<data::AnalogTimeSignal>(
+				ppanel_current_signal_widget_->selected_signal());
 			if (v_signal != nullptr && c_signal != nullptr) {
 				auto *view = new ui::views::PowerPanelView(session_);
-				view->set_signals(
-					static_pointer_cast<data::AnalogTimeSignal>(v_signal),
-					static_pointer_cast<data::AnalogTimeSignal>(c_signal));
+				view->set_signals(v_signal, c_signal);
 				views_.push_back(view);
 			}
 		}
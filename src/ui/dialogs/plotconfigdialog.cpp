@@ -22,6 +22,7 @@
 #include <set>
 
 #include <QApplication>
+#include <QCheckBox>
 #include <QColor>
 #include <QColorDialog>
 #include <QComboBox>
@@ -32,6 +33,7 @@
 #include <QHeaderView>
 #include <QIcon>
 #include <QLineEdit>
+#include <QSpinBox>
 #include <QString>
 #include <QStyle>
 #include <QStyleOptionViewItem>
@@ -194,6 +196,22 @@ void PlotConfigDialog::setup_ui_plot_mode_tab()
 	add_time_edit_->setText(QString("%1").arg(plot_->add_time(), 0, 'f'));
 	layout->addRow(tr("Add time"), add_time_edit_);
 
+	threaded_rendering_check_ = new QCheckBox();
+	threaded_rendering_check_->setChecked(plot_->threaded_rendering());
+	layout->addRow(tr("Render curves in background"), threaded_rendering_check_);
+
+	persistence_check_ = new QCheckBox();
+	persistence_check_->setChecked(plot_->persistence());
+	layout->addRow(tr("Persistence"), persistence_check_);
+
+	persistence_decay_box_ = new QSpinBox();
+	persistence_decay_box_->setRange(0, 100);
+	persistence_decay_box_->setSuffix(" %");
+	persistence_decay_box_->setValue(plot_->persistence_decay());
+	persistence_decay_box_->setToolTip(
+		tr("Hits kept after each sweep, 100 % is infinite persistence"));
+	layout->addRow(tr("Persistence per sweep"), persistence_decay_box_);
+
 	switch (plot_->update_mode()) {
 	case widgets::plot::PlotUpdateMode::Additive:
 		setup_ui_additive();
@@ -333,18 +351,24 @@ void PlotConfigDialog::setup_ui_additive()
 {
 	time_span_edit_->setDisabled(true);
 	add_time_edit_->setDisabled(false);
+	persistence_check_->setDisabled(true);
+	persistence_decay_box_->setDisabled(true);
 }
 
 void PlotConfigDialog::setup_ui_rolling()
 {
 	time_span_edit_->setDisabled(false);
 	add_time_edit_->setDisabled(false);
+	persistence_check_->setDisabled(true);
+	persistence_decay_box_->setDisabled(true);
 }
 
 void PlotConfigDialog::setup_ui_oscilloscope()
 {
 	time_span_edit_->setDisabled(false);
 	add_time_edit_->setDisabled(true);
+	persistence_check_->setDisabled(false);
+	persistence_decay_box_->setDisabled(false);
 }
 
 void PlotConfigDialog::on_update_mode_changed()
@@ -376,6 +400,9 @@ void PlotConfigDialog::accept()
 		if (update_mode == widgets::plot::PlotUpdateMode::Additive ||
 				update_mode == widgets::plot::PlotUpdateMode::Rolling)
 			plot_->set_add_time(add_time_edit_->text().toDouble());
+		plot_->set_threaded_rendering(threaded_rendering_check_->isChecked());
+		plot_->set_persistence_decay(persistence_decay_box_->value());
+		plot_->set_persistence(persistence_check_->isChecked());
 	}
 
 	plot_->set_markers_label_alignment(
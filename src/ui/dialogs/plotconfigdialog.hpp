@@ -23,6 +23,7 @@
 #include <map>
 
 #include <QAbstractItemModel>
+#include <QCheckBox>
 #include <QComboBox>
 #include <QDialog>
 #include <QDialogButtonBox>
@@ -30,6 +31,7 @@
 #include <QLocale>
 #include <QModelIndex>
 #include <QPainter>
+#include <QSpinBox>
 #include <QString>
 #include <QStyledItemDelegate>
 #include <QStyleOptionViewItem>
@@ -87,6 +89,9 @@ private:
 	QComboBox *plot_update_mode_combobox_;
 	QLineEdit *time_span_edit_;
 	QLineEdit *add_time_edit_;
+	QCheckBox *threaded_rendering_check_;
+	QCheckBox *persistence_check_;
+	QSpinBox *persistence_decay_box_;
 	QComboBox *markers_box_pos_combobox_;
 	QTableWidget *color_table_;
 	QDialogButtonBox *button_box_;
@@ -24,6 +24,7 @@
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QIcon>
+#include <QLineEdit>
 #include <QSize>
 #include <QString>
 #include <QVBoxLayout>
@@ -66,6 +67,13 @@ void SelectSignalDialog::setup_ui()
 	device_tree_ = new devices::devicetree::DeviceTreeView(session_,
 		false, false, false, true, false, false, false, false);
 	device_tree_->expand_device(expanded_device_);
+
+	filter_edit_ = new QLineEdit();
+	filter_edit_->setPlaceholderText(tr("Filter"));
+	filter_edit_->setClearButtonEnabled(true);
+	connect(filter_edit_, &QLineEdit::textChanged,
+		device_tree_, &ui::devices::devicetree::DeviceTreeView::set_filter);
+	main_layout->addWidget(filter_edit_);
 	main_layout->addWidget(device_tree_);
 
 	button_box_ = new QDialogButtonBox(
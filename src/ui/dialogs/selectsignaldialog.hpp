@@ -25,6 +25,7 @@
 
 #include <QDialog>
 #include <QDialogButtonBox>
+#include <QLineEdit>
 
 #include "src/session.hpp"
 
@@ -68,6 +69,7 @@ private:
 	const shared_ptr<sv::devices::BaseDevice> expanded_device_;
 	vector<shared_ptr<sv::data::BaseSignal>> signals_;
 
+	QLineEdit *filter_edit_;
 	ui::devices::devicetree::DeviceTreeView *device_tree_;
 	QDialogButtonBox *button_box_;
 
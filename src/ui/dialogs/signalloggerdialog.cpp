@@ -0,0 +1,234 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QMessageBox>
+#include <QSettings>
+#include <QVBoxLayout>
+
+#include "signalloggerdialog.hpp"
+#include "src/settingsmanager.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/basesignal.hpp"
+#include "src/data/signallogger.hpp"
+#include "src/devices/basedevice.hpp"
+#include "src/ui/devices/devicetree/devicetreeview.hpp"
+
+using std::dynamic_pointer_cast;
+using std::make_shared;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace dialogs {
+
+SignalLoggerDialog::SignalLoggerDialog(const Session &session,
+		const shared_ptr<sv::devices::BaseDevice> selected_device,
+		QWidget *parent) :
+	QDialog(parent),
+	session_(session),
+	selected_device_(selected_device),
+	logger_(nullptr)
+{
+	setup_ui();
+
+	QSettings settings;
+	if (SettingsManager::restore_settings() &&
+			settings.childGroups().contains("SignalLoggerDialog")) {
+		restore_settings(settings);
+	}
+	else {
+		file_dialog_path_ = QDir::homePath();
+	}
+}
+
+void SignalLoggerDialog::setup_ui()
+{
+	QIcon main_icon;
+	main_icon.addFile(QStringLiteral(":/icons/smuview.ico"),
+		QSize(), QIcon::Normal, QIcon::Off);
+	this->setWindowIcon(main_icon);
+	this->setWindowTitle(tr("Log Signals"));
+	this->setMinimumWidth(450);
+	this->setMinimumHeight(400);
+
+	QVBoxLayout *main_layout = new QVBoxLayout;
+
+	device_tree_ = new ui::devices::devicetree::DeviceTreeView(
+		session_, false, false, false, true, false, false, false, false);
+	device_tree_->expand_device(selected_device_);
+	device_tree_->check_signals(selected_device_->signals());
+
+	filter_edit_ = new QLineEdit();
+	filter_edit_->setPlaceholderText(tr("Filter"));
+	filter_edit_->setClearButtonEnabled(true);
+	connect(filter_edit_, &QLineEdit::textChanged,
+		device_tree_, &ui::devices::devicetree::DeviceTreeView::set_filter);
+	main_layout->addWidget(filter_edit_);
+	main_layout->addWidget(device_tree_);
+
+	QFormLayout *form_layout = new QFormLayout();
+
+	format_box_ = new QComboBox();
+	format_box_->addItem(tr("CSV"),
+		QVariant::fromValue((int)sv::data::LogFormat::Csv));
+	format_box_->addItem(tr("Binary"),
+		QVariant::fromValue((int)sv::data::LogFormat::Binary));
+	form_layout->addRow(tr("Format"), format_box_);
+
+	max_file_size_box_ = new QSpinBox();
+	max_file_size_box_->setRange(0, 1024 * 1024);
+	max_file_size_box_->setValue(100);
+	max_file_size_box_->setSuffix(" MiB");
+	max_file_size_box_->setSpecialValueText(tr("Off"));
+	form_layout->addRow(tr("New file after"), max_file_size_box_);
+
+	max_file_duration_box_ = new QSpinBox();
+	max_file_duration_box_->setRange(0, 7 * 24 * 60);
+	max_file_duration_box_->setValue(0);
+	max_file_duration_box_->setSuffix(" min");
+	max_file_duration_box_->setSpecialValueText(tr("Off"));
+	form_layout->addRow(tr("New file every"), max_file_duration_box_);
+
+	sync_interval_box_ = new QDoubleSpinBox();
+	sync_interval_box_->setRange(0., 3600.);
+	sync_interval_box_->setDecimals(1);
+	sync_interval_box_->setValue(5.);
+	sync_interval_box_->setSuffix(" s");
+	form_layout->addRow(tr("Sync to disk every"), sync_interval_box_);
+
+	main_layout->addLayout(form_layout);
+
+	button_box_ = new QDialogButtonBox(
+		QDialogButtonBox::Ok | QDialogButtonBox::Cancel, Qt::Horizontal);
+	main_layout->addWidget(button_box_);
+
+	connect(button_box_, &QDialogButtonBox::accepted,
+		this, &SignalLoggerDialog::accept);
+	connect(button_box_, &QDialogButtonBox::rejected,
+		this, &SignalLoggerDialog::reject);
+
+	this->setLayout(main_layout);
+}
+
+shared_ptr<sv::data::SignalLogger> SignalLoggerDialog::logger() const
+{
+	return logger_;
+}
+
+void SignalLoggerDialog::save_settings(QSettings &settings) const
+{
+	settings.beginGroup("SignalLoggerDialog");
+	settings.remove("");  // Remove all keys in this group
+
+	settings.setValue("format", format_box_->currentIndex());
+	settings.setValue("max_file_size", max_file_size_box_->value());
+	settings.setValue("max_file_duration", max_file_duration_box_->value());
+	settings.setValue("sync_interval", sync_interval_box_->value());
+	settings.setValue("file_dialog_path", file_dialog_path_);
+
+	settings.endGroup();
+}
+
+void SignalLoggerDialog::restore_settings(QSettings &settings)
+{
+	settings.beginGroup("SignalLoggerDialog");
+
+	if (settings.contains("format")) {
+		format_box_->setCurrentIndex(settings.value("format").toInt());
+	}
+	if (settings.contains("max_file_size")) {
+		max_file_size_box_->setValue(settings.value("max_file_size").toInt());
+	}
+	if (settings.contains("max_file_duration")) {
+		max_file_duration_box_->setValue(
+			settings.value("max_file_duration").toInt());
+	}
+	if (settings.contains("sync_interval")) {
+		sync_interval_box_->setValue(
+			settings.value("sync_interval").toDouble());
+	}
+	if (settings.contains("file_dialog_path")) {
+		file_dialog_path_ =
+			settings.value("file_dialog_path", QDir::homePath()).toString();
+	}
+
+	settings.endGroup();
+}
+
+void SignalLoggerDialog::accept()
+{
+	// Only handle AnalogSignals
+	vector<shared_ptr<sv::data::AnalogTimeSignal>> signals;
+	for (const auto &signal : device_tree_->checked_signals()) {
+		auto analog_signal =
+			dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
+		if (analog_signal)
+			signals.push_back(analog_signal);
+	}
+	if (signals.empty()) {
+		QMessageBox::critical(this, tr("Log Signals"),
+			tr("No signal selected."), QMessageBox::Ok);
+		return;
+	}
+
+	// The start time, a counter and the extension are added by the logger
+	QString file_name = QFileDialog::getSaveFileName(this,
+		tr("Log Signals"), file_dialog_path_);
+	if (file_name.isEmpty())
+		return;
+
+	file_dialog_path_ = QDir().absoluteFilePath(file_name);
+
+	const QFileInfo file_info(file_name);
+	QString base_name = file_info.absoluteFilePath();
+	if (!file_info.suffix().isEmpty())
+		base_name.chop(file_info.suffix().size() + 1);
+
+	const auto format =
+		(sv::data::LogFormat)format_box_->currentData().toInt();
+	const uint64_t max_file_size =
+		(uint64_t)max_file_size_box_->value() * 1024 * 1024;
+	const double max_file_duration = max_file_duration_box_->value() * 60.;
+
+	logger_ = make_shared<sv::data::SignalLogger>(signals,
+		base_name.toStdString(), format, max_file_size, max_file_duration,
+		sync_interval_box_->value());
+
+	QDialog::accept();
+}
+
+void SignalLoggerDialog::done(int result)
+{
+	QSettings settings;
+	save_settings(settings);
+
+	QDialog::done(result);
+}
+
+} // namespace dialogs
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,103 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_DIALOGS_SIGNALLOGGERDIALOG_HPP
+#define UI_DIALOGS_SIGNALLOGGERDIALOG_HPP
+
+#include <memory>
+
+#include <QComboBox>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QLineEdit>
+#include <QSettings>
+#include <QSpinBox>
+#include <QString>
+
+#include "src/session.hpp"
+
+using std::shared_ptr;
+
+namespace sv {
+
+namespace data {
+class SignalLogger;
+}
+
+namespace devices {
+class BaseDevice;
+}
+
+namespace ui {
+
+namespace devices {
+namespace devicetree {
+class DeviceTreeView;
+}
+}
+
+namespace dialogs {
+
+/**
+ * Select the signals and the file options for continuous logging.
+ *
+ * The logger is created, but not started, when the dialog is accepted.
+ */
+class SignalLoggerDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	SignalLoggerDialog(const Session &session,
+		const shared_ptr<sv::devices::BaseDevice> selected_device,
+		QWidget *parent = nullptr);
+
+	shared_ptr<sv::data::SignalLogger> logger() const;
+
+private:
+	void setup_ui();
+	void save_settings(QSettings &settings) const;
+	void restore_settings(QSettings &settings);
+
+	const Session &session_;
+	const shared_ptr<sv::devices::BaseDevice> selected_device_;
+	shared_ptr<sv::data::SignalLogger> logger_;
+
+	QLineEdit *filter_edit_;
+	ui::devices::devicetree::DeviceTreeView *device_tree_;
+	QComboBox *format_box_;
+	QSpinBox *max_file_size_box_;
+	QSpinBox *max_file_duration_box_;
+	QDoubleSpinBox *sync_interval_box_;
+	QDialogButtonBox *button_box_;
+	QString file_dialog_path_;
+
+public Q_SLOTS:
+	void accept() override;
+	/** The done() slot is handling the saving of the settings */
+	void done(int result) override;
+
+};
+
+} // namespace dialogs
+} // namespace ui
+} // namespace sv
+
+#endif // UI_DIALOGS_SIGNALLOGGERDIALOG_HPP
@@ -18,15 +18,15 @@
  */
 
 #include <cmath>
-#include <iostream>
-#include <fstream>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <QDebug>
 #include <QDir>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QFormLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -42,13 +42,16 @@
 #include "src/channels/basechannel.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/basesignal.hpp"
+#include "src/data/baseexporter.hpp"
+#include "src/data/csvexporter.hpp"
+#include "src/data/npyexporter.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/hardwaredevice.hpp"
 #include "src/ui/devices/devicetree/devicetreeview.hpp"
 
 using std::dynamic_pointer_cast;
-using std::ofstream;
 using std::string;
+using std::vector;
 
 Q_DECLARE_SMART_POINTER_METATYPE(std::shared_ptr)
 
@@ -61,7 +64,9 @@ SignalSaveDialog::SignalSaveDialog(const Session &session,
 		QWidget *parent) :
 	QDialog(parent),
 	session_(session),
-	selected_device_(selected_device)
+	selected_device_(selected_device),
+	exporter_(nullptr),
+	progress_dialog_(nullptr)
 {
 	setup_ui();
 
@@ -91,6 +96,13 @@ void SignalSaveDialog::setup_ui()
 		session_, false, false, false, true, false, false, false, false);
 	device_tree_->expand_device(selected_device_);
 	device_tree_->check_signals(selected_device_->signals());
+
+	filter_edit_ = new QLineEdit();
+	filter_edit_->setPlaceholderText(tr("Filter"));
+	filter_edit_->setClearButtonEnabled(true);
+	connect(filter_edit_, &QLineEdit::textChanged,
+		device_tree_, &ui::devices::devicetree::DeviceTreeView::set_filter);
+	main_layout->addWidget(filter_edit_);
 	main_layout->addWidget(device_tree_);
 
 	QFormLayout *form_layout = new QFormLayout();
@@ -131,244 +143,65 @@ void SignalSaveDialog::setup_ui()
 	this->setLayout(main_layout);
 }
 
-void SignalSaveDialog::save(const QString &file_name)
+void SignalSaveDialog::start_export(const QString &file_name)
 {
-	ofstream output_file;
-	string str_file_name = file_name.toStdString();
-	vector<size_t> sample_counts;
-
-	output_file.open(str_file_name);
-
-	auto signals = device_tree_->checked_signals();
-	bool relative_time = !time_absolut_->isChecked();
-	string sep = separator_edit_->text().toStdString();
-	size_t max_sample_count = 0;
-
-	// Header
-	string start_sep;
-	string device_header_line;
-	string chg_name_header_line;
-	string ch_name_header_line;
-	string signal_name_header_line;
-	for (const auto &signal : signals) {
-		// Only handle AnalogSignals
+	// Only handle AnalogSignals
+	vector<shared_ptr<sv::data::AnalogTimeSignal>> signals;
+	for (const auto &signal : device_tree_->checked_signals()) {
 		auto analog_signal =
 			dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
-		if (!analog_signal)
-			continue;
+		if (analog_signal)
+			signals.push_back(analog_signal);
+	}
 
-		size_t sample_count = analog_signal->sample_count();
-		if (sample_count > max_sample_count)
-			max_sample_count = sample_count;
-		sample_counts.push_back(sample_count);
-
-		string name = analog_signal->name();
-		shared_ptr<sv::channels::BaseChannel> parent_channel =
-			analog_signal->parent_channel();
-
-		qWarning() << "SaveDialog::save(): signal.name() = " <<
-			QString::fromStdString(name);
-		qWarning() << "SaveDialog::save(): signal.parent_channel().name() = " <<
-			QString::fromStdString(parent_channel->name());
-		qWarning() << "SaveDialog::save(): signal.parent_channel().parent_device().name() = " <<
-			QString::fromStdString(parent_channel->parent_device()->name());
-
-		string chg_names;
-		string chg_sep;
-		for (const auto &chg_name : parent_channel->channel_group_names()) {
-			chg_names += chg_sep;
-			if (chg_name.empty())
-				chg_names += "\"\"";
-			else
-				chg_names += chg_name;
-			// TODO: Ugly workaround. Implement escaping or quotation characters?
-			chg_sep = sep == "," ? "; " : ", ";
-		}
-
-		device_header_line += start_sep;
-		device_header_line += parent_channel->parent_device()->name(); // Time
-		device_header_line += sep;
-		device_header_line += parent_channel->parent_device()->name(); // Value
-		chg_name_header_line += start_sep;
-		chg_name_header_line += chg_names; // Time
-		chg_name_header_line += sep;
-		chg_name_header_line += chg_names; // Value
-		ch_name_header_line += start_sep;
-		ch_name_header_line += parent_channel->name(); // Time
-		ch_name_header_line += sep;
-		ch_name_header_line += parent_channel->name(); // Value
-		signal_name_header_line += start_sep;
-		signal_name_header_line += "Time ";
-		signal_name_header_line += name; // Time
-		signal_name_header_line += sep;
-		signal_name_header_line += name; // Value
-
-		start_sep = sep;
+	const QString suffix = QFileInfo(file_name).suffix().toLower();
+	if (suffix == "npy" || suffix == "npz") {
+		exporter_ = new sv::data::NpyExporter(signals, file_name.toStdString(),
+			suffix == "npz");
 	}
-	output_file << device_header_line << std::endl;
-	output_file << chg_name_header_line << std::endl;
-	output_file << ch_name_header_line << std::endl;
-	output_file << signal_name_header_line << std::endl;
-
-	// Data
-	// TODO: we asume here, that the vector size is the same for all vectors....
-	for (size_t index = 0; index < max_sample_count; index++) {
-		start_sep = "";
-		QString line("");
-		int sample_count_index = 0;
-		for (const auto &signal : signals) {
-			// Only handle AnalogSignals
-			auto analog_signal =
-				dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
-			if (!analog_signal)
-				continue;
-
-			QString time("");
-			QString value("");
-
-			size_t sample_count = sample_counts[sample_count_index];
-			if (index < sample_count-1) {
-				// More samples for this signal
-				auto sample = analog_signal->get_sample(index, relative_time);
-				value = QString("%1").arg(sample.second);
-				if (relative_time)
-					time = QString("%1").arg(sample.first, 0, 'f', 4);
-				else
-					time = util::format_time_date(sample.first);
-			}
-
-			line.append(QString("%1%2%3%4").arg(
-				QString::fromStdString(start_sep), time,
-				QString::fromStdString(sep), value));
-			start_sep = sep;
-
-			++sample_count_index;
-		}
-		output_file << line.toStdString() << std::endl;
+	else {
+		const bool combined = timestamps_combined_->isChecked();
+		double combined_timeframe = .0;
+		int combined_timeframe_ms = timestamps_combined_timeframe_->value();
+		if (combined_timeframe_ms != 0)
+			combined_timeframe = ((double)combined_timeframe_ms) / 1000;
+
+		exporter_ = new sv::data::CsvExporter(signals, file_name.toStdString(),
+			separator_edit_->text().toStdString(), !time_absolut_->isChecked(),
+			combined, combined_timeframe);
 	}
 
-	output_file.close();
+	progress_dialog_ = new QProgressDialog(tr("Saving signals ..."),
+		tr("Cancel"), 0, 1000, this);
+	progress_dialog_->setWindowModality(Qt::WindowModal);
+	progress_dialog_->setMinimumDuration(500);
+	progress_dialog_->setAutoClose(false);
+	progress_dialog_->setAutoReset(false);
+	progress_dialog_->setValue(0);
+
+	// The exporter signals are emitted in the export thread
+	connect(exporter_, &sv::data::BaseExporter::progress_changed,
+		progress_dialog_, &QProgressDialog::setValue, Qt::QueuedConnection);
+	connect(exporter_, &sv::data::BaseExporter::finished,
+		this, &SignalSaveDialog::on_export_finished, Qt::QueuedConnection);
+	connect(progress_dialog_, &QProgressDialog::canceled,
+		exporter_, &sv::data::BaseExporter::cancel);
+
+	button_box_->setEnabled(false);
+	exporter_->start();
 }
 
-void SignalSaveDialog::save_combined(const QString &file_name)
+void SignalSaveDialog::stop_export()
 {
-	ofstream output_file;
-	string str_file_name = file_name.toStdString();
-	vector<size_t> sample_counts;
-	vector<size_t> sample_pos;
-
-	output_file.open(str_file_name);
-
-	double combined_timeframe = .0;
-	int combined_timeframe_ms = timestamps_combined_timeframe_->value();
-	if (combined_timeframe_ms != 0)
-		combined_timeframe = ((double)combined_timeframe_ms) / 1000;
-
-	auto signals = device_tree_->checked_signals();
-	bool relative_time = !time_absolut_->isChecked();
-	string sep = separator_edit_->text().toStdString();
-
-	// Header
-	string device_header_line("Time"); // Time
-	string chg_name_header_line("Time"); // Time
-	string ch_name_header_line("Time"); // Time
-	string signal_name_header_line("Time"); // Time
-	for (const auto &signal : signals) {
-		// Only handle AnalogSignals
-		auto analog_signal =
-			dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
-		if (!analog_signal)
-			continue;
-
-		shared_ptr<sv::channels::BaseChannel> parent_channel =
-			analog_signal->parent_channel();
-
-		sample_counts.push_back(analog_signal->sample_count());
-		sample_pos.push_back(0);
-
-		string chg_names;
-		string chg_sep;
-		for (const auto &chg_name : parent_channel->channel_group_names()) {
-			chg_names += chg_sep;
-			if (chg_name.empty())
-				chg_names += "\"\"";
-			else
-				chg_names += chg_name;
-			// TODO: Ugly workaround. Implement escaping or quotation characters?
-			chg_sep = sep == "," ? "; " : ", ";
-		}
-
-		device_header_line += sep;
-		device_header_line += parent_channel->parent_device()->name(); // Value
-		chg_name_header_line += sep;
-		chg_name_header_line += chg_names; // Value
-		ch_name_header_line += sep;
-		ch_name_header_line += parent_channel->name(); // Value
-		signal_name_header_line += sep;
-		signal_name_header_line += analog_signal->name(); // Value
-	}
-	output_file << device_header_line << std::endl;
-	output_file << chg_name_header_line << std::endl;
-	output_file << ch_name_header_line << std::endl;
-	output_file << signal_name_header_line << std::endl;
-
-	// Data
-	while (true) {
-		double next_timestamp = -1;
-		int index = 0;
-		for (const auto &signal : signals) {
-			// Only handle AnalogSignals
-			auto analog_signal =
-				dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
-			if (!analog_signal)
-				continue;
-
-			if (sample_pos[index] >= sample_counts[index]-1)
-				continue;
-
-			double timestamp =
-				analog_signal->get_sample(sample_pos[index], relative_time).first;
-			if (next_timestamp < 0 || timestamp < next_timestamp)
-				next_timestamp = timestamp;
-
-			++index;
-		}
-
-		if (next_timestamp < 0)
-			break;
-
-		// Timestamp
-		QString line;
-		if (relative_time)
-			line = QString("%1").arg(next_timestamp, 0, 'f', 4);
-		else
-			line = util::format_time_date(next_timestamp);
-
-		// Values
-		index = 0;
-		for (const auto &signal : signals) {
-			// Only handle AnalogSignals
-			auto analog_signal =
-				dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
-			if (!analog_signal)
-				continue;
-
-			line.append(QString::fromStdString(sep));
-
-			auto sample =
-				analog_signal->get_sample(sample_pos[index], relative_time);
-			double timestamp = sample.first;
-			if (timestamp + combined_timeframe >= next_timestamp) {
-				line.append(QString("%1").arg(sample.second, 0, 'g', -1));
-				++sample_pos[index];
-			}
-
-			++index;
-		}
-		output_file << line.toStdString() << std::endl;
-	}
+	if (!exporter_)
+		return;
 
-	output_file.close();
+	// The destructor waits for the export thread.
+	delete exporter_;
+	exporter_ = nullptr;
+	progress_dialog_->deleteLater();
+	progress_dialog_ = nullptr;
+	button_box_->setEnabled(true);
 }
 
 bool SignalSaveDialog::validate_combined_timeframe()
@@ -378,41 +211,20 @@ bool SignalSaveDialog::validate_combined_timeframe()
 		return true;
 	const double combined_timeframe = ((double)combined_timeframe_ms) / 1000;
 
-	int num_signals = static_cast<int>(device_tree_->checked_signals().size());
-	int act_signal = 0;
-	QProgressDialog progress(tr("Validating combined timeframe ..."),
-		tr("Abort validation"), 0, num_signals, this);
-	progress.setMinimumDuration(500);
-	progress.setWindowModality(Qt::WindowModal);
-
+	// The intervals are tracked while the samples are pushed
 	double min_delta = combined_timeframe;
 	for (const auto &signal : device_tree_->checked_signals()) {
-		progress.setValue(act_signal++);
-		size_t count = signal->sample_count();
-		if (count < 2)
-			continue;
-
 		// Only handle AnalogSignals
 		auto analog_signal =
 			dynamic_pointer_cast<sv::data::AnalogTimeSignal>(signal);
 		if (!analog_signal)
 			continue;
 
-		double ts1 = analog_signal->get_sample(0, false).first;
-		for (size_t i = 1; i<count; i++) {
-			const double ts2 = analog_signal->get_sample(i, false).first;
-			const double delta = ts2 - ts1;
-			if (delta < min_delta)
-				min_delta = delta;
-			ts1 = ts2;
-
-			if (progress.wasCanceled())
-				return false;
-		}
+		const auto intervals = analog_signal->interval_statistics();
+		if (intervals.count() > 0 && intervals.min() < min_delta)
+			min_delta = intervals.min();
 	}
 
-	progress.setValue(num_signals);
-
 	if (min_delta < combined_timeframe) {
 		int min_delta_ms = (int)std::floor(min_delta * 1000);
 		QMessageBox::critical(this,
@@ -471,32 +283,54 @@ void SignalSaveDialog::accept()
 {
 	// Get file name
 	QString file_name = QFileDialog::getSaveFileName(this,
-		tr("Save CSV-File"), file_dialog_path_, tr("CSV Files (*.csv)"));
+		tr("Save Signals"), file_dialog_path_,
+		tr("CSV Files (*.csv);;NumPy Archive (*.npz);;NumPy Arrays (*.npy)"));
 	if (file_name.isEmpty())
 		return;
 
 	file_dialog_path_ = QDir().absoluteFilePath(file_name);
 
-	if (timestamps_combined_->isChecked()) {
-		if (!validate_combined_timeframe())
-			return;
-		save_combined(file_name);
-	}
-	else {
-		save(file_name);
-	}
+	// The time and separator options are only used for CSV files.
+	const QString suffix = QFileInfo(file_name).suffix().toLower();
+	if (suffix != "npy" && suffix != "npz" &&
+			timestamps_combined_->isChecked() && !validate_combined_timeframe())
+		return;
 
-	QDialog::accept();
+	// The dialog is accepted, when the export has finished.
+	start_export(file_name);
 }
 
 void SignalSaveDialog::done(int result)
 {
+	if (exporter_) {
+		exporter_->cancel();
+		stop_export();
+	}
+
 	QSettings settings;
 	save_settings(settings);
 
 	QDialog::done(result);
 }
 
+void SignalSaveDialog::on_export_finished(bool success, const QString &error)
+{
+	// The export could already be stopped by done()
+	if (!exporter_)
+		return;
+
+	const bool canceled = progress_dialog_->wasCanceled();
+	stop_export();
+
+	if (success) {
+		QDialog::accept();
+	}
+	else if (!canceled) {
+		QMessageBox::critical(this, tr("Save Signals"), error,
+			QMessageBox::Ok);
+	}
+}
+
 void SignalSaveDialog::toggle_combined()
 {
 	timestamps_combined_timeframe_->setDisabled(
@@ -27,6 +27,7 @@
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QLineEdit>
+#include <QProgressDialog>
 #include <QSettings>
 #include <QSpinBox>
 #include <QString>
@@ -39,6 +40,10 @@ using std::vector;
 
 namespace sv {
 
+namespace data {
+class BaseExporter;
+}
+
 namespace devices {
 class BaseDevice;
 }
@@ -64,8 +69,8 @@ public:
 
 private:
 	void setup_ui();
-	void save(const QString &file_name);
-	void save_combined(const QString &file_name);
+	void start_export(const QString &file_name);
+	void stop_export();
 	bool validate_combined_timeframe();
 	void save_settings(QSettings &settings) const;
 	void restore_settings(QSettings &settings);
@@ -73,6 +78,7 @@ private:
 	const Session &session_;
 	const shared_ptr<sv::devices::BaseDevice> selected_device_;
 
+	QLineEdit *filter_edit_;
 	ui::devices::devicetree::DeviceTreeView *device_tree_;
 	QCheckBox *timestamps_combined_;
 	QSpinBox *timestamps_combined_timeframe_;
@@ -80,6 +86,8 @@ private:
 	QLineEdit *separator_edit_;
 	QDialogButtonBox *button_box_;
 	QString file_dialog_path_;
+	sv::data::BaseExporter *exporter_;
+	QProgressDialog *progress_dialog_;
 
 public Q_SLOTS:
 	void accept() override;
@@ -88,6 +96,7 @@ public Q_SLOTS:
 
 private Q_SLOTS:
 	void toggle_combined();
+	void on_export_finished(bool success, const QString &error);
 
 };
 
@@ -32,11 +32,13 @@
 #include "devicetab.hpp"
 #include "src/session.hpp"
 #include "src/channels/userchannel.hpp"
+#include "src/data/signallogger.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/deviceutil.hpp"
 #include "src/ui/dialogs/aboutdialog.hpp"
 #include "src/ui/dialogs/addmathchanneldialog.hpp"
 #include "src/ui/dialogs/addviewdialog.hpp"
+#include "src/ui/dialogs/signalloggerdialog.hpp"
 #include "src/ui/dialogs/signalsavedialog.hpp"
 #include "src/ui/tabs/basetab.hpp"
 #include "src/ui/tabs/tabdockwidget.hpp"
@@ -57,6 +59,7 @@ DeviceTab::DeviceTab(Session &session,
 	device_(device),
 	action_aquire_(new QAction(this)),
 	action_save_as_(new QAction(this)),
+	action_log_(new QAction(this)),
 	action_add_control_view_(new QAction(this)),
 	action_add_panel_view_(new QAction(this)),
 	action_add_plot_view_(new QAction(this)),
@@ -113,6 +116,16 @@ void DeviceTab::setup_toolbar()
 	connect(action_save_as_, &QAction::triggered,
 		this, &DeviceTab::on_action_save_as_triggered);
 
+	action_log_->setText(tr("&Log Signals..."));
+	action_log_->setIconText("");
+	action_log_->setIcon(
+		QIcon::fromTheme("document-save-as",
+		QIcon(":/icons/document-save-as.png")));
+	action_log_->setCheckable(true);
+	action_log_->setChecked(false);
+	connect(action_log_, &QAction::triggered,
+		this, &DeviceTab::on_action_log_triggered);
+
 	action_add_control_view_->setText(tr("Add Control"));
 	action_add_control_view_->setIcon(
 		QIcon::fromTheme("mixer-front",
@@ -161,6 +174,7 @@ void DeviceTab::setup_toolbar()
 	toolbar_->addWidget(aquire_button_);
 	toolbar_->addSeparator();
 	toolbar_->addAction(action_save_as_);
+	toolbar_->addAction(action_log_);
 	toolbar_->addSeparator();
 	toolbar_->addAction(action_add_control_view_);
 	toolbar_->addAction(action_add_panel_view_);
@@ -248,6 +262,51 @@ void DeviceTab::on_action_save_as_triggered()
 	dlg.exec();
 }
 
+void DeviceTab::on_action_log_triggered()
+{
+	if (!action_log_->isChecked()) {
+		// The logger is released, when the writer thread has finished.
+		logger_->stop();
+		action_log_->setEnabled(false);
+		action_log_->setText(tr("&Log Signals..."));
+		return;
+	}
+
+	ui::dialogs::SignalLoggerDialog dlg(session(), device_);
+	if (!dlg.exec() || !dlg.logger()) {
+		action_log_->setChecked(false);
+		return;
+	}
+
+	logger_ = dlg.logger();
+	// The signals are emitted in the writer thread
+	connect(logger_.get(), &sv::data::SignalLogger::error_occurred,
+		this, &DeviceTab::on_logger_error, Qt::QueuedConnection);
+	connect(logger_.get(), &sv::data::SignalLogger::finished,
+		this, &DeviceTab::on_logger_finished, Qt::QueuedConnection);
+	logger_->start();
+	action_log_->setText(tr("Stop Logging"));
+}
+
+void DeviceTab::on_logger_error(const QString &error)
+{
+	// The logger doesn't write anymore after an error
+	if (logger_ && action_log_->isChecked()) {
+		logger_->stop();
+		action_log_->setChecked(false);
+		action_log_->setEnabled(false);
+		action_log_->setText(tr("&Log Signals..."));
+	}
+	QMessageBox::critical(this, tr("Log Signals"), error, QMessageBox::Ok);
+}
+
+void DeviceTab::on_logger_finished()
+{
+	// The writer thread has finished, so the destructor doesn't block
+	logger_ = nullptr;
+	action_log_->setEnabled(true);
+}
+
 void DeviceTab::on_action_add_control_view_triggered()
 {
 	shared_ptr<sv::devices::BaseDevice> device = nullptr;
@@ -39,6 +39,10 @@ namespace sv {
 
 class Session;
 
+namespace data {
+class SignalLogger;
+}
+
 namespace ui {
 namespace tabs {
 
@@ -70,6 +74,7 @@ private:
 
 	QAction *const action_aquire_;
 	QAction *const action_save_as_;
+	QAction *const action_log_;
 	QAction *const action_add_control_view_;
 	QAction *const action_add_panel_view_;
 	QAction *const action_add_plot_view_;
@@ -77,12 +82,16 @@ private:
 	QAction *const action_add_math_channel_;
 	QAction *const action_about_;
 	QToolBar *toolbar_;
+	shared_ptr<sv::data::SignalLogger> logger_;
 
 public Q_SLOTS:
 
 private Q_SLOTS:
 	void on_action_aquire_triggered();
 	void on_action_save_as_triggered();
+	void on_action_log_triggered();
+	void on_logger_error(const QString &error);
+	void on_logger_finished();
 	void on_action_add_control_view_triggered();
 	void on_action_add_panel_view_triggered();
 	void on_action_add_plot_view_triggered();
@@ -83,8 +83,10 @@ void OscilloscopeTab::setup_ui()
 			continue;
 
 		//shared_ptr<data::AnalogScopeSignal> signal; // TODO
-		auto signal = static_pointer_cast<data::AnalogTimeSignal>(
+		auto signal = dynamic_pointer_cast<data::AnalogTimeSignal>(
 			channel->actual_signal());
+		if (!signal)
+			continue;
 		++added_channels;
 
 		// TODO: Voltage plot
@@ -93,8 +93,10 @@ void SourceSinkTab::setup_ui()
 		shared_ptr<data::AnalogTimeSignal> current_signal;
 		for (const auto &channel : chg_pair.second) {
 			if (channel->fixed_signal()) {
-				auto signal = static_pointer_cast<data::AnalogTimeSignal>(
+				auto signal = dynamic_pointer_cast<data::AnalogTimeSignal>(
 					channel->actual_signal());
+				if (!signal)
+					continue;
 
 				// Only plot voltage and current
 				if (signal->quantity() == data::Quantity::Voltage) {
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QString>
+#include <QVariant>
+
+#include "datatablemodel.hpp"
+#include "src/util.hpp"
+#include "src/data/analogbasesignal.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/timestamprows.hpp"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace views {
+
+const size_t DataTableModel::ChunkSize = 65536;
+
+DataTableModel::DataTableModel(QObject *parent) :
+	QAbstractTableModel(parent),
+	row_count_(0),
+	needs_rebuild_(false)
+{
+}
+
+void DataTableModel::add_signal(shared_ptr<sv::data::AnalogTimeSignal> signal)
+{
+	const int column = (int)signals_.size() + 1;
+	beginInsertColumns(QModelIndex(), column, column);
+	signals_.push_back(signal);
+	next_signal_pos_.push_back(0);
+	last_signal_timestamp_.push_back(0.);
+	endInsertColumns();
+
+	// The samples of the new signal are older than the existing rows.
+	needs_rebuild_ = true;
+
+	connect(signal.get(), &sv::data::AnalogBaseSignal::samples_cleared,
+		this, &DataTableModel::on_signal_changed);
+	connect(signal.get(),
+		&sv::data::AnalogTimeSignal::signal_start_timestamp_changed,
+		this, &DataTableModel::on_signal_changed);
+}
+
+bool DataTableModel::update()
+{
+	if (needs_rebuild_) {
+		rebuild();
+		return true;
+	}
+
+	if (!add_new_samples()) {
+		rebuild();
+		return true;
+	}
+
+	const size_t moved_row = rows_.first_moved_row();
+	rows_.reset_moved_rows();
+	const int old_row_count = row_count_;
+	const int row_count = (int)std::min(rows_.size(),
+		(size_t)std::numeric_limits<int>::max());
+
+	if (row_count > old_row_count) {
+		beginInsertRows(QModelIndex(), old_row_count, row_count - 1);
+		row_count_ = row_count;
+		endInsertRows();
+	}
+	// Rows were inserted in front of existing rows, the view must fetch the
+	// moved rows again.
+	if ((int)moved_row < old_row_count) {
+		Q_EMIT dataChanged(index((int)moved_row, 0),
+			index(old_row_count - 1, columnCount() - 1));
+	}
+
+	return row_count > old_row_count;
+}
+
+int DataTableModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return row_count_;
+}
+
+int DataTableModel::columnCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return (int)signals_.size() + 1;
+}
+
+QVariant DataTableModel::data(const QModelIndex &index, int role) const
+{
+	if (role != Qt::DisplayRole || !index.isValid() ||
+			index.row() >= row_count_)
+		return QVariant();
+
+	const double timestamp = rows_.at((size_t)index.row());
+	if (index.column() == 0)
+		return QString::number(timestamp, 'f', 3);
+
+	const size_t signal_index = (size_t)index.column() - 1;
+	double value;
+	if (!find_value(signal_index, timestamp, value))
+		return QVariant();
+
+	const int sr_digits = signals_[signal_index]->sr_digits();
+	const int prefix = util::prefix_from_value(value, sr_digits);
+	const int decimal_places =
+		util::decimal_places_from_prefix(prefix, sr_digits);
+	return QString::number(value, 'f', decimal_places);
+}
+
+QVariant DataTableModel::headerData(int section, Qt::Orientation orientation,
+	int role) const
+{
+	if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+		if (section == 0)
+			return tr("Time [s]");
+		if (section <= (int)signals_.size())
+			return signals_[section - 1]->display_name();
+		return QVariant();
+	}
+	if (orientation == Qt::Horizontal && role == Qt::TextAlignmentRole)
+		return QVariant(Qt::AlignVCenter);
+
+	return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+void DataTableModel::rebuild()
+{
+	beginResetModel();
+	rows_.clear();
+	std::fill(next_signal_pos_.begin(), next_signal_pos_.end(), 0);
+	needs_rebuild_ = false;
+	// The samples of all signals are merged in one batch, so this can't fail.
+	add_new_samples();
+	rows_.reset_moved_rows();
+	row_count_ = (int)std::min(rows_.size(),
+		(size_t)std::numeric_limits<int>::max());
+	endResetModel();
+}
+
+bool DataTableModel::add_new_samples()
+{
+	/*
+	 * Collect the new timestamps of all signals. Each signal is sorted, so
+	 * the sorted runs only have to be merged.
+	 */
+	vector<double> new_timestamps;
+	vector<size_t> run_ends;
+	for (size_t i=0; i<signals_.size(); ++i) {
+		const auto &signal = signals_[i];
+		const size_t sample_count = signal->sample_count();
+		while (next_signal_pos_[i] < sample_count) {
+			const size_t count = signal->get_samples(next_signal_pos_[i],
+				std::min(next_signal_pos_[i] + ChunkSize, sample_count),
+				timestamps_, values_, true);
+			if (count == 0)
+				break;
+			new_timestamps.insert(new_timestamps.end(),
+				timestamps_.begin(), timestamps_.end());
+			last_signal_timestamp_[i] = timestamps_.back();
+			next_signal_pos_[i] += count;
+		}
+		if (!run_ends.empty() && run_ends.back() > 0) {
+			std::inplace_merge(new_timestamps.begin(),
+				new_timestamps.begin() + run_ends.back(), new_timestamps.end());
+		}
+		run_ends.push_back(new_timestamps.size());
+	}
+
+	const double *last = nullptr;
+	for (const double &timestamp : new_timestamps) {
+		if (last && *last == timestamp)
+			continue;
+		if (!rows_.add(timestamp))
+			return false;
+		last = &timestamp;
+	}
+
+	/*
+	 * New samples of a signal are newer than its last sample, so no rows
+	 * can be inserted before the oldest last sample of all signals anymore.
+	 * Signals without samples are ignored, otherwise they would hold back
+	 * all rows.
+	 */
+	bool has_horizon = false;
+	double horizon = 0.;
+	for (size_t i=0; i<signals_.size(); ++i) {
+		if (next_signal_pos_[i] == 0)
+			continue;
+		if (!has_horizon || last_signal_timestamp_[i] < horizon)
+			horizon = last_signal_timestamp_[i];
+		has_horizon = true;
+	}
+	if (has_horizon)
+		rows_.set_horizon(horizon);
+
+	return true;
+}
+
+bool DataTableModel::find_value(size_t signal_index, double timestamp,
+	double &value) const
+{
+	const auto &signal = signals_[signal_index];
+	const size_t pos = signal->find_sample_pos(timestamp, true);
+
+	// The relative timestamp of the row may be rounded differently, than
+	// the absolute timestamp in the signal, so also check the sample before.
+	const size_t positions[] = { pos, pos - 1 };
+	for (const size_t p : positions) {
+		if (p >= next_signal_pos_[signal_index])
+			continue;
+		const auto sample = signal->get_sample(p, true);
+		if (sample.first == timestamp) {
+			value = sample.second;
+			return true;
+		}
+	}
+	return false;
+}
+
+void DataTableModel::on_signal_changed()
+{
+	// The relative timestamps of the rows aren't valid anymore.
+	needs_rebuild_ = true;
+}
+
+} // namespace views
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,114 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_VIEWS_DATATABLEMODEL_HPP
+#define UI_VIEWS_DATATABLEMODEL_HPP
+
+#include <memory>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QObject>
+#include <QVariant>
+
+#include "src/data/timestamprows.hpp"
+
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace ui {
+namespace views {
+
+/**
+ * Table model with one row per distinct timestamp of the signals, the first
+ * column shows the timestamp, the other columns show the sample values of
+ * the signals.
+ *
+ * Only the timestamps of the rows are stored in the model. The values are
+ * read from the signals and formatted when the view requests a cell, so
+ * only the visible cells are touched.
+ */
+class DataTableModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	explicit DataTableModel(QObject *parent = nullptr);
+
+	void add_signal(shared_ptr<sv::data::AnalogTimeSignal> signal);
+
+	/**
+	 * Add the new samples of the signals to the rows. Returns true, when
+	 * rows were added.
+	 */
+	bool update();
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index,
+		int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation,
+		int role = Qt::DisplayRole) const override;
+
+private:
+	void rebuild();
+	/**
+	 * Add the new samples of the signals. Returns false, when the rows must
+	 * be rebuilt.
+	 */
+	bool add_new_samples();
+	/**
+	 * Find the sample with `timestamp` (relative time) in the already
+	 * added samples of the signal.
+	 */
+	bool find_value(size_t signal_index, double timestamp,
+		double &value) const;
+
+	vector<shared_ptr<sv::data::AnalogTimeSignal>> signals_;
+	vector<size_t> next_signal_pos_;
+	/** Timestamp of the last added sample of each signal. */
+	vector<double> last_signal_timestamp_;
+	sv::data::TimestampRows rows_;
+	/** Number of rows, the view knows about. */
+	int row_count_;
+	bool needs_rebuild_;
+
+	/** Buffers for reading the signals in chunks. */
+	vector<double> timestamps_;
+	vector<double> values_;
+
+	static const size_t ChunkSize;
+
+private Q_SLOTS:
+	void on_signal_changed();
+
+};
+
+} // namespace views
+} // namespace ui
+} // namespace sv
+
+#endif // UI_VIEWS_DATATABLEMODEL_HPP
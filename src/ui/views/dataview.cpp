@@ -18,22 +18,21 @@
  */
 
 #include <memory>
-#include <mutex>
 #include <set>
 #include <string>
 
 #include <QAction>
 #include <QDebug>
+#include <QHeaderView>
 #include <QList>
 #include <QSettings>
-#include <QScrollBar>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
 #include <QToolBar>
 #include <QUuid>
 #include <QVBoxLayout>
 
 #include "dataview.hpp"
+#include "src/renderscheduler.hpp"
 #include "src/session.hpp"
 #include "src/settingsmanager.hpp"
 #include "src/util.hpp"
@@ -44,6 +43,7 @@
 #include "src/devices/basedevice.hpp"
 #include "src/ui/dialogs/selectsignaldialog.hpp"
 #include "src/ui/views/baseview.hpp"
+#include "src/ui/views/datatablemodel.hpp"
 #include "src/ui/views/viewhelper.hpp"
 
 using std::shared_ptr;
@@ -63,6 +63,14 @@ DataView::DataView(Session &session, QUuid uuid, QWidget *parent) :
 
 	setup_ui();
 	setup_toolbar();
+
+	session_.render_scheduler()->add_client(this, 200,
+		[this](bool) { this->populate_table(); });
+}
+
+DataView::~DataView()
+{
+	session_.render_scheduler()->remove_client(this);
 }
 
 QString DataView::title() const
@@ -77,11 +85,11 @@ void DataView::setup_ui()
 {
 	QVBoxLayout *layout = new QVBoxLayout();
 
-	data_table_ = new QTableWidget();
-	data_table_->setColumnCount(1);
-	QTableWidgetItem *time_header_item = new QTableWidgetItem(tr("Time [s]"));
-	time_header_item->setTextAlignment(Qt::AlignVCenter);
-	data_table_->setHorizontalHeaderItem(0, time_header_item);
+	data_model_ = new DataTableModel(this);
+	data_table_ = new QTableView();
+	data_table_->setModel(data_model_);
+	// Don't measure the rows, there may be millions of them.
+	data_table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 	data_table_->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
 	layout->addWidget(data_table_);
 
@@ -149,89 +157,16 @@ void DataView::restore_settings(QSettings &settings,
 void DataView::add_signal(shared_ptr<sv::data::AnalogTimeSignal> signal)
 {
 	signals_.push_back(signal);
-	next_signal_pos_.push_back(0);
-	last_timestamp_.push_back(nullptr);
-	int pos = static_cast<int>(signals_.size());
-
-	QTableWidgetItem *value_header_item = new QTableWidgetItem(
-		signal->display_name());
-	value_header_item->setTextAlignment(Qt::AlignVCenter);
-	data_table_->insertColumn(pos);
-	data_table_->setHorizontalHeaderItem(pos, value_header_item);
+	data_model_->add_signal(signal);
 
 	this->populate_table();
-	connect(signal.get(), &data::AnalogBaseSignal::sample_appended,
-		this, &DataView::populate_table);
 
 	Q_EMIT title_changed();
 }
 
 void DataView::populate_table()
 {
-	std::unique_lock<std::mutex> lock(populate_mutex_, std::try_to_lock);
-	if (!lock.owns_lock())
-		return;
-
-	for (size_t i=0; i<signals_.size(); ++i) {
-		size_t signal_size = signals_[i]->sample_count();
-		while (next_signal_pos_[i] < signal_size) {
-			auto sample = signals_[i]->get_sample(next_signal_pos_[i], true);
-			int row_count  = data_table_->rowCount();
-
-			int last_row  = -1;
-			if (last_timestamp_[i])
-				last_row = data_table_->row(last_timestamp_[i]);
-
-			bool new_row = false;
-			if (row_count <= last_row+1) {
-				data_table_->insertRow(last_row+1);
-				new_row = true;
-			}
-			else {
-				// Find position of new sample
-				while (last_row+1 < row_count) {
-					auto *item = data_table_->item(last_row+1, 0);
-					double timestamp = item->data(0).toDouble();
-					if (timestamp > sample.first) {
-						data_table_->insertRow(last_row+1);
-						new_row = true;
-						break;
-					}
-					if (timestamp == sample.first) {
-						last_timestamp_[i] = item;
-						new_row = false;
-						break;
-					}
-					if (row_count == last_row+2) {
-						++last_row;
-						data_table_->insertRow(last_row+1);
-						new_row = true;
-						break;
-					}
-					last_row++;
-				}
-			}
-
-			if (new_row) {
-				QTableWidgetItem *time_item = new QTableWidgetItem(
-					QString::number(sample.first, 'f', 3));
-				time_item->setData(0, QVariant(sample.first));
-				data_table_->setItem(last_row+1, 0, time_item);
-				last_timestamp_[i] = time_item;
-			}
-			int prefix = util::prefix_from_value(
-				sample.second, signals_[i]->sr_digits());
-			int decimal_places = util::decimal_places_from_prefix(
-				prefix, signals_[i]->sr_digits());
-			QTableWidgetItem *value_item = new QTableWidgetItem(
-				QString::number(sample.second, 'f', decimal_places));
-			value_item->setData(0, QVariant(sample.second));
-			data_table_->setItem(last_row+1, (int)i+1, value_item);
-
-			++next_signal_pos_[i];
-		}
-	}
-	if (auto_scroll_)
+	if (data_model_->update() && auto_scroll_)
 		data_table_->scrollToBottom();
 }
 
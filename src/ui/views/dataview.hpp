@@ -21,12 +21,11 @@
 #define UI_VIEWS_DATAVIEW_HPP
 
 #include <memory>
-#include <mutex>
 #include <vector>
 
 #include <QAction>
 #include <QSettings>
-#include <QTableWidget>
+#include <QTableView>
 #include <QToolBar>
 #include <QUuid>
 
@@ -49,6 +48,8 @@ class BaseDevice;
 namespace ui {
 namespace views {
 
+class DataTableModel;
+
 class DataView : public BaseView
 {
 	Q_OBJECT
@@ -56,6 +57,7 @@ class DataView : public BaseView
 public:
 	explicit DataView(Session& session, QUuid uuid = QUuid(),
 		QWidget* parent = nullptr);
+	~DataView();
 
 	QString title() const override;
 	void add_signal(shared_ptr<sv::data::AnalogTimeSignal> signal);
@@ -67,21 +69,20 @@ public:
 
 private:
 	vector<shared_ptr<sv::data::AnalogTimeSignal>> signals_;
-	vector<size_t> next_signal_pos_;
-	vector<QTableWidgetItem *> last_timestamp_;
 	bool auto_scroll_;
-	std::mutex populate_mutex_;
 
 	QAction *const action_auto_scroll_;
 	QAction *const action_add_signal_;
 	QToolBar *toolbar_;
-	QTableWidget *data_table_;
+	DataTableModel *data_model_;
+	QTableView *data_table_;
 
 	void setup_ui();
 	void setup_toolbar();
+	/** Called by the render scheduler of the session. */
+	void populate_table();
 
 private Q_SLOTS:
-	void populate_table();
 	void on_action_auto_scroll_triggered();
 	void on_action_add_signal_triggered();
 
@@ -21,6 +21,8 @@
 
 #include <QAction>
 #include <QDebug>
+#include <QDir>
+#include <QFileDialog>
 #include <QMessageBox>
 #include <QSettings>
 #include <QToolBar>
@@ -34,6 +36,7 @@
 #include "src/util.hpp"
 #include "src/channels/basechannel.hpp"
 #include "src/data/basesignal.hpp"
+#include "src/data/npyimporter.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/devices/hardwaredevice.hpp"
 #include "src/devices/userdevice.hpp"
@@ -59,6 +62,7 @@ DevicesView::DevicesView(Session &session, QUuid uuid, QWidget *parent) :
 	BaseView(session, uuid, parent),
 	action_add_device_(new QAction(this)),
 	action_add_userdevice_(new QAction(this)),
+	action_import_npy_(new QAction(this)),
 	action_disconnect_device_(new QAction(this))
 {
 	id_ = "devices:" + util::format_uuid(uuid_);
@@ -100,6 +104,13 @@ void DevicesView::setup_toolbar()
 	connect(action_add_userdevice_, &QAction::triggered,
 		this, &DevicesView::on_action_add_userdevice_triggered);
 
+	action_import_npy_->setText(tr("Import NumPy signals"));
+	action_import_npy_->setIcon(
+		QIcon::fromTheme("document-open",
+		QIcon(":/icons/document-open.png")));
+	connect(action_import_npy_, &QAction::triggered,
+		this, &DevicesView::on_action_import_npy_triggered);
+
 	action_disconnect_device_->setText(tr("Disconnect device"));
 	action_disconnect_device_->setIcon(
 		QIcon::fromTheme("edit-delete",
@@ -110,6 +121,7 @@ void DevicesView::setup_toolbar()
 	toolbar_ = new QToolBar("Device Tree Toolbar");
 	toolbar_->addAction(action_add_device_);
 	toolbar_->addAction(action_add_userdevice_);
+	toolbar_->addAction(action_import_npy_);
 	toolbar_->addSeparator();
 	toolbar_->addAction(action_disconnect_device_);
 	this->addToolBar(Qt::TopToolBarArea, toolbar_);
@@ -153,6 +165,25 @@ void DevicesView::on_action_add_userdevice_triggered()
 	session().main_window()->add_device_tab(device);
 }
 
+void DevicesView::on_action_import_npy_triggered()
+{
+	QString file_name = QFileDialog::getOpenFileName(this,
+		tr("Import NumPy Signals"), QDir::homePath(),
+		tr("SmuView NumPy Export (*.json)"));
+	if (file_name.isEmpty())
+		return;
+
+	auto device = session().add_user_device();
+	QString error = sv::data::NpyImporter(file_name).import(device);
+	if (!error.isEmpty()) {
+		session().remove_device(device);
+		QMessageBox::critical(this, tr("Import NumPy Signals"), error,
+			QMessageBox::Ok);
+		return;
+	}
+	session().main_window()->add_device_tab(device);
+}
+
 void DevicesView::on_action_disconnect_device_triggered()
 {
 	TreeItem *item = device_tree_->selected_item();
@@ -67,6 +67,7 @@ public:
 private:
 	QAction *const action_add_device_;
 	QAction *const action_add_userdevice_;
+	QAction *const action_import_npy_;
 	QAction *const action_disconnect_device_;
 	QToolBar *toolbar_;
 	devices::devicetree::DeviceTreeView  *device_tree_;
@@ -78,6 +79,7 @@ private:
 private Q_SLOTS:
 	void on_action_add_device_triggered();
 	void on_action_add_userdevice_triggered();
+	void on_action_import_npy_triggered();
 	void on_action_disconnect_device_triggered();
 
 };
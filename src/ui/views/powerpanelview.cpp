@@ -17,19 +17,19 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
 
 #include <QApplication>
-#include <QDateTime>
 #include <QDebug>
 #include <QSettings>
-#include <QTimer>
 #include <QUuid>
 #include <QVBoxLayout>
 
 #include "powerpanelview.hpp"
+#include "src/renderscheduler.hpp"
 #include "src/session.hpp"
 #include "src/settingsmanager.hpp"
 #include "src/util.hpp"
@@ -37,12 +37,15 @@
 #include "src/data/analogbasesignal.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/energyaccumulator.hpp"
+#include "src/data/energymeter.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/views/baseview.hpp"
 #include "src/ui/views/viewhelper.hpp"
 #include "src/ui/widgets/monofontdisplay.hpp"
 
 using std::dynamic_pointer_cast;
+using std::make_shared;
 using std::set;
 using std::shared_ptr;
 using sv::data::QuantityFlag;
@@ -55,16 +58,6 @@ PowerPanelView::PowerPanelView(Session &session, QUuid uuid, QWidget *parent) :
 	BaseView(session, uuid, parent),
 	voltage_signal_(nullptr),
 	current_signal_(nullptr),
-	voltage_min_(std::numeric_limits<double>::max()),
-	voltage_max_(std::numeric_limits<double>::lowest()),
-	current_min_(std::numeric_limits<double>::max()),
-	current_max_(std::numeric_limits<double>::lowest()),
-	resistance_min_(std::numeric_limits<double>::max()),
-	resistance_max_(std::numeric_limits<double>::lowest()),
-	power_min_(std::numeric_limits<double>::max()),
-	power_max_(std::numeric_limits<double>::lowest()),
-	actual_amp_hours_(0),
-	actual_watt_hours_(0),
 	action_reset_displays_(new QAction(this))
 {
 	id_ = "powerpanel:" + util::format_uuid(uuid_);
@@ -74,7 +67,6 @@ PowerPanelView::PowerPanelView(Session &session, QUuid uuid, QWidget *parent) :
 	connect_signals();
 	reset_displays();
 
-	timer_ = new QTimer(this);
 	init_timer();
 }
 
@@ -104,6 +96,10 @@ void PowerPanelView::set_signals(
 	stop_timer();
 	voltage_signal_ = voltage_signal;
 	current_signal_ = current_signal;
+	// The old meter is destroyed after its running slot has finished.
+	energy_meter_ = make_shared<sv::data::EnergyMeter>(
+		voltage_signal_, current_signal_);
+	energy_meter_->start();
 	init_timer();
 	init_displays();
 	connect_signals();
@@ -380,31 +376,16 @@ void PowerPanelView::reset_displays()
 
 void PowerPanelView::init_timer()
 {
-	start_time_ = QDateTime::currentMSecsSinceEpoch();
-	last_time_ = start_time_;
-
-	voltage_min_ = std::numeric_limits<double>::max();
-	voltage_max_ = std::numeric_limits<double>::lowest();
-	current_min_ = std::numeric_limits<double>::max();
-	current_max_ = std::numeric_limits<double>::lowest();
-	resistance_min_ = std::numeric_limits<double>::max();
-	resistance_max_ = std::numeric_limits<double>::lowest();
-	power_min_ = std::numeric_limits<double>::max();
-	power_max_ = std::numeric_limits<double>::lowest();
-	actual_amp_hours_ = 0;
-	actual_watt_hours_ = 0;
-
-	connect(timer_, &QTimer::timeout, this, &PowerPanelView::on_update);
-	timer_->start(250);
+	session_.render_scheduler()->add_client(this, 250,
+		[this](bool) { this->on_update(); });
 }
 
 void PowerPanelView::stop_timer()
 {
-	if (!timer_->isActive())
+	if (!session_.render_scheduler()->has_client(this))
 		return;
 
-	timer_->stop();
-	disconnect(timer_, &QTimer::timeout, this, &PowerPanelView::on_update);
+	session_.render_scheduler()->remove_client(this);
 
 	reset_displays();
 }
@@ -415,62 +396,45 @@ void PowerPanelView::on_update()
 			!current_signal_ || current_signal_->sample_count() == 0)
 		return;
 
-	qint64 now = QDateTime::currentMSecsSinceEpoch();
-	double elapsed_time = (double)(now - last_time_) / (double)3600000; // / 1h
-	last_time_ = now;
-
 	double voltage = voltage_signal_->last_value();
-	if (voltage_min_ > voltage)
-		voltage_min_ = voltage;
-	if (voltage_max_ < voltage)
-		voltage_max_ = voltage;
-
 	double current = current_signal_->last_value();
-	if (current_min_ > current)
-		current_min_ = current;
-	if (current_max_ < current)
-		current_max_ = current;
-
 	double resistance = current == 0. ?
 		std::numeric_limits<double>::max() : voltage / current;
-	if (resistance_min_ > resistance)
-		resistance_min_ = resistance;
-	if (resistance_max_ < resistance)
-		resistance_max_ = resistance;
-
 	double power = voltage * current;
-	if (power_min_ > power)
-		power_min_ = power;
-	if (power_max_ < power)
-		power_max_ = power;
-
-	actual_amp_hours_ = actual_amp_hours_ + (current * elapsed_time);
-	actual_watt_hours_ = actual_watt_hours_ + (power * elapsed_time);
 
 	voltage_display_->set_value(voltage);
-	voltage_min_display_->set_value(voltage_min_);
-	voltage_max_display_->set_value(voltage_max_);
-
 	current_display_->set_value(current);
-	current_min_display_->set_value(current_min_);
-	current_max_display_->set_value(current_max_);
-
 	resistance_display_->set_value(resistance);
-	resistance_min_display_->set_value(resistance_min_);
-	resistance_max_display_->set_value(resistance_max_);
-
 	power_display_->set_value(power);
-	power_min_display_->set_value(power_min_);
-	power_max_display_->set_value(power_max_);
 
-	amp_hour_display_->set_value(actual_amp_hours_);
-	watt_hour_display_->set_value(actual_watt_hours_);
+	// The min/max values and Ah/Wh are only valid, when the meter has
+	// accounted time aligned samples of both signals.
+	const sv::data::EnergyAccumulator energy = energy_meter_->snapshot();
+	if (energy.voltage().count() > 0) {
+		voltage_min_display_->set_value(energy.voltage().min());
+		voltage_max_display_->set_value(energy.voltage().max());
+	}
+	if (energy.current().count() > 0) {
+		current_min_display_->set_value(energy.current().min());
+		current_max_display_->set_value(energy.current().max());
+	}
+	if (energy.resistance().count() > 0) {
+		resistance_min_display_->set_value(energy.resistance().min());
+		resistance_max_display_->set_value(energy.resistance().max());
+	}
+	if (energy.power().count() > 0) {
+		power_min_display_->set_value(energy.power().min());
+		power_max_display_->set_value(energy.power().max());
+	}
+	amp_hour_display_->set_value(energy.amp_hours());
+	watt_hour_display_->set_value(energy.watt_hours());
 }
 
 void PowerPanelView::on_action_reset_displays_triggered()
 {
-	stop_timer();
-	init_timer();
+	if (energy_meter_)
+		energy_meter_->reset();
+	reset_displays();
 }
 
 void PowerPanelView::on_digits_changed()
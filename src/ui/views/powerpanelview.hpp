@@ -24,7 +24,6 @@
 
 #include <QAction>
 #include <QSettings>
-#include <QTimer>
 #include <QToolBar>
 #include <QUuid>
 
@@ -38,6 +37,7 @@ class Session;
 
 namespace data {
 class AnalogTimeSignal;
+class EnergyMeter;
 }
 namespace devices {
 class BaseDevice;
@@ -73,21 +73,8 @@ private:
 	shared_ptr<sv::data::AnalogTimeSignal> voltage_signal_;
 	shared_ptr<sv::data::AnalogTimeSignal> current_signal_;
 
-	QTimer *timer_;
-	qint64 start_time_;
-	qint64 last_time_;
-
-	// Min/max/actual values are stored here, so they can be reseted
-	double voltage_min_;
-	double voltage_max_;
-	double current_min_;
-	double current_max_;
-	double resistance_min_;
-	double resistance_max_;
-	double power_min_;
-	double power_max_;
-	double actual_amp_hours_;
-	double actual_watt_hours_;
+	/** Min/max values and Ah/Wh, accounted for every sample. */
+	shared_ptr<sv::data::EnergyMeter> energy_meter_;
 
 	QAction *const action_reset_displays_;
 	QToolBar *toolbar_;
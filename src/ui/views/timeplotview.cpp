@@ -43,7 +43,6 @@
 
 using std::dynamic_pointer_cast;
 using std::shared_ptr;
-using std::static_pointer_cast;
 using std::string;
 
 Q_DECLARE_METATYPE(sv::ui::widgets::plot::BaseCurveData *)
@@ -95,7 +94,7 @@ void TimePlotView::set_channel(shared_ptr<channels::BaseChannel> channel)
 
 	shared_ptr<data::AnalogTimeSignal> signal;
 	if (channel_->actual_signal())
-		signal = static_pointer_cast<data::AnalogTimeSignal>(
+		signal = dynamic_pointer_cast<data::AnalogTimeSignal>(
 			channel_->actual_signal());
 	if (signal)
 		add_signal(signal);
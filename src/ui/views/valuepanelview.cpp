@@ -27,13 +27,13 @@
 #include <QDebug>
 #include <QHBoxLayout>
 #include <QSettings>
-#include <QTimer>
 #include <QUuid>
 #include <QVariant>
 #include <QVBoxLayout>
 
 #include "valuepanelview.hpp"
 #include "src/data/datautil.hpp"
+#include "src/renderscheduler.hpp"
 #include "src/session.hpp"
 #include "src/settingsmanager.hpp"
 #include "src/util.hpp"
@@ -56,8 +56,7 @@ ValuePanelView::ValuePanelView(Session &session, QUuid uuid, QWidget *parent) :
 	BaseView(session, uuid, parent),
 	channel_(nullptr),
 	signal_(nullptr),
-	value_min_(std::numeric_limits<double>::max()),
-	value_max_(std::numeric_limits<double>::lowest()),
+	statistics_epoch_(0),
 	action_reset_display_(new QAction(this))
 {
 	id_ = "valuepanel:" + util::format_uuid(uuid_);
@@ -66,13 +65,13 @@ ValuePanelView::ValuePanelView(Session &session, QUuid uuid, QWidget *parent) :
 	setup_toolbar();
 	reset_display();
 
-	timer_ = new QTimer(this);
 	init_timer();
 }
 
 ValuePanelView::~ValuePanelView()
 {
 	stop_timer();
+	disconnect_signals_signal();
 }
 
 QString ValuePanelView::title() const
@@ -145,6 +144,9 @@ void ValuePanelView::setup_ui()
 	panel_layout->addWidget(value_display_, 0, 0, 1, 2, Qt::AlignHCenter);
 	panel_layout->addWidget(value_min_display_, 1, 0, 1, 1, Qt::AlignHCenter);
 	panel_layout->addWidget(value_max_display_, 1, 1, 1, 1, Qt::AlignHCenter);
+	interval_label_ = new QLabel();
+	interval_label_->setAlignment(Qt::AlignHCenter);
+	panel_layout->addWidget(interval_label_, 2, 0, 1, 2, Qt::AlignHCenter);
 	layout->addLayout(panel_layout);
 	layout->addStretch(1);
 
@@ -238,6 +240,8 @@ void ValuePanelView::connect_signals_signal()
 	if (!signal_)
 		return;
 
+	statistics_epoch_ = signal_->open_statistics_epoch();
+
 	//connect(signal_.get(), SIGNAL(unit_changed(QString)),
 	//	value_display_, SLOT(set_unit(const String)));
 	connect(signal_.get(), &data::AnalogTimeSignal::digits_changed,
@@ -249,6 +253,8 @@ void ValuePanelView::disconnect_signals_signal()
 	if (!signal_)
 		return;
 
+	signal_->close_statistics_epoch(statistics_epoch_);
+
 	//disconnect(signal_.get(), SIGNAL(unit_changed(QString)),
 	//	value_display_, SLOT(set_unit(QString)));
 	disconnect(signal_.get(), &data::AnalogTimeSignal::digits_changed,
@@ -290,24 +296,21 @@ void ValuePanelView::reset_display()
 	value_display_->reset_value();
 	value_min_display_->reset_value();
 	value_max_display_->reset_value();
+	interval_label_->clear();
 }
 
 void ValuePanelView::init_timer()
 {
-	value_min_ = std::numeric_limits<double>::max();
-	value_max_ = std::numeric_limits<double>::lowest();
-
-	connect(timer_, &QTimer::timeout, this, &ValuePanelView::on_update);
-	timer_->start(250);
+	session_.render_scheduler()->add_client(this, 250,
+		[this](bool) { this->on_update(); });
 }
 
 void ValuePanelView::stop_timer()
 {
-	if (!timer_->isActive())
+	if (!session_.render_scheduler()->has_client(this))
 		return;
 
-	timer_->stop();
-	disconnect(timer_, &QTimer::timeout, this, &ValuePanelView::on_update);
+	session_.render_scheduler()->remove_client(this);
 
 	reset_display();
 }
@@ -317,15 +320,25 @@ void ValuePanelView::on_update()
 	if (!signal_ || signal_->sample_count() == 0)
 		return;
 
-	double value = signal_->last_value();
-	if (value_min_ > value)
-		value_min_ = value;
-	if (value_max_ < value)
-		value_max_ = value;
+	value_display_->set_value(signal_->last_value());
+
+	// Includes the peaks between the updates.
+	const auto statistics = signal_->statistics_epoch(statistics_epoch_);
+	if (statistics.count() > 0) {
+		value_min_display_->set_value(statistics.min());
+		value_max_display_->set_value(statistics.max());
+	}
 
-	value_display_->set_value(value);
-	value_min_display_->set_value(value_min_);
-	value_max_display_->set_value(value_max_);
+	const auto intervals = signal_->interval_statistics();
+	if (intervals.count() > 0) {
+		interval_label_->setText(tr("Rate: %1, Jitter: %2").
+			arg(util::format_time_si(
+				intervals.samplerate(), util::SIPrefix::unspecified, 3, "Hz",
+				false)).
+			arg(util::format_time_si(
+				intervals.jitter(), util::SIPrefix::unspecified, 3, "s",
+				false)));
+	}
 }
 
 void ValuePanelView::on_signal_changed()
@@ -349,8 +362,9 @@ void ValuePanelView::on_signal_changed()
 
 void ValuePanelView::on_action_reset_display_triggered()
 {
-	stop_timer();
-	init_timer();
+	if (signal_)
+		signal_->reset_statistics_epoch(statistics_epoch_);
+	reset_display();
 }
 
 } // namespace views
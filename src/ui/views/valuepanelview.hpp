@@ -24,9 +24,9 @@
 #include <set>
 
 #include <QAction>
+#include <QLabel>
 #include <QSettings>
 #include <QString>
-#include <QTimer>
 #include <QToolBar>
 #include <QUuid>
 
@@ -80,18 +80,16 @@ public:
 private:
 	shared_ptr<channels::BaseChannel> channel_;
 	shared_ptr<sv::data::AnalogTimeSignal> signal_;
-
-	QTimer *timer_;
-
-	// Min/max/actual values are stored here, so they can be reseted
-	double value_min_;
-	double value_max_;
+	/** The min/max values are taken from this epoch of `signal_`. */
+	size_t statistics_epoch_;
 
 	QAction *const action_reset_display_;
 	QToolBar *toolbar_;
 	widgets::MonoFontDisplay *value_display_;
 	widgets::MonoFontDisplay *value_min_display_;
 	widgets::MonoFontDisplay *value_max_display_;
+	/** Shows the effective sample rate and the jitter of `signal_`. */
+	QLabel *interval_label_;
 
 	void setup_ui();
 	void setup_toolbar();
@@ -0,0 +1,165 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+
+#include <QEvent>
+#include <QFont>
+#include <QGlyphRun>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QPointF>
+#include <QRawFont>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <QWidget>
+
+#include "glyphlabel.hpp"
+
+using std::make_shared;
+using std::map;
+using std::shared_ptr;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+
+const size_t GlyphLabel::MaxLength;
+const char GlyphLabel::Glyphs::FirstChar;
+const char GlyphLabel::Glyphs::LastChar;
+
+GlyphLabel::GlyphLabel(QWidget *parent) :
+	QWidget(parent),
+	length_(0),
+	text_width_(0.)
+{
+	text_[0] = '\0';
+	glyphs_ = glyphs_for_font(font());
+	update_glyph_run();
+}
+
+void GlyphLabel::set_text(const char *text)
+{
+	if (strncmp(text_, text, MaxLength) == 0)
+		return;
+
+	strncpy(text_, text, MaxLength);
+	text_[MaxLength] = '\0';
+	length_ = strlen(text_);
+	update_glyph_run();
+	update();
+}
+
+const char *GlyphLabel::text() const
+{
+	return text_;
+}
+
+QSize GlyphLabel::sizeHint() const
+{
+	return QSize((int)std::ceil(text_width_), fontMetrics().height());
+}
+
+QSize GlyphLabel::minimumSizeHint() const
+{
+	return QSize(0, fontMetrics().height());
+}
+
+void GlyphLabel::changeEvent(QEvent *event)
+{
+	if (event->type() == QEvent::FontChange) {
+		glyphs_ = glyphs_for_font(font());
+		update_glyph_run();
+		updateGeometry();
+		update();
+	}
+	QWidget::changeEvent(event);
+}
+
+void GlyphLabel::paintEvent(QPaintEvent *event)
+{
+	(void)event;
+
+	if (length_ == 0)
+		return;
+
+	const QRawFont &raw_font = glyphs_->raw_font;
+	const qreal text_height = raw_font.ascent() + raw_font.descent();
+	const QPointF origin(width() - text_width_,
+		(height() - text_height) / 2 + raw_font.ascent());
+
+	QPainter painter(this);
+	painter.drawGlyphRun(origin, glyph_run_);
+}
+
+void GlyphLabel::update_glyph_run()
+{
+	qreal x = 0.;
+	for (size_t i=0; i<length_; ++i) {
+		char c = text_[i];
+		if (c < Glyphs::FirstChar || c > Glyphs::LastChar)
+			c = '?';
+		const size_t glyph = c - Glyphs::FirstChar;
+		glyph_indexes_[i] = glyphs_->indexes[glyph];
+		glyph_positions_[i] = QPointF(x, 0.);
+		x += glyphs_->advances[glyph];
+	}
+	text_width_ = x;
+
+	glyph_run_.setRawFont(glyphs_->raw_font);
+	glyph_run_.setRawData(glyph_indexes_, glyph_positions_, (int)length_);
+}
+
+shared_ptr<const GlyphLabel::Glyphs> GlyphLabel::glyphs_for_font(
+	const QFont &font)
+{
+	// Only used in the GUI thread, the few fonts of the displays are kept
+	// for the lifetime of the application.
+	static map<QString, shared_ptr<const Glyphs>> glyph_cache;
+
+	const QString key = font.key();
+	auto it = glyph_cache.find(key);
+	if (it != glyph_cache.end())
+		return it->second;
+
+	auto glyphs = make_shared<Glyphs>();
+	glyphs->raw_font = QRawFont::fromFont(font);
+
+	QString chars;
+	for (char c=Glyphs::FirstChar; c<=Glyphs::LastChar; ++c)
+		chars.append(QChar(c));
+	QVector<quint32> indexes = glyphs->raw_font.glyphIndexesForString(chars);
+	QVector<QPointF> advances =
+		glyphs->raw_font.advancesForGlyphIndexes(indexes);
+	for (int i=0; i<chars.size(); ++i) {
+		glyphs->indexes[i] = i < indexes.size() ? indexes[i] : 0;
+		glyphs->advances[i] = i < advances.size() ? advances[i].x() : 0.;
+	}
+
+	glyph_cache[key] = glyphs;
+	return glyphs;
+}
+
+} // namespace widgets
+} // namespace ui
+} // namespace sv
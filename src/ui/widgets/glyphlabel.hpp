@@ -0,0 +1,104 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_GLYPHLABEL_HPP
+#define UI_WIDGETS_GLYPHLABEL_HPP
+
+#include <memory>
+
+#include <QEvent>
+#include <QFont>
+#include <QGlyphRun>
+#include <QPaintEvent>
+#include <QPointF>
+#include <QRawFont>
+#include <QSize>
+#include <QWidget>
+
+using std::shared_ptr;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+
+/**
+ * A right aligned label for short ASCII strings, like the digits of a
+ * MonoFontDisplay, that is painted from cached glyphs.
+ *
+ * The glyph indexes and advances of the printable ASCII characters are
+ * looked up once per font and shared by all labels with the same font. The
+ * text is kept in a fixed buffer and the label is only repainted, when the
+ * text actually changes. So updating the label doesn't allocate memory and
+ * doesn't trigger a relayout.
+ */
+class GlyphLabel : public QWidget
+{
+	Q_OBJECT
+
+public:
+	static const size_t MaxLength = 63;
+
+	explicit GlyphLabel(QWidget *parent = nullptr);
+
+	/**
+	 * Set the text of the label. Longer texts than `MaxLength` are
+	 * truncated, characters that aren't printable ASCII are shown as '?'.
+	 */
+	void set_text(const char *text);
+	const char *text() const;
+
+	QSize sizeHint() const override;
+	QSize minimumSizeHint() const override;
+
+protected:
+	void changeEvent(QEvent *event) override;
+	void paintEvent(QPaintEvent *event) override;
+
+private:
+	/** The cached glyphs of the printable ASCII characters of a font. */
+	struct Glyphs {
+		static const char FirstChar = ' ';
+		static const char LastChar = '~';
+		QRawFont raw_font;
+		quint32 indexes[LastChar - FirstChar + 1];
+		qreal advances[LastChar - FirstChar + 1];
+	};
+
+	static shared_ptr<const Glyphs> glyphs_for_font(const QFont &font);
+	void update_glyph_run();
+
+	shared_ptr<const Glyphs> glyphs_;
+	char text_[MaxLength + 1];
+	size_t length_;
+	/**
+	 * The glyph run only references these arrays, they are rebuilt in place
+	 * when the text or the font has changed.
+	 */
+	quint32 glyph_indexes_[MaxLength];
+	QPointF glyph_positions_[MaxLength];
+	QGlyphRun glyph_run_;
+	qreal text_width_;
+
+};
+
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_GLYPHLABEL_HPP
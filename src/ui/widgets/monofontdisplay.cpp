@@ -17,6 +17,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
 #include <limits>
 
 #include <QDebug>
@@ -24,6 +25,7 @@
 #include <QFrame>
 #include <QFontMetrics>
 #include <QGridLayout>
+#include <QLocale>
 #include <QSizePolicy>
 #include <QString>
 
@@ -31,6 +33,7 @@
 
 #include "monofontdisplay.hpp"
 #include "src/util.hpp"
+#include "src/ui/widgets/glyphlabel.hpp"
 
 namespace sv {
 namespace ui {
@@ -48,12 +51,15 @@ MonoFontDisplay::MonoFontDisplay(const MonoFontDisplayType display_type,
 	extra_text_(extra_text),
 	extra_text_changed_(true),
 	unit_(unit),
-	unit_si_prefix_(""),
+	unit_si_prefix_(util::SIPrefix::none),
 	unit_suffix_(unit_suffix),
 	unit_changed_(true),
 	small_(small),
-	value_(.0)
+	value_(.0),
+	decimal_point_(QLocale().decimalPoint().toLatin1())
 {
+	value_str_[0] = '\0';
+
 	MonoFontDisplay::setup_ui();
 	reset_value();
 }
@@ -104,9 +110,8 @@ void MonoFontDisplay::setup_ui()
 	layout_->setSpacing(0);
 
 	// Value
-	value_label_ = new QLabel();
+	value_label_ = new GlyphLabel();
 	value_label_->setFont(value_font);
-	value_label_->setAlignment(Qt::AlignRight);
 	value_label_->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
 	//value_label_->setFrameShape(QFrame::Box);
 	layout_->addWidget(value_label_, 0, 0, 2, 1, Qt::AlignRight | Qt::AlignVCenter);
@@ -182,9 +187,10 @@ void MonoFontDisplay::update_unit_widget_dimensions()
 #endif
 }
 
-void MonoFontDisplay::show_value(const QString &value)
+void MonoFontDisplay::show_value(const char *value)
 {
-	value_label_->setText(value);
+	// The label is only repainted, when the value has changed.
+	value_label_->set_text(value);
 }
 
 void MonoFontDisplay::show_extra_text(const QString &extra_text)
@@ -276,40 +282,39 @@ void MonoFontDisplay::set_decimal_places(const int total_digits, const int decim
 
 void MonoFontDisplay::reset_value()
 {
-	QString init_value("");
-	for (int i=0; i<total_digits_; i++)
-		init_value.append("-");
-	show_value(init_value);
+	size_t length = 0;
+	for (int i=0; i<total_digits_ && length<GlyphLabel::MaxLength; i++)
+		value_str_[length++] = '-';
+	value_str_[length] = '\0';
+	show_value(value_str_);
 }
 
 void MonoFontDisplay::update_display()
 {
-	QString value_str("");
-	QString si_prefix("");
+	util::SIPrefix si_prefix = util::SIPrefix::none;
 
 	if (value_ >= std::numeric_limits<double>::max() ||
 			value_ == std::numeric_limits<double>::infinity()) {
 		// TODO: Replace with "ol" or "overl", depending on the avail. digits.
-		value_str = QString("OL");
+		strcpy(value_str_, "OL");
 	}
 	else if (value_ <= std::numeric_limits<double>::lowest()) {
 		// TODO: Replace with "ul" or "underf", depending on the avail. digits.
-		value_str = QString("UL");
+		strcpy(value_str_, "UL");
 	}
 	else if (display_type_ == MonoFontDisplayType::FixedRange) {
-		// Use actual locale (%L) for formating
-		value_str = QString("%L1").
-			arg(value_, total_digits_, 'f', decimal_places_, QChar(' '));
+		util::format_value_fixed(value_, total_digits_, decimal_places_,
+			decimal_point_, value_str_, sizeof(value_str_));
 	}
 	else if (display_type_ == MonoFontDisplayType::AutoRangeWithSRDigits) {
-		util::format_value_si(value_, total_digits_, sr_digits_, value_str,
-			si_prefix);
+		si_prefix = util::format_value_si(value_, total_digits_, sr_digits_,
+			decimal_point_, value_str_, sizeof(value_str_));
 	}
 	else if (display_type_ == MonoFontDisplayType::AutoRange) {
-		util::format_value_si_autoscale(value_, total_digits_, decimal_places_,
-			value_str, si_prefix);
+		si_prefix = util::format_value_si_autoscale(value_, total_digits_,
+			decimal_places_, decimal_point_, value_str_, sizeof(value_str_));
 	}
-	show_value(value_str);
+	show_value(value_str_);
 
 	if (total_digits_changed_) {
 		total_digits_changed_ = false;
@@ -324,7 +329,8 @@ void MonoFontDisplay::update_display()
 
 	if (si_prefix != unit_si_prefix_ || unit_changed_) {
 		unit_si_prefix_ = si_prefix;
-		QString unit_str = QString("%1%2").arg(unit_si_prefix_, unit_);
+		QString unit_str = QString("%1%2").
+			arg(util::format_si_prefix(unit_si_prefix_), unit_);
 		if (!unit_suffix_.isEmpty()) {
 			unit_str.append(" ").append(unit_suffix_);
 		}
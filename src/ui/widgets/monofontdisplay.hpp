@@ -27,6 +27,9 @@
 #include <QSpacerItem>
 #include <QString>
 
+#include "src/util.hpp"
+#include "src/ui/widgets/glyphlabel.hpp"
+
 namespace sv {
 namespace ui {
 namespace widgets {
@@ -57,14 +60,17 @@ private:
 	QString extra_text_;
 	bool extra_text_changed_;
 	QString unit_;
-	QString unit_si_prefix_;
+	util::SIPrefix unit_si_prefix_;
 	QString unit_suffix_;
 	bool unit_changed_;
 	const bool small_;
 	double value_;
+	/** The formated value, to avoid allocations for every update. */
+	char value_str_[GlyphLabel::MaxLength + 1];
+	char decimal_point_;
 	int ascent_diff_;
 	QGridLayout *layout_;
-	QLabel *value_label_;
+	GlyphLabel *value_label_;
 	QFont extra_font_;
 	QLabel *extra_label_;
 	QSpacerItem *extra_spacer_;
@@ -74,7 +80,7 @@ private:
 	void update_value_widget_dimensions();
 	void update_extra_widget_dimensions();
 	void update_unit_widget_dimensions();
-	void show_value(const QString &value);
+	void show_value(const char *value);
 	void show_extra_text(const QString &extra_text);
 	void show_unit(const QString &unit);
 
@@ -42,6 +42,7 @@
 #include "src/data/datautil.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/plotcurve.hpp"
 #include "src/ui/widgets/plot/timecurvedata.hpp"
 #include "src/ui/widgets/plot/xycurvedata.hpp"
 
@@ -69,7 +70,7 @@ Curve::Curve(BaseCurveData *curve_data, int x_axis_id, int y_axis_id,
 	pen.setStyle(Qt::SolidLine);
 	pen.setCosmetic(false);
 
-	plot_curve_ = new QwtPlotCurve();
+	plot_curve_ = new PlotCurve(curve_data_);
 	plot_curve_->setYAxis(y_axis_id);
 	plot_curve_->setXAxis(x_axis_id);
 	plot_curve_->setStyle(QwtPlotCurve::Lines);
@@ -78,8 +79,6 @@ Curve::Curve(BaseCurveData *curve_data, int x_axis_id, int y_axis_id,
 	plot_curve_->setSymbol(new QwtSymbol(QwtSymbol::NoSymbol));
 	plot_curve_->setRenderHint(QwtPlotItem::RenderAntialiased, true);
 	plot_curve_->setPaintAttribute(QwtPlotCurve::ClipPolygons, false);
-	plot_curve_->setData(curve_data_);
-	//plot_curve_->setRawSamples(); // TODO: is this an option?
 	// Curves have the lowest z order, everything else will be painted ontop.
 	plot_curve_->setZ(1);
 
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <QImage>
+#include <QPainter>
+#include <QPointF>
+#include <QPolygonF>
+#include <QSize>
+#include <qwt_scale_map.h>
+
+#include "curverenderer.hpp"
+#include "src/data/analogtimesignal.hpp"
+
+using std::lock_guard;
+using std::mutex;
+using std::pair;
+using std::unique_lock;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+const size_t CurveRenderer::ChunkSize = 65536;
+
+CurveRenderer::CurveRenderer() :
+	QObject(),
+	abort_(false),
+	has_request_(false)
+{
+	render_thread_ = std::thread(&CurveRenderer::render_thread_proc, this);
+}
+
+CurveRenderer::~CurveRenderer()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		abort_ = true;
+	}
+	request_cond_.notify_one();
+	render_thread_.join();
+}
+
+void CurveRenderer::request(const QSize &size, const vector<RenderCurve> &curves)
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		request_size_ = size;
+		request_curves_ = curves;
+		has_request_ = true;
+	}
+	request_cond_.notify_one();
+}
+
+QImage CurveRenderer::image() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return image_;
+}
+
+void CurveRenderer::render_thread_proc()
+{
+	while (true) {
+		QSize size;
+		vector<RenderCurve> curves;
+		{
+			unique_lock<mutex> lock(mutex_);
+			request_cond_.wait(lock, [this] { return abort_ || has_request_; });
+			if (abort_)
+				return;
+			size = request_size_;
+			curves.swap(request_curves_);
+			has_request_ = false;
+		}
+
+		QImage image;
+		if (size.isValid() && !size.isEmpty()) {
+			image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+			image.fill(Qt::transparent);
+			QPainter painter(&image);
+			for (const auto &curve : curves)
+				render_curve(painter, curve);
+		}
+
+		{
+			lock_guard<mutex> lock(mutex_);
+			image_ = image;
+		}
+		Q_EMIT image_ready();
+	}
+}
+
+void CurveRenderer::render_curve(QPainter &painter, const RenderCurve &curve)
+{
+	const double x_min = std::min(curve.x_map.s1(), curve.x_map.s2());
+	const double x_max = std::max(curve.x_map.s1(), curve.x_map.s2());
+	size_t pos = curve.signal->find_sample_pos(x_min + curve.x_offset, false);
+	size_t end_pos = curve.signal->find_sample_pos(x_max + curve.x_offset, false);
+	// One neighbour on each side, for the lines to the samples outside
+	if (pos > 0)
+		--pos;
+	++end_pos;
+	end_pos = std::min(end_pos, curve.sample_count);
+	if (pos >= end_pos)
+		return;
+
+	/*
+	 * Reduce the samples of each pixel column to the first, the min, the max
+	 * and the last sample. The points are collected in chronological order.
+	 */
+	QPolygonF polyline;
+	int column = 0;
+	size_t column_count = 0;
+	size_t first_pos = 0;
+	size_t min_pos = 0;
+	size_t max_pos = 0;
+	size_t last_pos = 0;
+	QPointF first_point;
+	QPointF min_point;
+	QPointF max_point;
+	QPointF last_point;
+	size_t i = 0;
+
+	auto flush_column = [&]() {
+		if (column_count == 0)
+			return;
+		pair<size_t, QPointF> points[] = {
+			{ first_pos, first_point }, { min_pos, min_point },
+			{ max_pos, max_point }, { last_pos, last_point } };
+		if (points[1].first > points[2].first)
+			std::swap(points[1], points[2]);
+		polyline.append(first_point);
+		size_t added_pos = first_pos;
+		for (size_t k=1; k<4; ++k) {
+			if (points[k].first > added_pos) {
+				polyline.append(points[k].second);
+				added_pos = points[k].first;
+			}
+		}
+	};
+
+	while (pos < end_pos) {
+		const size_t count = curve.signal->get_samples(
+			pos, std::min(pos + ChunkSize, end_pos), timestamps_, values_, false);
+		if (count == 0)
+			break;
+
+		for (size_t j=0; j<count; ++j, ++i) {
+			const QPointF point(
+				curve.x_map.transform(timestamps_[j] - curve.x_offset),
+				curve.y_map.transform(values_[j]));
+			const int point_column = (int)std::floor(point.x());
+			if (column_count == 0 || point_column != column) {
+				flush_column();
+				column = point_column;
+				column_count = 0;
+				first_point = min_point = max_point = point;
+				first_pos = min_pos = max_pos = i;
+			}
+			// Pixel y coordinates are inverted, but only the extremes count
+			if (point.y() < min_point.y()) {
+				min_point = point;
+				min_pos = i;
+			}
+			if (point.y() > max_point.y()) {
+				max_point = point;
+				max_pos = i;
+			}
+			last_point = point;
+			last_pos = i;
+			++column_count;
+		}
+		pos += count;
+	}
+	flush_column();
+
+	painter.setRenderHint(QPainter::Antialiasing, curve.antialiased);
+	painter.setPen(curve.pen);
+	painter.drawPolyline(polyline);
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
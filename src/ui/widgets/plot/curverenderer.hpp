@@ -0,0 +1,119 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_CURVERENDERER_HPP
+#define UI_WIDGETS_PLOT_CURVERENDERER_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QImage>
+#include <QObject>
+#include <QPainter>
+#include <QPen>
+#include <QSize>
+#include <qwt_scale_map.h>
+
+using std::condition_variable;
+using std::mutex;
+using std::shared_ptr;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * Snapshot of a time curve for the CurveRenderer.
+ */
+struct RenderCurve
+{
+	shared_ptr<sv::data::AnalogTimeSignal> signal;
+	/** Only the samples up to this count are rendered. */
+	size_t sample_count;
+	/** Subtracted from the timestamps to get the x values. */
+	double x_offset;
+	QPen pen;
+	bool antialiased;
+	QwtScaleMap x_map;
+	QwtScaleMap y_map;
+};
+
+/**
+ * Rasterizes time curves into a QImage in a worker thread.
+ *
+ * The GUI thread queues a snapshot of the curves and the canvas geometry
+ * with request(). When the image is ready, `image_ready()` is emitted (from
+ * the worker thread) and the image can be fetched with image(). Requests
+ * that haven't been started yet are replaced by newer requests, so the
+ * worker never falls behind.
+ *
+ * The curves are reduced to first/min/max/last per pixel column while they
+ * are rasterized.
+ */
+class CurveRenderer : public QObject
+{
+	Q_OBJECT
+
+public:
+	CurveRenderer();
+	~CurveRenderer();
+
+	void request(const QSize &size, const vector<RenderCurve> &curves);
+	QImage image() const;
+
+private:
+	void render_thread_proc();
+	void render_curve(QPainter &painter, const RenderCurve &curve);
+
+	std::thread render_thread_;
+	mutable mutex mutex_;
+	condition_variable request_cond_;
+	bool abort_;
+	bool has_request_;
+	QSize request_size_;
+	vector<RenderCurve> request_curves_;
+	QImage image_;
+
+	/** Buffers for reading the signals in chunks. */
+	vector<double> timestamps_;
+	vector<double> values_;
+
+	static const size_t ChunkSize;
+
+Q_SIGNALS:
+	void image_ready();
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_CURVERENDERER_HPP
@@ -0,0 +1,165 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <qwt_plot_item.h>
+#include <qwt_scale_map.h>
+
+#include "persistenceitem.hpp"
+#include "src/data/densitybuffer.hpp"
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+namespace {
+
+/**
+ * Color table for the hit counts. Index 0 (no hits) is transparent, the
+ * other entries go from a transparent blue to an opaque red.
+ */
+const QRgb *color_table()
+{
+	static QRgb table[256];
+	static bool initialized = false;
+	if (!initialized) {
+		table[0] = qRgba(0, 0, 0, 0);
+		for (int i=1; i<256; ++i) {
+			const double t = (double)(i - 1) / 254.;
+			QColor color = QColor::fromHsvF(0.66 * (1. - t), 1., 1., 0.25 + 0.75 * t);
+			table[i] = qPremultiply(color.rgba());
+		}
+		initialized = true;
+	}
+	return table;
+}
+
+} // namespace
+
+PersistenceItem::PersistenceItem() :
+	QwtPlotItem(),
+	decay_(90),
+	image_dirty_(true)
+{
+	setItemAttribute(QwtPlotItem::Legend, false);
+	// Under the curves (z = 1), but above the grid.
+	setZ(0.5);
+}
+
+int PersistenceItem::rtti() const
+{
+	return QwtPlotItem::Rtti_PlotUserItem + 1;
+}
+
+void PersistenceItem::draw(QPainter *painter, const QwtScaleMap &x_map,
+	const QwtScaleMap &y_map, const QRectF &canvas_rect) const
+{
+	(void)x_map;
+	(void)y_map;
+
+	if (image_dirty_)
+		update_image();
+	if (image_.isNull())
+		return;
+
+	// Scaled when the plot is exported with a different size.
+	painter->drawImage(canvas_rect, image_);
+}
+
+void PersistenceItem::set_decay(int decay)
+{
+	decay_ = std::max(0, std::min(decay, 100));
+}
+
+void PersistenceItem::resize(const QSize &size)
+{
+	buffer_.resize((size_t)std::max(0, size.width()),
+		(size_t)std::max(0, size.height()));
+	image_dirty_ = true;
+}
+
+void PersistenceItem::clear()
+{
+	buffer_.clear();
+	image_dirty_ = true;
+}
+
+void PersistenceItem::add_line(const QPointF &from, const QPointF &to)
+{
+	buffer_.add_line(from.x(), from.y(), to.x(), to.y());
+	image_dirty_ = true;
+}
+
+void PersistenceItem::add_point(const QPointF &point)
+{
+	buffer_.add_point((int)std::lround(point.x()), (int)std::lround(point.y()));
+	image_dirty_ = true;
+}
+
+void PersistenceItem::end_sweep()
+{
+	buffer_.decay(
+		(uint32_t)decay_ * sv::data::DensityBuffer::DecayOne / 100);
+	image_dirty_ = true;
+}
+
+void PersistenceItem::update_image() const
+{
+	image_dirty_ = false;
+
+	const uint32_t max_count = buffer_.max_count();
+	if (max_count == 0) {
+		image_ = QImage();
+		return;
+	}
+
+	const int width = (int)buffer_.width();
+	const int height = (int)buffer_.height();
+	if (image_.width() != width || image_.height() != height)
+		image_ = QImage(width, height, QImage::Format_ARGB32_Premultiplied);
+
+	// Logarithmic intensity, so rare glitches are still visible next to
+	// the regular trace.
+	const QRgb *table = color_table();
+	const double scale = 254. / std::log1p((double)max_count);
+	const uint32_t *counts = buffer_.data();
+	for (int y=0; y<height; ++y) {
+		QRgb *line = reinterpret_cast<QRgb *>(image_.scanLine(y));
+		for (int x=0; x<width; ++x) {
+			const uint32_t count = counts[(size_t)y * width + x];
+			line[x] = count == 0 ? table[0] :
+				table[1 + (int)(scale * std::log1p((double)count))];
+		}
+	}
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_PERSISTENCEITEM_HPP
+#define UI_WIDGETS_PLOT_PERSISTENCEITEM_HPP
+
+#include <QImage>
+#include <QPainter>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <qwt_plot_item.h>
+#include <qwt_scale_map.h>
+
+#include "src/data/densitybuffer.hpp"
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * Persistence display for the Oscilloscope plot mode.
+ *
+ * The lines of all sweeps are accumulated into a hit count buffer with the
+ * size of the canvas. At the end of each sweep, the counts are reduced by
+ * the decay. The buffer is painted color mapped under the live curves.
+ */
+class PersistenceItem : public QwtPlotItem
+{
+
+public:
+	PersistenceItem();
+
+	int rtti() const override;
+	void draw(QPainter *painter, const QwtScaleMap &x_map,
+		const QwtScaleMap &y_map, const QRectF &canvas_rect) const override;
+
+	/**
+	 * Set the percentage of the hits, that are kept at the end of a sweep.
+	 * 100 means infinite persistence.
+	 */
+	void set_decay(int decay);
+	int decay() const { return decay_; }
+
+	/** Resize the buffer to the canvas size. All hits are cleared. */
+	void resize(const QSize &size);
+	void clear();
+
+	/** Add a line in canvas coordinates. The start point is not hit. */
+	void add_line(const QPointF &from, const QPointF &to);
+	void add_point(const QPointF &point);
+	/** Apply the decay. */
+	void end_sweep();
+
+private:
+	void update_image() const;
+
+	sv::data::DensityBuffer buffer_;
+	int decay_;
+	mutable QImage image_;
+	mutable bool image_dirty_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_PERSISTENCEITEM_HPP
@@ -30,6 +30,8 @@
 #include <QDebug>
 #include <QEvent>
 #include <QHBoxLayout>
+#include <QImage>
+#include <QPainter>
 #include <QPen>
 #include <QPoint>
 #include <QPointF>
@@ -49,6 +51,7 @@
 #include <qwt_plot_curve.h>
 #include <qwt_plot_directpainter.h>
 #include <qwt_plot_grid.h>
+#include <qwt_plot_item.h>
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 // This header uses deprecated declarations, disable checks.
@@ -63,14 +66,20 @@
 #include <qwt_symbol.h>
 
 #include "plot.hpp"
+#include "src/renderscheduler.hpp"
 #include "src/session.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/dialogs/plotcurveconfigdialog.hpp"
 #include "src/ui/widgets/plot/axislocklabel.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
 #include "src/ui/widgets/plot/curve.hpp"
+#include "src/ui/widgets/plot/curverenderer.hpp"
+#include "src/ui/widgets/plot/persistenceitem.hpp"
+#include "src/ui/widgets/plot/plotcurve.hpp"
 #include "src/ui/widgets/plot/plotmagnifier.hpp"
 #include "src/ui/widgets/plot/plotscalepicker.hpp"
+#include "src/ui/widgets/plot/scrollcache.hpp"
+#include "src/ui/widgets/plot/tilecache.hpp"
 #include "src/ui/widgets/plot/timecurvedata.hpp"
 #include "src/ui/widgets/plot/xycurvedata.hpp"
 
@@ -83,6 +92,8 @@ namespace ui {
 namespace widgets {
 namespace plot {
 
+const int Plot::InteractionTimeout = 300;
+
 class Canvas : public QwtPlotCanvas
 {
 public:
@@ -141,17 +152,60 @@ private:
 	}
 };
 
+/**
+ * Paints the curve image of the CurveRenderer onto the canvas.
+ */
+class CurveImageItem : public QwtPlotItem
+{
+public:
+	explicit CurveImageItem(const CurveRenderer *curve_renderer) :
+		QwtPlotItem(),
+		curve_renderer_(curve_renderer)
+	{
+		setItemAttribute(QwtPlotItem::Legend, false);
+		// Same z order as the curves.
+		setZ(1);
+	}
+
+	int rtti() const override
+	{
+		return QwtPlotItem::Rtti_PlotUserItem;
+	}
+
+	void draw(QPainter *painter, const QwtScaleMap &x_map,
+		const QwtScaleMap &y_map, const QRectF &canvas_rect) const override
+	{
+		(void)x_map;
+		(void)y_map;
+		(void)canvas_rect;
+
+		const QImage image = curve_renderer_->image();
+		if (!image.isNull())
+			painter->drawImage(QPointF(0, 0), image);
+	}
+
+private:
+	const CurveRenderer *curve_renderer_;
+};
+
 Plot::Plot(Session &session, QWidget *parent) : QwtPlot(parent),
 	session_(session),
 	plot_interval_(200),
-	timer_id_(-1),
 	time_span_(120.),
 	add_time_(30.),
 	active_marker_(nullptr),
 	markers_label_(nullptr),
 	markers_label_alignment_(Qt::AlignBottom | Qt::AlignHCenter),
 	marker_select_picker_(nullptr),
-	marker_move_picker_(nullptr)
+	marker_move_picker_(nullptr),
+	curve_renderer_(nullptr),
+	curve_image_item_(nullptr),
+	scroll_cache_(new ScrollCache()),
+	persistence_item_(nullptr),
+	persistence_decay_(90),
+	keep_scroll_cache_(false),
+	tile_cache_(new TileCache()),
+	interactive_(false)
 {
 	this->setAutoReplot(false);
 	this->setCanvas(new Canvas());
@@ -197,11 +251,31 @@ Plot::Plot(Session &session, QWidget *parent) : QwtPlot(parent),
 	plot_magnifier_ = new PlotMagnifier(this->canvas());
 	connect(plot_magnifier_, &PlotMagnifier::magnified,
 		this, &Plot::lock_all_axis);
+
+	// Fast painting while zooming and panning
+	interaction_timer_ = new QTimer(this);
+	interaction_timer_->setSingleShot(true);
+	interaction_timer_->setInterval(InteractionTimeout);
+	connect(interaction_timer_, &QTimer::timeout,
+		this, &Plot::end_interaction);
+	connect(plot_panner_, &QwtPlotPanner::moved,
+		this, &Plot::begin_interaction);
+	connect(plot_magnifier_, &PlotMagnifier::about_to_magnify,
+		this, &Plot::begin_interaction);
+	connect(tile_cache_, &TileCache::tiles_ready,
+		this, &Plot::on_tiles_ready);
 }
 
 Plot::~Plot()
 {
 	this->stop();
+	// Joins the worker thread. The curve image item is deleted by QwtPlot.
+	delete curve_renderer_;
+	curve_renderer_ = nullptr;
+	// Joins the worker thread of the tile cache.
+	delete tile_cache_;
+	tile_cache_ = nullptr;
+	delete scroll_cache_;
 	for (const auto &marker_pair : marker_curve_map_)
 		delete marker_pair.first;
 	for (const auto &curve_pair : curve_map_)
@@ -210,22 +284,55 @@ Plot::~Plot()
 
 void Plot::start()
 {
-	timer_id_ = startTimer(plot_interval_);
+	session_.render_scheduler()->add_client(this, plot_interval_,
+		[this](bool catch_up) { this->on_render(catch_up); });
 }
 
 void Plot::stop()
 {
 	//qWarning() << "Plot::stop() for " << curve_data_->name();
-	killTimer(timer_id_);
+	session_.render_scheduler()->remove_client(this);
+}
+
+void Plot::on_render(bool catch_up)
+{
+	// Before the x axis is moved to the next sweep.
+	update_persistence();
+
+	if (catch_up) {
+		// The plot was hidden, paint all the new samples with one replot
+		// instead of painting the backlog incrementally.
+		if (!update_intervals())
+			replot();
+		return;
+	}
+
+	update_intervals();
+	update_curves();
 }
 
 void Plot::replot()
 {
 	//qWarning() << "Plot::replot()";
+
+	// The canvas is painted immediately (see Canvas), so all samples that
+	// exist before the replot are painted afterwards and don't have to be
+	// painted again by the direct painter.
+	map<Curve *, size_t> num_points;
 	for (const auto &curve : curve_map_)
-		curve.second->set_painted_points(0);
+		num_points[curve.second] = curve.second->curve_data()->size();
+
+	// Everything but moved or rescaled axes must be rendered again.
+	if (!keep_scroll_cache_)
+		scroll_cache_->invalidate();
 
 	QwtPlot::replot();
+
+	for (const auto &curve : curve_map_)
+		curve.second->set_painted_points(num_points[curve.second]);
+
+	if (curve_renderer_)
+		request_curve_image();
 }
 
 string Plot::add_curve(BaseCurveData *curve_data)
@@ -245,6 +352,8 @@ string Plot::add_curve(BaseCurveData *curve_data)
 	Curve *curve = new Curve(curve_data, x_axis_id, y_axis_id);
 	curve->plot_curve()->attach(this);
 	curve_map_.insert(make_pair(curve->id(), curve));
+	update_offscreen_rendering(curve);
+	update_interactive(curve);
 
 	QwtPlot::replot();
 	Q_EMIT curve_added();
@@ -269,6 +378,8 @@ bool Plot::add_curve(Curve *curve)
 
 	curve->plot_curve()->attach(this);
 	curve_map_.insert(make_pair(curve->id(), curve));
+	update_offscreen_rendering(curve);
+	update_interactive(curve);
 
 	QwtPlot::replot();
 	Q_EMIT curve_added();
@@ -290,9 +401,17 @@ void Plot::remove_curve(Curve *curve)
 
 	// Delete curve
 	curve_map_.erase(curve->id());
+	persistence_pos_.erase(curve);
+	if (curve->curve_data()->type() == CurveType::TimeCurve) {
+		tile_cache_->remove(
+			static_cast<TimeCurveData *>(curve->curve_data())->signal());
+	}
 	curve->plot_curve()->detach();
 	delete curve;
 
+	if (curve_renderer_)
+		request_curve_image();
+
 	Q_EMIT curve_removed();
 }
 
@@ -703,9 +822,38 @@ void Plot::on_legend_clicked(const QVariant &item_info, int index)
 
 void Plot::update_curves()
 {
+	bool has_new_offscreen_points = false;
 	for (const auto &curve : curve_map_) {
-		const size_t painted_points = curve.second->painted_points();
-		const size_t num_points = curve.second->curve_data()->size();
+		size_t painted_points = curve.second->painted_points();
+		size_t num_points = curve.second->curve_data()->size();
+
+		if (static_cast<PlotCurve *>(curve.second->plot_curve())->
+				is_offscreen_rendering()) {
+			if (num_points > painted_points) {
+				has_new_offscreen_points = true;
+				curve.second->set_painted_points(num_points);
+			}
+			continue;
+		}
+
+		// Only paint the samples of time curves that are in the visible
+		// x interval (e.g. in rolling or oscilloscope mode).
+		if (curve.second->curve_data()->type() == CurveType::TimeCurve) {
+			const QwtInterval x_interval =
+				this->axisInterval(curve.second->x_axis_id());
+			size_t pos;
+			size_t end_pos;
+			static_cast<TimeCurveData *>(curve.second->curve_data())->
+				visible_range(x_interval.minValue(), x_interval.maxValue(),
+					pos, end_pos);
+			// drawSeries() starts at the last painted point, so the first
+			// painted point is the neighbour left of the visible interval.
+			if (painted_points < pos + 1)
+				painted_points = pos + 1;
+			if (num_points > end_pos)
+				num_points = end_pos;
+		}
+
 		if (num_points > painted_points) {
 			//qWarning() << QString("Plot::updateCurve(): num_points = %1, painted_points = %2").
 			//	arg(num_points).arg(painted_points);
@@ -735,9 +883,12 @@ void Plot::update_curves()
 
 		//replot();
 	}
+
+	if (has_new_offscreen_points)
+		request_curve_image();
 }
 
-void Plot::update_intervals()
+bool Plot::update_intervals()
 {
 	bool intervals_changed = false;
 
@@ -748,8 +899,13 @@ void Plot::update_intervals()
 			intervals_changed = true;
 	}
 
-	if (intervals_changed)
+	if (intervals_changed) {
+		// The scroll cache detects a rescale by itself.
+		keep_scroll_cache_ = true;
 		replot();
+		keep_scroll_cache_ = false;
+	}
+	return intervals_changed;
 }
 
 bool Plot::update_x_interval(Curve *curve)
@@ -846,6 +1002,8 @@ bool Plot::update_x_interval(Curve *curve)
 		interval_changed = true;
 		setAxisScaleDiv(QwtPlot::xBottom, scaleDiv);
 		curve->set_painted_points(0);
+		if (persistence_item_)
+			persistence_item_->end_sweep();
 	}
 
 	return interval_changed;
@@ -877,8 +1035,12 @@ bool Plot::update_y_interval(const Curve *curve)
 		interval_changed = true;
 	}
 
-	if (interval_changed )
+	if (interval_changed ) {
 		setAxisScale(y_axis_id, min, max);
+		// The hits of the old scale don't match the new scale.
+		if (persistence_item_)
+			persistence_item_->clear();
+	}
 	return interval_changed;
 }
 
@@ -894,6 +1056,192 @@ void Plot::set_markers_label_alignment(int alignment)
 	}
 }
 
+void Plot::set_update_mode(PlotUpdateMode update_mode)
+{
+	update_mode_ = update_mode;
+	if (persistence_item_) {
+		persistence_item_->clear();
+		persistence_item_->setVisible(
+			update_mode_ == PlotUpdateMode::Oscilloscope);
+	}
+}
+
+void Plot::set_persistence(bool persistence)
+{
+	if (persistence == (persistence_item_ != nullptr))
+		return;
+
+	if (persistence) {
+		persistence_item_ = new PersistenceItem();
+		persistence_item_->set_decay(persistence_decay_);
+		persistence_item_->resize(canvas()->size());
+		persistence_item_->setVisible(
+			update_mode_ == PlotUpdateMode::Oscilloscope);
+		persistence_item_->attach(this);
+		// Start with the new samples
+		persistence_pos_.clear();
+		for (const auto &curve : curve_map_) {
+			persistence_pos_[curve.second] =
+				curve.second->curve_data()->size();
+		}
+	}
+	else {
+		persistence_item_->detach();
+		delete persistence_item_;
+		persistence_item_ = nullptr;
+		persistence_pos_.clear();
+	}
+	replot();
+}
+
+void Plot::set_persistence_decay(int persistence_decay)
+{
+	persistence_decay_ = persistence_decay;
+	if (persistence_item_)
+		persistence_item_->set_decay(persistence_decay_);
+}
+
+void Plot::update_persistence()
+{
+	if (!persistence_item_ || update_mode_ != PlotUpdateMode::Oscilloscope)
+		return;
+
+	const QwtScaleMap x_map = canvasMap(QwtPlot::xBottom);
+	for (const auto &curve : curve_map_) {
+		const BaseCurveData *curve_data = curve.second->curve_data();
+		if (curve_data->type() != CurveType::TimeCurve)
+			continue;
+
+		const QwtScaleMap y_map = canvasMap(curve.second->y_axis_id());
+		const size_t size = curve_data->size();
+		size_t &pos = persistence_pos_[curve.second];
+		if (pos > size)
+			pos = size;
+		for (; pos<size; ++pos) {
+			const QPointF sample = curve_data->sample(pos);
+			// Samples of the next sweep are added, when the x axis is moved.
+			if (sample.x() > x_map.s2())
+				break;
+			const QPointF point(
+				x_map.transform(sample.x()), y_map.transform(sample.y()));
+
+			const QPointF last_sample = pos > 0 ?
+				curve_data->sample(pos-1) : sample;
+			if (pos > 0 && last_sample.x() >= x_map.s1()) {
+				persistence_item_->add_line(QPointF(
+					x_map.transform(last_sample.x()),
+					y_map.transform(last_sample.y())), point);
+			}
+			else {
+				persistence_item_->add_point(point);
+			}
+		}
+	}
+}
+
+void Plot::set_threaded_rendering(bool threaded_rendering)
+{
+	if (threaded_rendering == (curve_renderer_ != nullptr))
+		return;
+
+	if (threaded_rendering) {
+		curve_renderer_ = new CurveRenderer();
+		connect(curve_renderer_, &CurveRenderer::image_ready,
+			this, &Plot::on_curve_image_ready);
+		curve_image_item_ = new CurveImageItem(curve_renderer_);
+		curve_image_item_->attach(this);
+	}
+	else {
+		curve_image_item_->detach();
+		delete curve_image_item_;
+		curve_image_item_ = nullptr;
+		// Joins the worker thread
+		delete curve_renderer_;
+		curve_renderer_ = nullptr;
+	}
+
+	for (const auto &curve : curve_map_)
+		update_offscreen_rendering(curve.second);
+	replot();
+}
+
+void Plot::update_offscreen_rendering(Curve *curve)
+{
+	// Only time curves are supported by the CurveRenderer
+	bool offscreen_rendering = curve_renderer_ != nullptr &&
+		curve->curve_data()->type() == CurveType::TimeCurve;
+	static_cast<PlotCurve *>(curve->plot_curve())->
+		set_offscreen_rendering(offscreen_rendering);
+}
+
+void Plot::update_interactive(Curve *curve)
+{
+	auto *plot_curve = static_cast<PlotCurve *>(curve->plot_curve());
+	plot_curve->set_tile_cache(tile_cache_);
+	plot_curve->set_interactive(interactive_);
+}
+
+void Plot::begin_interaction()
+{
+	interaction_timer_->start();
+	if (interactive_)
+		return;
+
+	interactive_ = true;
+	for (const auto &curve : curve_map_)
+		update_interactive(curve.second);
+}
+
+void Plot::end_interaction()
+{
+	interactive_ = false;
+	for (const auto &curve : curve_map_)
+		update_interactive(curve.second);
+
+	// Refine the coarse curves
+	replot();
+}
+
+void Plot::on_tiles_ready()
+{
+	// Tiles that are built while the user is still zooming or panning are
+	// shown right away, otherwise the curves are already in full quality.
+	if (interactive_)
+		replot();
+}
+
+void Plot::request_curve_image()
+{
+	vector<RenderCurve> render_curves;
+	for (const auto &curve : curve_map_) {
+		if (curve.second->curve_data()->type() != CurveType::TimeCurve)
+			continue;
+		if (!curve.second->plot_curve()->isVisible())
+			continue;
+
+		auto *curve_data =
+			static_cast<TimeCurveData *>(curve.second->curve_data());
+		RenderCurve render_curve;
+		render_curve.signal = curve_data->signal();
+		render_curve.sample_count = render_curve.signal->sample_count();
+		render_curve.x_offset = curve_data->x_offset();
+		render_curve.pen = curve.second->plot_curve()->pen();
+		render_curve.antialiased = curve.second->plot_curve()->testRenderHint(
+			QwtPlotItem::RenderAntialiased);
+		render_curve.x_map = canvasMap(curve.second->x_axis_id());
+		render_curve.y_map = canvasMap(curve.second->y_axis_id());
+		render_curves.push_back(render_curve);
+	}
+
+	curve_renderer_->request(canvas()->size(), render_curves);
+}
+
+void Plot::on_curve_image_ready()
+{
+	// Only repaint the canvas, the axes haven't changed.
+	canvas()->update();
+}
+
 void Plot::update_markers_label()
 {
 	if (!markers_label_) {
@@ -967,24 +1315,73 @@ void Plot::update_markers_label()
 	markers_label_->setText(text);
 }
 
-void Plot::timerEvent(QTimerEvent *event)
+void Plot::resizeEvent(QResizeEvent *event)
 {
-	if (event->timerId() == timer_id_) {
-		update_intervals();
-		update_curves();
-		return;
+	for (const auto &curve : curve_map_) {
+		curve.second->plot_direct_painter()->reset();
 	}
 
-	QwtPlot::timerEvent(event);
+	QwtPlot::resizeEvent(event);
+
+	if (persistence_item_)
+		persistence_item_->resize(canvas()->size());
+	if (curve_renderer_)
+		request_curve_image();
 }
 
-void Plot::resizeEvent(QResizeEvent *event)
+void Plot::drawItems(QPainter *painter, const QRectF &canvas_rect,
+	const QwtScaleMap maps[axisCnt]) const
 {
-	for (const auto &curve : curve_map_) {
-		curve.second->plot_direct_painter()->reset();
+	if (update_mode_ != PlotUpdateMode::Rolling) {
+		scroll_cache_->clear();
+		QwtPlot::drawItems(painter, canvas_rect, maps);
+		return;
 	}
 
-	QwtPlot::resizeEvent(event);
+	// Only the canvas itself is cached, not when printing or exporting.
+	bool use_cache = painter->device() == canvas() && !curve_renderer_ &&
+		ScrollCache::is_supported(maps[QwtPlot::xBottom]);
+	vector<const QwtPlotCurve *> cached_curves;
+	const QwtPlotItemList &items = itemList();
+	for (const auto *item : items) {
+		if (!use_cache)
+			break;
+		if (!item->isVisible() || item->rtti() != QwtPlotItem::Rtti_PlotCurve)
+			continue;
+		const auto *plot_curve = static_cast<const QwtPlotCurve *>(item);
+		const Curve *curve = get_curve_from_plot_curve(plot_curve);
+		if (!curve || curve->curve_data()->type() != CurveType::TimeCurve)
+			use_cache = false;
+		else
+			cached_curves.push_back(plot_curve);
+	}
+	if (!use_cache) {
+		scroll_cache_->invalidate();
+		QwtPlot::drawItems(painter, canvas_rect, maps);
+		return;
+	}
+
+	// Same as QwtPlot::drawItems(), but the curves are painted together
+	// from the cache at the z position of the first curve.
+	bool curves_drawn = false;
+	for (auto *item : items) {
+		if (!item->isVisible())
+			continue;
+		if (item->rtti() == QwtPlotItem::Rtti_PlotCurve) {
+			if (!curves_drawn) {
+				scroll_cache_->draw(painter, canvas_rect, maps, cached_curves);
+				curves_drawn = true;
+			}
+			continue;
+		}
+
+		painter->save();
+		painter->setRenderHint(QPainter::Antialiasing,
+			item->testRenderHint(QwtPlotItem::RenderAntialiased));
+		item->draw(painter, maps[item->xAxis()], maps[item->yAxis()],
+			canvas_rect);
+		painter->restore();
+	}
 }
 
 void Plot::showEvent(QShowEvent *event)
@@ -1005,6 +1402,9 @@ void Plot::save_settings(QSettings &settings, bool save_curves,
 	settings.setValue("update_mode", (int)update_mode());
 	settings.setValue("time_span", time_span_);
 	settings.setValue("add_time", add_time_);
+	settings.setValue("threaded_rendering", threaded_rendering());
+	settings.setValue("persistence", persistence());
+	settings.setValue("persistence_decay", persistence_decay_);
 
 	if (!save_curves)
 		return;
@@ -1023,6 +1423,12 @@ void Plot::restore_settings(QSettings &settings, bool restore_curves,
 		time_span_ = settings.value("time_span").toDouble();
 	if (settings.contains("add_time"))
 		add_time_ = settings.value("add_time").toDouble();
+	if (settings.contains("threaded_rendering"))
+		set_threaded_rendering(settings.value("threaded_rendering").toBool());
+	if (settings.contains("persistence_decay"))
+		set_persistence_decay(settings.value("persistence_decay").toInt());
+	if (settings.contains("persistence"))
+		set_persistence(settings.value("persistence").toBool());
 
 	if (!restore_curves)
 		return;
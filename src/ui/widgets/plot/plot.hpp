@@ -28,6 +28,7 @@
 
 #include <QSettings>
 #include <QString>
+#include <QTimer>
 #include <QVariant>
 
 #include <qwt_interval.h>
@@ -63,7 +64,11 @@ namespace plot {
 
 class BaseCurveData;
 class Curve;
+class CurveRenderer;
+class PersistenceItem;
 class PlotMagnifier;
+class ScrollCache;
+class TileCache;
 
 enum class AxisBoundary {
 	LowerBoundary,
@@ -110,7 +115,7 @@ public:
 	void set_axis_locked(int axis_id, AxisBoundary axis_boundary, bool locked);
 	void set_all_axis_locked(bool locked);
 	void set_plot_interval(int plot_interval) { plot_interval_ = plot_interval; }
-	void set_update_mode(PlotUpdateMode update_mode) { update_mode_ = update_mode; }
+	void set_update_mode(PlotUpdateMode update_mode);
 	PlotUpdateMode update_mode() const { return update_mode_; };
 	void set_time_span(double time_span);
 	double time_span() const { return time_span_; }
@@ -119,6 +124,29 @@ public:
 	map<QwtPlotMarker *, Curve *> marker_curve_map() const { return marker_curve_map_; }
 	void set_markers_label_alignment(int alignment);
 	int markers_label_alignment() const { return markers_label_alignment_; }
+	/**
+	 * Rasterize the time curves in a worker thread. The GUI thread only
+	 * paints the resulting image, the axes, markers and legend.
+	 */
+	void set_threaded_rendering(bool threaded_rendering);
+	bool threaded_rendering() const { return curve_renderer_ != nullptr; }
+	/**
+	 * Accumulate the sweeps of the Oscilloscope mode into a persistence
+	 * display under the curves.
+	 */
+	void set_persistence(bool persistence);
+	bool persistence() const { return persistence_item_ != nullptr; }
+	/** Percentage of the persistence hits, that are kept after each sweep. */
+	void set_persistence_decay(int persistence_decay);
+	int persistence_decay() const { return persistence_decay_; }
+	/**
+	 * Called for every zoom or pan event. Until there are no more events for
+	 * `InteractionTimeout` ms, the curves are painted from the envelope tiles
+	 * and without antialiasing and symbols. Afterwards the plot is replotted
+	 * in full quality.
+	 */
+	void begin_interaction();
+	bool is_interactive() const { return interactive_; }
 
 	void save_settings(QSettings &settings, bool save_curves,
 		shared_ptr<sv::devices::BaseDevice> origin_device) const;
@@ -138,28 +166,44 @@ public Q_SLOTS:
 	void on_marker_moved(const QPointF mouse_pos);
 	void on_legend_clicked(const QVariant &item_info, int index);
 
+private Q_SLOTS:
+	void on_curve_image_ready();
+	void on_tiles_ready();
+	void end_interaction();
+
 protected:
 	virtual void showEvent(QShowEvent *event) override;
 	virtual void resizeEvent(QResizeEvent *event) override;
-	virtual void timerEvent(QTimerEvent *event) override;
+	/**
+	 * In Rolling mode the time curves are painted from a ScrollCache, so
+	 * moving the x axis doesn't repaint every visible sample.
+	 */
+	virtual void drawItems(QPainter *painter, const QRectF &canvas_rect,
+		const QwtScaleMap maps[axisCnt]) const override;
 
 private:
 	int init_x_axis(BaseCurveData *curve_data, int x_axis_id = -1);
 	int init_y_axis(BaseCurveData *curve_data, int y_axis_id = -1);
 	void init_axis(int axis_id, double min, double max, const QString &title,
 		bool auto_scale);
+	/** Called by the render scheduler of the session. */
+	void on_render(bool catch_up);
 	void update_curves();
-	void update_intervals();
+	/** Return true, when an interval has changed and the plot was replotted. */
+	bool update_intervals();
 	bool update_x_interval(Curve *curve);
 	bool update_y_interval(const Curve *curve);
 	void update_markers_label();
+	void update_persistence();
+	void update_offscreen_rendering(Curve *curve);
+	void update_interactive(Curve *curve);
+	void request_curve_image();
 	Curve *get_curve_from_plot_curve(const QwtPlotCurve *plot_curve) const;
 
 	Session &session_;
 	map<string, Curve *> curve_map_;
 	map<int, map<AxisBoundary, bool>> axis_lock_map_; // map<axis_id, map<AxisBoundary, locked>>
 	int plot_interval_;
-	int timer_id_;
 	PlotUpdateMode update_mode_;
 	double time_span_;
 	double add_time_;
@@ -175,6 +219,21 @@ private:
 	QwtPlotPicker *marker_select_picker_;
 	QwtPlotPicker *marker_move_picker_;
 
+	CurveRenderer *curve_renderer_;
+	QwtPlotItem *curve_image_item_;
+	ScrollCache *scroll_cache_;
+	PersistenceItem *persistence_item_;
+	int persistence_decay_;
+	/** Position of the next sample of each curve for the persistence. */
+	map<Curve *, size_t> persistence_pos_;
+	/** Set while replotting for changed axis intervals. */
+	bool keep_scroll_cache_;
+	TileCache *tile_cache_;
+	QTimer *interaction_timer_;
+	bool interactive_;
+
+	static const int InteractionTimeout;
+
 Q_SIGNALS:
 	void axis_lock_changed(int axis_id,
 		sv::ui::widgets::plot::AxisBoundary axis_boundary, bool locked);
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QPainter>
+#include <QPointF>
+#include <QPolygonF>
+#include <QRectF>
+#include <qwt_painter.h>
+#include <qwt_plot_curve.h>
+#include <qwt_scale_map.h>
+#include <qwt_symbol.h>
+
+#include "plotcurve.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/tilecache.hpp"
+#include "src/ui/widgets/plot/timecurvedata.hpp"
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+PlotCurve::PlotCurve(BaseCurveData *curve_data) :
+	QwtPlotCurve(),
+	curve_data_(curve_data),
+	offscreen_rendering_(false),
+	tile_cache_(nullptr),
+	interactive_(false)
+{
+	setData(curve_data_);
+}
+
+void PlotCurve::set_offscreen_rendering(bool offscreen_rendering)
+{
+	offscreen_rendering_ = offscreen_rendering;
+}
+
+bool PlotCurve::is_offscreen_rendering() const
+{
+	return offscreen_rendering_;
+}
+
+void PlotCurve::set_tile_cache(TileCache *tile_cache)
+{
+	tile_cache_ = tile_cache;
+}
+
+void PlotCurve::set_interactive(bool interactive)
+{
+	interactive_ = interactive;
+}
+
+bool PlotCurve::is_interactive() const
+{
+	return interactive_;
+}
+
+void PlotCurve::drawSeries(QPainter *painter,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+	const QRectF &canvas_rect, int from, int to) const
+{
+	if (offscreen_rendering_)
+		return;
+
+	// The painter state is restored by QwtPlot::drawItems() for each item.
+	if (interactive_)
+		painter->setRenderHint(QPainter::Antialiasing, false);
+
+	if (curve_data_->type() != CurveType::TimeCurve) {
+		if (interactive_) {
+			draw_series_lines(painter, x_map, y_map, canvas_rect, from, to);
+			return;
+		}
+		QwtPlotCurve::drawSeries(
+			painter, x_map, y_map, canvas_rect, from, to);
+		return;
+	}
+
+	/*
+	 * QwtPlotSeriesItem::draw() paints the whole curve with to = -1, the
+	 * direct painter always passes the index of the last new sample.
+	 */
+	auto *time_curve_data = static_cast<TimeCurveData *>(curve_data_);
+	const bool decimated = to < 0;
+	if (decimated) {
+		const int columns = (int)std::ceil(std::fabs(x_map.pDist()));
+		const double x_min = std::min(x_map.s1(), x_map.s2());
+		const double x_max = std::max(x_map.s1(), x_map.s2());
+		if (interactive_ && tile_cache_) {
+			time_curve_data->begin_tiled_decimation(
+				x_min, x_max, columns, tile_cache_);
+		}
+		else
+			time_curve_data->begin_decimation(x_min, x_max, columns);
+	}
+
+	if (!is_polyline() && interactive_) {
+		draw_series_lines(painter, x_map, y_map, canvas_rect, from, to);
+	}
+	else if (!is_polyline()) {
+		QwtPlotCurve::drawSeries(
+			painter, x_map, y_map, canvas_rect, from, to);
+	}
+	else {
+		const int size = (int)time_curve_data->size();
+		if (to < 0 || to >= size)
+			to = size - 1;
+		if (from < 0)
+			from = 0;
+		if (from < to) {
+			draw_time_curve_lines(painter, x_map, y_map, time_curve_data,
+				decimated, (size_t)from, (size_t)to);
+		}
+		if (from <= to && !interactive_ &&
+				symbol() && symbol()->style() != QwtSymbol::NoSymbol) {
+			painter->save();
+			drawSymbols(painter, *symbol(), x_map, y_map, canvas_rect,
+				from, to);
+			painter->restore();
+		}
+	}
+
+	if (decimated)
+		time_curve_data->end_decimation();
+}
+
+bool PlotCurve::is_polyline() const
+{
+	return style() == QwtPlotCurve::Lines &&
+		!testCurveAttribute(QwtPlotCurve::Fitted) &&
+		brush().style() == Qt::NoBrush;
+}
+
+void PlotCurve::draw_series_lines(QPainter *painter,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+	const QRectF &canvas_rect, int from, int to) const
+{
+	const int size = (int)dataSize();
+	if (to < 0 || to >= size)
+		to = size - 1;
+	if (from < 0)
+		from = 0;
+	if (from > to)
+		return;
+
+	painter->save();
+	painter->setPen(pen());
+	drawCurve(painter, style(), x_map, y_map, canvas_rect, from, to);
+	painter->restore();
+}
+
+void PlotCurve::draw_time_curve_lines(QPainter *painter,
+	const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+	const TimeCurveData *curve_data, bool decimated,
+	size_t from, size_t to) const
+{
+	// The signal can grow in the acquisition thread, so the samples are
+	// copied with the lock held.
+	const auto signal = curve_data->signal();
+	size_t count;
+	if (decimated) {
+		const auto &positions = curve_data->decimated_pos();
+		count = signal->get_samples_at(positions.data() + from, to - from + 1,
+			timestamps_, values_, false);
+	}
+	else {
+		count = signal->get_samples(from, to + 1, timestamps_, values_, false);
+	}
+
+	const double x_offset = curve_data->x_offset();
+	QPolygonF polyline;
+	polyline.reserve((int)count);
+	for (size_t i=0; i<count; ++i) {
+		polyline.append(QPointF(
+			x_map.transform(timestamps_[i] - x_offset),
+			y_map.transform(values_[i])));
+	}
+
+	painter->save();
+	painter->setPen(pen());
+	QwtPainter::drawPolyline(painter, polyline);
+	painter->restore();
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_PLOTCURVE_HPP
+#define UI_WIDGETS_PLOT_PLOTCURVE_HPP
+
+#include <vector>
+
+#include <QPainter>
+#include <QRectF>
+#include <qwt_plot_curve.h>
+#include <qwt_scale_map.h>
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+class BaseCurveData;
+class TileCache;
+class TimeCurveData;
+
+/**
+ * QwtPlotCurve that reduces time curves to the pixel resolution of the
+ * canvas, when the whole curve is painted (e.g. on replot, zoom, pan or
+ * resize). Incremental painting with QwtPlotDirectPainter is not affected.
+ *
+ * The lines of time curves are painted from the samples, that are copied
+ * from the signal in one go, instead of calling the virtual
+ * QwtSeriesData::sample() for every point.
+ *
+ * While the user is zooming or panning (see set_interactive()), time curves
+ * are reduced with the envelope tiles of the TileCache, and the curve is
+ * painted without antialiasing and symbols.
+ */
+class PlotCurve : public QwtPlotCurve
+{
+
+public:
+	explicit PlotCurve(BaseCurveData *curve_data);
+
+	/**
+	 * When set, the curve isn't painted by Qwt, because it is rasterized by
+	 * the CurveRenderer of the plot.
+	 */
+	void set_offscreen_rendering(bool offscreen_rendering);
+	bool is_offscreen_rendering() const;
+	void set_tile_cache(TileCache *tile_cache);
+	/**
+	 * Paint the curve as fast as possible, until the next full quality
+	 * replot.
+	 */
+	void set_interactive(bool interactive);
+	bool is_interactive() const;
+
+	void drawSeries(QPainter *painter,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		const QRectF &canvas_rect, int from, int to) const override;
+
+private:
+	/**
+	 * Return true if the curve can be painted as plain polyline from the
+	 * signal data.
+	 */
+	bool is_polyline() const;
+	/** Like QwtPlotCurve::drawSeries(), but without the symbols. */
+	void draw_series_lines(QPainter *painter,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		const QRectF &canvas_rect, int from, int to) const;
+	void draw_time_curve_lines(QPainter *painter,
+		const QwtScaleMap &x_map, const QwtScaleMap &y_map,
+		const TimeCurveData *curve_data, bool decimated,
+		size_t from, size_t to) const;
+
+	BaseCurveData *curve_data_;
+	bool offscreen_rendering_;
+	TileCache *tile_cache_;
+	bool interactive_;
+	/** Reused buffers for the copied samples. */
+	mutable vector<double> timestamps_;
+	mutable vector<double> values_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_PLOTCURVE_HPP
@@ -34,6 +34,7 @@ PlotMagnifier::PlotMagnifier(QWidget *canvas) :
 
 void PlotMagnifier::rescale(double factor)
 {
+	Q_EMIT about_to_magnify();
 	QwtPlotMagnifier::rescale(factor);
 	Q_EMIT magnified(factor);
 }
@@ -45,6 +45,8 @@ protected:
 	void rescale(double factor) override;
 
 Q_SIGNALS:
+	/** Emitted before the axes are rescaled and the plot is replotted. */
+	void about_to_magnify();
 	void magnified(double factor);
 
 };
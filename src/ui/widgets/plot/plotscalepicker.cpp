@@ -126,6 +126,7 @@ bool PlotScalePicker::eventFilter(QObject *object, QEvent *event)
 
 				plot_->setAxisScale(axis_id, s1, s2);
 				plot_->setAutoReplot(auto_replot);
+				plot_->begin_interaction();
 				plot_->replot();
 
 				return true;
@@ -195,6 +196,7 @@ bool PlotScalePicker::eventFilter(QObject *object, QEvent *event)
 
 				plot_->setAxisScale(axis_id, v1, v2);
 				plot_->setAutoReplot(auto_replot);
+				plot_->begin_interaction();
 				plot_->replot();
 
 				return true;
@@ -0,0 +1,220 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <QPainter>
+#include <QPixmap>
+#include <QRect>
+#include <QRectF>
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+#include <qwt_scale_map.h>
+
+#include "scrollcache.hpp"
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+ScrollCache::ScrollCache() :
+	valid_(false),
+	origin_(0.),
+	x_end_(0.)
+{
+}
+
+void ScrollCache::invalidate()
+{
+	valid_ = false;
+}
+
+void ScrollCache::clear()
+{
+	valid_ = false;
+	pixmap_ = QPixmap();
+	curves_.clear();
+}
+
+bool ScrollCache::is_supported(const QwtScaleMap &x_map)
+{
+	return x_map.transformation() == nullptr &&
+		x_map.sDist() > 0. && x_map.p2() > x_map.p1();
+}
+
+void ScrollCache::draw(QPainter *painter, const QRectF &canvas_rect,
+	const QwtScaleMap maps[QwtPlot::axisCnt],
+	const vector<const QwtPlotCurve *> &curves)
+{
+	const QwtScaleMap &x_map = maps[QwtPlot::xBottom];
+	const double scale = x_map.pDist() / x_map.sDist();
+	const qreal dpr = painter->device()->devicePixelRatioF();
+
+	// Samples, that are appended while rendering, are rendered next time.
+	const double x_end = curves_x_end(curves);
+
+	if (!valid_ || x_end < x_end_ ||
+			is_rescaled(canvas_rect, maps, curves, dpr)) {
+		reset(canvas_rect, maps, curves, dpr);
+		render(curves, std::numeric_limits<double>::lowest());
+	}
+	else {
+		const int dx = (int)std::lround((x_map.s1() - origin_) * scale);
+		if (dx < 0 || dx >= pixmap_.width() / dpr) {
+			reset(canvas_rect, maps, curves, dpr);
+			render(curves, std::numeric_limits<double>::lowest());
+		}
+		else {
+			if (dx > 0) {
+				scroll(dx);
+				// Keep the origin on whole pixels, so the rounding errors of
+				// the shifts don't accumulate.
+				origin_ += (double)dx / scale;
+			}
+			render(curves, x_end_);
+		}
+	}
+	x_end_ = x_end;
+
+	// The remaining offset is less than half a pixel.
+	painter->drawPixmap(QPointF(
+		canvas_rect.left() + (origin_ - x_map.s1()) * scale,
+		canvas_rect.top()), pixmap_);
+}
+
+bool ScrollCache::is_rescaled(const QRectF &canvas_rect,
+	const QwtScaleMap maps[QwtPlot::axisCnt],
+	const vector<const QwtPlotCurve *> &curves, qreal dpr) const
+{
+	if (canvas_rect != canvas_rect_ || pixmap_.devicePixelRatioF() != dpr)
+		return true;
+	if (curves != curves_)
+		return true;
+
+	const QwtScaleMap &x_map = maps[QwtPlot::xBottom];
+	const QwtScaleMap &cached_x_map = maps_[QwtPlot::xBottom];
+	if (x_map.sDist() != cached_x_map.sDist() ||
+			x_map.p1() != cached_x_map.p1() || x_map.p2() != cached_x_map.p2())
+		return true;
+
+	for (const int axis_id : { QwtPlot::yLeft, QwtPlot::yRight }) {
+		if (maps[axis_id].s1() != maps_[axis_id].s1() ||
+				maps[axis_id].s2() != maps_[axis_id].s2() ||
+				maps[axis_id].p1() != maps_[axis_id].p1() ||
+				maps[axis_id].p2() != maps_[axis_id].p2())
+			return true;
+	}
+
+	return false;
+}
+
+void ScrollCache::reset(const QRectF &canvas_rect,
+	const QwtScaleMap maps[QwtPlot::axisCnt],
+	const vector<const QwtPlotCurve *> &curves, qreal dpr)
+{
+	const QSize size = canvas_rect.size().toSize() * dpr;
+	if (pixmap_.size() != size)
+		pixmap_ = QPixmap(size);
+	pixmap_.setDevicePixelRatio(dpr);
+	pixmap_.fill(Qt::transparent);
+
+	canvas_rect_ = canvas_rect;
+	for (int i=0; i<QwtPlot::axisCnt; ++i)
+		maps_[i] = maps[i];
+	curves_ = curves;
+	origin_ = maps[QwtPlot::xBottom].s1();
+	valid_ = true;
+}
+
+void ScrollCache::scroll(int dx)
+{
+	const qreal dpr = pixmap_.devicePixelRatioF();
+	const int device_dx = (int)std::lround(dx * dpr);
+	pixmap_.scroll(-device_dx, 0, pixmap_.rect());
+
+	QPainter painter(&pixmap_);
+	painter.setCompositionMode(QPainter::CompositionMode_Source);
+	const double width = pixmap_.width() / dpr;
+	painter.fillRect(QRectF(width - dx, 0, dx, pixmap_.height() / dpr),
+		Qt::transparent);
+}
+
+void ScrollCache::render(const vector<const QwtPlotCurve *> &curves,
+	double x_from)
+{
+	// Same transformation as the cached x map, but moved to the origin.
+	QwtScaleMap x_map = maps_[QwtPlot::xBottom];
+	const double scale = x_map.pDist() / x_map.sDist();
+	double s1 = origin_;
+	const double s2 = origin_ + x_map.sDist();
+	double p1 = x_map.p1();
+	const double p2 = x_map.p2();
+
+	// The strip starts one pixel left of the last painted sample, so the
+	// line to the next sample is connected.
+	double strip_left = canvas_rect_.left();
+	if (x_from > s1) {
+		strip_left = std::floor(p1 + (x_from - s1) * scale) - 1;
+		if (strip_left >= canvas_rect_.right())
+			return;
+		s1 += (strip_left - p1) / scale;
+		p1 = strip_left;
+	}
+	x_map.setScaleInterval(s1, s2);
+	x_map.setPaintInterval(p1, p2);
+
+	QPainter painter(&pixmap_);
+	// Pixel 0 of the pixmap is the left edge of the canvas rect
+	painter.translate(-canvas_rect_.topLeft());
+	const QRectF strip(strip_left, canvas_rect_.top(),
+		canvas_rect_.right() - strip_left, canvas_rect_.height());
+	painter.setClipRect(strip);
+	painter.setCompositionMode(QPainter::CompositionMode_Source);
+	painter.fillRect(strip, Qt::transparent);
+	painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+	for (const auto *curve : curves) {
+		painter.save();
+		painter.setRenderHint(QPainter::Antialiasing,
+			curve->testRenderHint(QwtPlotItem::RenderAntialiased));
+		curve->draw(&painter, x_map, maps_[curve->yAxis()], canvas_rect_);
+		painter.restore();
+	}
+}
+
+double ScrollCache::curves_x_end(const vector<const QwtPlotCurve *> &curves)
+{
+	double x_end = std::numeric_limits<double>::lowest();
+	for (const auto *curve : curves) {
+		if (curve->dataSize() > 0)
+			x_end = std::max(x_end, curve->data()->boundingRect().right());
+	}
+	return x_end;
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
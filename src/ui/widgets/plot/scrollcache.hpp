@@ -0,0 +1,105 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_SCROLLCACHE_HPP
+#define UI_WIDGETS_PLOT_SCROLLCACHE_HPP
+
+#include <vector>
+
+#include <QPainter>
+#include <QPixmap>
+#include <QRectF>
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+#include <qwt_scale_map.h>
+
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * Keeps the rendered time curves of a plot in Rolling mode as a pixmap.
+ *
+ * When the x axis is moved, the pixmap is scrolled by the pixel delta and
+ * only the newly exposed strip and the samples that were added since the
+ * last paint are rendered. The whole pixmap is only rendered again, when the
+ * canvas, the scale of an axis or the curves have changed.
+ *
+ * The samples of time curves are sorted by time, so everything left of the
+ * last painted sample is complete.
+ */
+class ScrollCache
+{
+
+public:
+	ScrollCache();
+
+	/** Render the whole pixmap on the next draw(). */
+	void invalidate();
+	/** Free the pixmap. */
+	void clear();
+
+	/**
+	 * Return true when the x map can be handled by the cache (linear and
+	 * increasing to the right).
+	 */
+	static bool is_supported(const QwtScaleMap &x_map);
+
+	/**
+	 * Paint `curves` onto `painter`, only the parts that are not already in
+	 * the cache are rendered.
+	 */
+	void draw(QPainter *painter, const QRectF &canvas_rect,
+		const QwtScaleMap maps[QwtPlot::axisCnt],
+		const vector<const QwtPlotCurve *> &curves);
+
+private:
+	bool is_rescaled(const QRectF &canvas_rect,
+		const QwtScaleMap maps[QwtPlot::axisCnt],
+		const vector<const QwtPlotCurve *> &curves, qreal dpr) const;
+	void reset(const QRectF &canvas_rect,
+		const QwtScaleMap maps[QwtPlot::axisCnt],
+		const vector<const QwtPlotCurve *> &curves, qreal dpr);
+	/** Move the content `dx` pixels to the left and clear the exposed strip. */
+	void scroll(int dx);
+	/** Render the curves right of `x_from` (in data coordinates). */
+	void render(const vector<const QwtPlotCurve *> &curves, double x_from);
+	static double curves_x_end(const vector<const QwtPlotCurve *> &curves);
+
+	QPixmap pixmap_;
+	bool valid_;
+	QRectF canvas_rect_;
+	QwtScaleMap maps_[QwtPlot::axisCnt];
+	vector<const QwtPlotCurve *> curves_;
+	/** x value at the start of the paint interval of the cached x map. */
+	double origin_;
+	/** x value of the last sample in the pixmap. */
+	double x_end_;
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_SCROLLCACHE_HPP
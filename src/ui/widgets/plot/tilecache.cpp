@@ -0,0 +1,274 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "tilecache.hpp"
+#include "src/data/analogtimesignal.hpp"
+#include "src/data/envelopetile.hpp"
+
+using std::get;
+using std::lock_guard;
+using std::make_shared;
+using std::mutex;
+using std::unique_lock;
+using std::vector;
+
+namespace sv {
+namespace ui {
+namespace widgets {
+namespace plot {
+
+const size_t TileCache::MaxTiles = 1024;
+const size_t TileCache::MaxRequests = 64;
+const size_t TileCache::ChunkSize = 65536;
+
+TileCache::TileCache() :
+	QObject(),
+	abort_(false),
+	use_count_(0),
+	generation_count_(0),
+	has_new_tiles_(false)
+{
+	build_thread_ = std::thread(&TileCache::build_thread_proc, this);
+}
+
+TileCache::~TileCache()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		abort_ = true;
+		for (const auto &signal_entry : signals_)
+			disconnect(signal_entry.second.connection);
+	}
+	request_cond_.notify_one();
+	build_thread_.join();
+}
+
+shared_ptr<const sv::data::EnvelopeTile> TileCache::tile(
+	shared_ptr<sv::data::AnalogTimeSignal> signal, int level, int64_t index)
+{
+	// Only complete tiles are built.
+	const bool is_complete = signal->sample_count() > 0 &&
+		signal->last_timestamp(false) >=
+			(double)(index + 1) * sv::data::EnvelopeTile::tile_width(level);
+
+	lock_guard<mutex> lock(mutex_);
+
+	const TileKey key(signal.get(), level, index);
+	auto tile_it = tiles_.find(key);
+	if (tile_it != tiles_.end()) {
+		tile_it->second.last_use = ++use_count_;
+		return tile_it->second.tile;
+	}
+	if (!is_complete || pending_.count(key) > 0)
+		return nullptr;
+
+	auto signal_it = signals_.find(signal.get());
+	if (signal_it == signals_.end()) {
+		const sv::data::AnalogTimeSignal *signal_ptr = signal.get();
+		SignalEntry signal_entry;
+		signal_entry.signal = signal;
+		signal_entry.generation = ++generation_count_;
+		// The samples can be cleared from the acquisition thread.
+		signal_entry.connection = connect(
+			signal.get(), &sv::data::AnalogTimeSignal::samples_cleared,
+			this, [this, signal_ptr]() { clear_tiles(signal_ptr); },
+			Qt::DirectConnection);
+		signal_it = signals_.insert(
+			std::make_pair(signal.get(), signal_entry)).first;
+	}
+
+	requests_.push_front({ signal, level, index, signal_it->second.generation });
+	pending_.insert(key);
+	// Drop the oldest requests, they are most likely not visible anymore.
+	while (requests_.size() > MaxRequests) {
+		const Request &request = requests_.back();
+		pending_.erase(TileKey(
+			request.signal.get(), request.level, request.index));
+		requests_.pop_back();
+	}
+	request_cond_.notify_one();
+
+	return nullptr;
+}
+
+void TileCache::remove(shared_ptr<sv::data::AnalogTimeSignal> signal)
+{
+	lock_guard<mutex> lock(mutex_);
+
+	auto signal_it = signals_.find(signal.get());
+	if (signal_it == signals_.end())
+		return;
+	disconnect(signal_it->second.connection);
+	signals_.erase(signal_it);
+
+	auto tile_it = tiles_.lower_bound(TileKey(signal.get(),
+		std::numeric_limits<int>::min(), std::numeric_limits<int64_t>::min()));
+	while (tile_it != tiles_.end() && get<0>(tile_it->first) == signal.get())
+		tile_it = tiles_.erase(tile_it);
+
+	for (auto it = requests_.begin(); it != requests_.end(); ) {
+		if (it->signal == signal) {
+			pending_.erase(TileKey(signal.get(), it->level, it->index));
+			it = requests_.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
+void TileCache::build_thread_proc()
+{
+	while (true) {
+		Request request;
+		shared_ptr<const sv::data::EnvelopeTile> first;
+		shared_ptr<const sv::data::EnvelopeTile> second;
+		{
+			unique_lock<mutex> lock(mutex_);
+			request_cond_.wait(lock,
+				[this] { return abort_ || !requests_.empty(); });
+			if (abort_)
+				return;
+			request = requests_.front();
+			requests_.pop_front();
+
+			first = find_tile(
+				request.signal.get(), request.level - 1, 2 * request.index);
+			second = find_tile(
+				request.signal.get(), request.level - 1, 2 * request.index + 1);
+		}
+
+		auto tile = build_tile(request, first, second);
+
+		bool emit_ready = false;
+		{
+			lock_guard<mutex> lock(mutex_);
+			const TileKey key(
+				request.signal.get(), request.level, request.index);
+			pending_.erase(key);
+
+			// The samples of the signal may have been cleared in the meantime.
+			auto signal_it = signals_.find(request.signal.get());
+			if (tile && signal_it != signals_.end() &&
+					signal_it->second.generation == request.generation) {
+				tiles_[key] = { tile, ++use_count_ };
+				if (tiles_.size() > MaxTiles)
+					drop_least_recently_used();
+				has_new_tiles_ = true;
+			}
+
+			if (requests_.empty() && has_new_tiles_) {
+				has_new_tiles_ = false;
+				emit_ready = true;
+			}
+		}
+		if (emit_ready)
+			Q_EMIT tiles_ready();
+	}
+}
+
+shared_ptr<const sv::data::EnvelopeTile> TileCache::build_tile(
+	const Request &request,
+	shared_ptr<const sv::data::EnvelopeTile> first,
+	shared_ptr<const sv::data::EnvelopeTile> second)
+{
+	if (first && second) {
+		return make_shared<sv::data::EnvelopeTile>(
+			sv::data::EnvelopeTile::merge(*first, *second));
+	}
+
+	auto tile = make_shared<sv::data::EnvelopeTile>(
+		request.level, request.index);
+	size_t pos = request.signal->find_sample_pos(tile->start(), false);
+	const size_t end_pos = request.signal->find_sample_pos(tile->end(), false);
+	if (end_pos >= request.signal->sample_count())
+		return nullptr;
+
+	while (pos < end_pos) {
+		{
+			lock_guard<mutex> lock(mutex_);
+			if (abort_)
+				return nullptr;
+		}
+		const size_t count = request.signal->get_samples(
+			pos, std::min(pos + ChunkSize, end_pos), timestamps_, values_, false);
+		if (count == 0)
+			return nullptr;
+		tile->add_samples(pos, timestamps_.data(), values_.data(), count);
+		pos += count;
+	}
+
+	return tile;
+}
+
+shared_ptr<const sv::data::EnvelopeTile> TileCache::find_tile(
+	const sv::data::AnalogTimeSignal *signal, int level, int64_t index) const
+{
+	auto it = tiles_.find(TileKey(signal, level, index));
+	if (it == tiles_.end())
+		return nullptr;
+	return it->second.tile;
+}
+
+void TileCache::clear_tiles(const sv::data::AnalogTimeSignal *signal)
+{
+	lock_guard<mutex> lock(mutex_);
+
+	auto signal_it = signals_.find(signal);
+	if (signal_it == signals_.end())
+		return;
+	signal_it->second.generation = ++generation_count_;
+
+	auto tile_it = tiles_.lower_bound(TileKey(signal,
+		std::numeric_limits<int>::min(), std::numeric_limits<int64_t>::min()));
+	while (tile_it != tiles_.end() && get<0>(tile_it->first) == signal)
+		tile_it = tiles_.erase(tile_it);
+}
+
+void TileCache::drop_least_recently_used()
+{
+	// Drop a quarter of the tiles at once, so this isn't done for every tile.
+	vector<uint64_t> last_uses;
+	last_uses.reserve(tiles_.size());
+	for (const auto &entry : tiles_)
+		last_uses.push_back(entry.second.last_use);
+	auto threshold_it = last_uses.begin() + MaxTiles / 4;
+	std::nth_element(last_uses.begin(), threshold_it, last_uses.end());
+	const uint64_t threshold = *threshold_it;
+
+	for (auto it = tiles_.begin(); it != tiles_.end(); ) {
+		if (it->second.last_use <= threshold)
+			it = tiles_.erase(it);
+		else
+			++it;
+	}
+}
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
@@ -0,0 +1,161 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UI_WIDGETS_PLOT_TILECACHE_HPP
+#define UI_WIDGETS_PLOT_TILECACHE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <QMetaObject>
+#include <QObject>
+
+#include "src/data/envelopetile.hpp"
+
+using std::condition_variable;
+using std::deque;
+using std::map;
+using std::mutex;
+using std::set;
+using std::shared_ptr;
+using std::tuple;
+using std::vector;
+
+namespace sv {
+
+namespace data {
+class AnalogTimeSignal;
+}
+
+namespace ui {
+namespace widgets {
+namespace plot {
+
+/**
+ * Cache of the EnvelopeTiles of the time curves of a plot.
+ *
+ * Tiles, that are not in the cache yet, are built in a worker thread. When
+ * both halves of a tile are already cached, the tile is merged from them,
+ * otherwise the samples are read from the signal in chunks. Only complete
+ * tiles are cached, i.e. tiles that end before the last sample of the
+ * signal, because they won't change anymore.
+ *
+ * When more than `MaxTiles` tiles are cached, the least recently used tiles
+ * are dropped.
+ */
+class TileCache : public QObject
+{
+	Q_OBJECT
+
+public:
+	TileCache();
+	~TileCache();
+
+	/**
+	 * Return the tile of the signal, or nullptr if the tile isn't cached.
+	 * A missing complete tile is queued for building, `tiles_ready()` is
+	 * emitted when it is available.
+	 */
+	shared_ptr<const sv::data::EnvelopeTile> tile(
+		shared_ptr<sv::data::AnalogTimeSignal> signal,
+		int level, int64_t index);
+	/**
+	 * Drop all tiles of the signal.
+	 */
+	void remove(shared_ptr<sv::data::AnalogTimeSignal> signal);
+
+	static const size_t MaxTiles;
+	static const size_t MaxRequests;
+
+private:
+	typedef tuple<const sv::data::AnalogTimeSignal *, int, int64_t> TileKey;
+
+	struct Entry {
+		shared_ptr<const sv::data::EnvelopeTile> tile;
+		uint64_t last_use;
+	};
+
+	struct Request {
+		shared_ptr<sv::data::AnalogTimeSignal> signal;
+		int level;
+		int64_t index;
+		uint64_t generation;
+	};
+
+	struct SignalEntry {
+		/** Keeps the address of the signal unique while tiles are cached. */
+		shared_ptr<sv::data::AnalogTimeSignal> signal;
+		/** Changed when the samples of the signal are cleared. */
+		uint64_t generation;
+		QMetaObject::Connection connection;
+	};
+
+	void build_thread_proc();
+	shared_ptr<const sv::data::EnvelopeTile> build_tile(
+		const Request &request,
+		shared_ptr<const sv::data::EnvelopeTile> first,
+		shared_ptr<const sv::data::EnvelopeTile> second);
+	shared_ptr<const sv::data::EnvelopeTile> find_tile(
+		const sv::data::AnalogTimeSignal *signal,
+		int level, int64_t index) const;
+	void clear_tiles(const sv::data::AnalogTimeSignal *signal);
+	void drop_least_recently_used();
+
+	std::thread build_thread_;
+	mutable mutex mutex_;
+	condition_variable request_cond_;
+	bool abort_;
+	map<TileKey, Entry> tiles_;
+	map<const sv::data::AnalogTimeSignal *, SignalEntry> signals_;
+	/** The most recent request is at the front. */
+	deque<Request> requests_;
+	set<TileKey> pending_;
+	uint64_t use_count_;
+	uint64_t generation_count_;
+	/** Set when a tile was added since the last `tiles_ready()`. */
+	bool has_new_tiles_;
+
+	/** Buffers for reading the signals in chunks. */
+	vector<double> timestamps_;
+	vector<double> values_;
+
+	static const size_t ChunkSize;
+
+Q_SIGNALS:
+	/**
+	 * Emitted from the worker thread, when all queued tiles are built.
+	 */
+	void tiles_ready();
+
+};
+
+} // namespace plot
+} // namespace widgets
+} // namespace ui
+} // namespace sv
+
+#endif // UI_WIDGETS_PLOT_TILECACHE_HPP
@@ -17,8 +17,12 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include <QPointF>
 #include <QRectF>
@@ -30,22 +34,34 @@
 #include "src/settingsmanager.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/envelopetile.hpp"
+#include "src/data/minmaxindex.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
+#include "src/ui/widgets/plot/tilecache.hpp"
 
 using std::dynamic_pointer_cast;
 using std::set;
 using std::shared_ptr;
+using std::vector;
 
 namespace sv {
 namespace ui {
 namespace widgets {
 namespace plot {
 
+const size_t TimeCurveData::DecimationColumnSamples = 4;
+
 TimeCurveData::TimeCurveData(shared_ptr<sv::data::AnalogTimeSignal> signal) :
 	BaseCurveData(CurveType::TimeCurve),
-	signal_(signal)
+	signal_(signal),
+	min_max_index_([this](size_t pos, size_t end_pos, vector<double> &values) {
+		signal_->get_samples(pos, end_pos, index_timestamps_, values, false);
+	}),
+	is_decimated_(false)
 {
+	connect(signal_.get(), &sv::data::AnalogTimeSignal::samples_cleared,
+		this, &TimeCurveData::on_samples_cleared);
 }
 
 bool TimeCurveData::is_equal(const BaseCurveData *other) const
@@ -61,6 +77,8 @@ QPointF TimeCurveData::sample(size_t index) const
 {
 	//signal_data_->lock();
 
+	if (is_decimated_)
+		index = decimated_pos_[index];
 	auto sample = signal_->get_sample(index, relative_time_);
 	QPointF sample_point(sample.first, sample.second);
 
@@ -72,6 +90,8 @@ QPointF TimeCurveData::sample(size_t index) const
 size_t TimeCurveData::size() const
 {
 	// TODO: Synchronize x/y sample data
+	if (is_decimated_)
+		return decimated_pos_.size();
 	return signal_->sample_count();
 }
 
@@ -195,6 +215,184 @@ shared_ptr<sv::data::AnalogTimeSignal> TimeCurveData::signal() const
 	return signal_;
 }
 
+void TimeCurveData::visible_range(double x_min, double x_max,
+	size_t &pos, size_t &end_pos) const
+{
+	const size_t sample_count = signal_->sample_count();
+	pos = signal_->find_sample_pos(x_min, relative_time_);
+	end_pos = signal_->find_sample_pos(x_max, relative_time_);
+	// Add one neighbour on each side, so the lines to the samples outside of
+	// the interval are drawn.
+	if (pos > 0)
+		--pos;
+	if (end_pos < sample_count)
+		++end_pos;
+}
+
+void TimeCurveData::begin_decimation(double x_min, double x_max, int columns)
+{
+	decimated_pos_.clear();
+	is_decimated_ = true;
+
+	const size_t sample_count = signal_->sample_count();
+	if (sample_count == 0 || columns <= 0 || x_max <= x_min)
+		return;
+
+	size_t pos;
+	size_t end_pos;
+	visible_range(x_min, x_max, pos, end_pos);
+
+	if (end_pos - pos <= DecimationColumnSamples * (size_t)columns) {
+		for (size_t i=pos; i<end_pos; ++i)
+			decimated_pos_.push_back(i);
+		return;
+	}
+
+	// The signal could have been cleared in the meantime
+	min_max_index_.update(sample_count);
+	end_pos = std::min(end_pos, min_max_index_.size());
+	if (pos >= end_pos)
+		return;
+
+	add_decimation_columns(pos, end_pos,
+		x_min, (x_max - x_min) / columns, columns);
+}
+
+void TimeCurveData::begin_tiled_decimation(double x_min, double x_max,
+	int columns, TileCache *tile_cache)
+{
+	decimated_pos_.clear();
+	is_decimated_ = true;
+
+	const size_t sample_count = signal_->sample_count();
+	if (sample_count == 0 || columns <= 0 || x_max <= x_min)
+		return;
+
+	size_t pos;
+	size_t end_pos;
+	visible_range(x_min, x_max, pos, end_pos);
+
+	if (end_pos - pos <= DecimationColumnSamples * (size_t)columns) {
+		for (size_t i=pos; i<end_pos; ++i)
+			decimated_pos_.push_back(i);
+		return;
+	}
+
+	// The signal could have been cleared in the meantime
+	min_max_index_.update(sample_count);
+	end_pos = std::min(end_pos, min_max_index_.size());
+	if (pos >= end_pos)
+		return;
+
+	// The tiles are built from the absolute timestamps.
+	const double offset = x_offset();
+	const double column_width = (x_max - x_min) / columns;
+	const int level = sv::data::EnvelopeTile::level_for_width(column_width);
+	const int64_t first_index =
+		sv::data::EnvelopeTile::index_for_time(level, x_min + offset);
+	const int64_t last_index =
+		sv::data::EnvelopeTile::index_for_time(level, x_max + offset);
+
+	// The neighbouring sample on the left side
+	add_decimated_pos(pos);
+
+	// Start of the range, that isn't covered by a tile yet
+	double x = x_min;
+	for (int64_t index=first_index; index<=last_index; ++index) {
+		auto tile = tile_cache->tile(signal_, level, index);
+		if (!tile)
+			continue;
+
+		const double tile_start = tile->start() - offset;
+		if (tile_start > x) {
+			size_t range_pos = signal_->find_sample_pos(x, relative_time_);
+			size_t range_end_pos =
+				signal_->find_sample_pos(tile_start, relative_time_);
+			add_decimation_columns(range_pos, range_end_pos, x, column_width,
+				(int)std::ceil((tile_start - x) / column_width));
+		}
+		tile->append_positions(
+			std::max(tile_start, x_min) + offset,
+			std::min(tile->end() - offset, x_max) + offset, decimated_pos_);
+		x = tile->end() - offset;
+	}
+	if (x < x_max) {
+		size_t range_pos = signal_->find_sample_pos(x, relative_time_);
+		add_decimation_columns(range_pos, end_pos, x, column_width,
+			(int)std::ceil((x_max - x) / column_width));
+	}
+
+	// The neighbouring sample on the right side
+	add_decimated_pos(end_pos - 1);
+}
+
+void TimeCurveData::end_decimation()
+{
+	is_decimated_ = false;
+}
+
+const vector<size_t> &TimeCurveData::decimated_pos() const
+{
+	return decimated_pos_;
+}
+
+double TimeCurveData::x_offset() const
+{
+	if (relative_time_)
+		return signal_->signal_start_timestamp();
+	return 0.;
+}
+
+void TimeCurveData::add_decimation_columns(size_t pos, size_t end_pos,
+	double x_from, double column_width, int columns)
+{
+	size_t column_pos = pos;
+	for (int column=1; column<=columns && column_pos<end_pos; ++column) {
+		size_t column_end_pos = signal_->find_sample_pos(
+			x_from + column * column_width, relative_time_);
+		column_end_pos = std::min(std::max(column_end_pos, column_pos), end_pos);
+		if (column_end_pos == column_pos)
+			continue;
+		add_decimation_column(column_pos, column_end_pos);
+		column_pos = column_end_pos;
+	}
+	if (column_pos < end_pos)
+		add_decimation_column(column_pos, end_pos);
+}
+
+void TimeCurveData::add_decimation_column(size_t pos, size_t end_pos)
+{
+	if (end_pos - pos <= DecimationColumnSamples) {
+		for (size_t i=pos; i<end_pos; ++i)
+			add_decimated_pos(i);
+		return;
+	}
+
+	size_t min_pos;
+	size_t max_pos;
+	min_max_index_.find(pos, end_pos, min_pos, max_pos);
+
+	// Keep the samples in chronological order
+	const size_t column_pos[] = {
+		pos,
+		std::min(min_pos, max_pos),
+		std::max(min_pos, max_pos),
+		end_pos - 1 };
+	for (size_t i=0; i<4; ++i)
+		add_decimated_pos(column_pos[i]);
+}
+
+void TimeCurveData::add_decimated_pos(size_t pos)
+{
+	if (decimated_pos_.empty() || pos > decimated_pos_.back())
+		decimated_pos_.push_back(pos);
+}
+
+void TimeCurveData::on_samples_cleared()
+{
+	min_max_index_.clear();
+}
+
 void TimeCurveData::save_settings(QSettings &settings,
 	shared_ptr<sv::devices::BaseDevice> origin_device) const
 {
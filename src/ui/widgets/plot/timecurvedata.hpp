@@ -23,6 +23,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <QPointF>
 #include <QRectF>
@@ -30,11 +31,13 @@
 #include <QString>
 
 #include "src/data/datautil.hpp"
+#include "src/data/minmaxindex.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
 
 using std::set;
 using std::shared_ptr;
 using std::string;
+using std::vector;
 
 namespace sv {
 
@@ -51,6 +54,8 @@ namespace ui {
 namespace widgets {
 namespace plot {
 
+class TileCache;
+
 class TimeCurveData : public BaseCurveData
 {
 	Q_OBJECT
@@ -80,6 +85,48 @@ public:
 
 	shared_ptr<sv::data::AnalogTimeSignal> signal() const;
 
+	/**
+	 * Return the positions of the samples in the x interval
+	 * [`x_min`, `x_max`], including one neighbouring sample on each side, as
+	 * range from `pos` up to (but not including) `end_pos`.
+	 */
+	void visible_range(double x_min, double x_max,
+		size_t &pos, size_t &end_pos) const;
+
+	/**
+	 * Reduce the samples in the x interval [`x_min`, `x_max`] to at most
+	 * four samples (first, min, max, last) per pixel column, plus the
+	 * neighbouring samples outside of the interval. Spikes are preserved, so
+	 * the reduced curve looks the same as the full curve.
+	 *
+	 * Until end_decimation() is called, sample() and size() only return the
+	 * reduced samples. This is used for full replots, where Qwt would
+	 * otherwise iterate over all samples of the signal.
+	 */
+	void begin_decimation(double x_min, double x_max, int columns);
+	/**
+	 * Like begin_decimation(), but the reduced samples are taken from the
+	 * envelope tiles of `tile_cache` with a bucket width of at most one
+	 * column, where they are cached. Only the ranges without cached tiles
+	 * (e.g. the growing end of the signal) are reduced from the samples.
+	 * The curve may look slightly coarser than with begin_decimation(),
+	 * because the buckets aren't aligned to the pixel columns.
+	 */
+	void begin_tiled_decimation(double x_min, double x_max, int columns,
+		TileCache *tile_cache);
+	void end_decimation();
+	/**
+	 * Return the positions of the samples of the reduced curve, while the
+	 * decimation is active.
+	 */
+	const vector<size_t> &decimated_pos() const;
+
+	/**
+	 * Return the offset, that must be subtracted from the timestamps of the
+	 * signal to get the x values of the curve.
+	 */
+	double x_offset() const;
+
 	void save_settings(QSettings &settings,
 		shared_ptr<sv::devices::BaseDevice> origin_device) const override;
 	static TimeCurveData *init_from_settings(
@@ -87,7 +134,31 @@ public:
 		shared_ptr<sv::devices::BaseDevice> origin_device);
 
 private:
+	/**
+	 * Reduce the samples from `pos` up to (but not including) `end_pos` in
+	 * `columns` columns, starting at `x_from`.
+	 */
+	void add_decimation_columns(size_t pos, size_t end_pos,
+		double x_from, double column_width, int columns);
+	void add_decimation_column(size_t pos, size_t end_pos);
+	/** Add a position, if it follows the last decimated position. */
+	void add_decimated_pos(size_t pos);
+
 	shared_ptr<sv::data::AnalogTimeSignal> signal_;
+	/** The values for the index are copied block wise from the signal. */
+	sv::data::MinMaxIndex min_max_index_;
+	vector<double> index_timestamps_;
+	bool is_decimated_;
+	/** Positions of the samples of the reduced curve. */
+	vector<size_t> decimated_pos_;
+
+	/**
+	 * Columns with no more samples than this are not reduced.
+	 */
+	static const size_t DecimationColumnSamples;
+
+private Q_SLOTS:
+	void on_samples_cleared();
 
 };
 
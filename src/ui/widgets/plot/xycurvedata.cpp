@@ -17,32 +17,33 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <vector>
 
-#include <QtMath>
 #include <QPointF>
 #include <QRectF>
 #include <QSettings>
 #include <QString>
-#include <qwt_math.h>
 
 #include "xycurvedata.hpp"
 #include "src/session.hpp"
 #include "src/settingsmanager.hpp"
 #include "src/data/analogtimesignal.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/kdtree.hpp"
 #include "src/devices/basedevice.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
 
 using std::dynamic_pointer_cast;
 using std::lock_guard;
-using std::make_shared;
 using std::mutex;
 using std::set;
 using std::shared_ptr;
+using std::unique_lock;
 
 namespace sv {
 namespace ui {
@@ -55,18 +56,39 @@ XYCurveData::XYCurveData(shared_ptr<sv::data::AnalogTimeSignal> x_t_signal,
 	x_t_signal_(x_t_signal),
 	y_t_signal_(y_t_signal),
 	x_t_signal_pos_(0),
-	y_t_signal_pos_(0)
+	y_t_signal_pos_(0),
+	x_min_(std::numeric_limits<double>::max()),
+	x_max_(std::numeric_limits<double>::lowest()),
+	y_min_(std::numeric_limits<double>::max()),
+	y_max_(std::numeric_limits<double>::lowest()),
+	published_size_(0),
+	combine_abort_(false),
+	// Samples could be appended before the signals are connected.
+	has_new_samples_(true)
 {
-	x_data_ = make_shared<vector<double>>();
-	y_data_ = make_shared<vector<double>>();
-
-	// Prefill data vectors
-	this->on_sample_appended();
+	// Prefill data, so the plot can init the axes
+	this->combine_new_samples();
 
+	// The signals are emitted in the acquisition thread, only wake up the
+	// combine thread there.
 	connect(x_t_signal_.get(), &sv::data::AnalogTimeSignal::sample_appended,
-		this, &XYCurveData::on_sample_appended);
+		this, [this]() { this->notify_combine(); }, Qt::DirectConnection);
 	connect(y_t_signal_.get(), &sv::data::AnalogTimeSignal::sample_appended,
-		this, &XYCurveData::on_sample_appended);
+		this, [this]() { this->notify_combine(); }, Qt::DirectConnection);
+
+	combine_thread_ = std::thread(&XYCurveData::combine_thread_proc, this);
+}
+
+XYCurveData::~XYCurveData()
+{
+	disconnect(x_t_signal_.get(), nullptr, this, nullptr);
+	disconnect(y_t_signal_.get(), nullptr, this, nullptr);
+	{
+		lock_guard<mutex> lock(combine_mutex_);
+		combine_abort_ = true;
+	}
+	combine_cond_.notify_one();
+	combine_thread_.join();
 }
 
 bool XYCurveData::is_equal(const BaseCurveData *other) const
@@ -81,44 +103,45 @@ bool XYCurveData::is_equal(const BaseCurveData *other) const
 
 QPointF XYCurveData::sample(size_t index) const
 {
-	QPointF sample_point(x_data_->at(index), y_data_->at(index));
-	return sample_point;
+	return QPointF(x_data_.at(index), y_data_.at(index));
 }
 
 size_t XYCurveData::size() const
 {
-	return x_data_->size();
+	return published_size_.load(std::memory_order_acquire);
 }
 
 QRectF XYCurveData::boundingRect() const
 {
-	// top left, bottom right
-	return QRectF(
-		QPointF(x_t_signal_->min_value(), y_t_signal_->max_value()),
-		QPointF(x_t_signal_->max_value(), y_t_signal_->min_value()));
+	if (size() == 0) {
+		// top left, bottom right
+		return QRectF(
+			QPointF(x_t_signal_->min_value(), y_t_signal_->max_value()),
+			QPointF(x_t_signal_->max_value(), y_t_signal_->min_value()));
+	}
+
+	lock_guard<mutex> lock(publish_mutex_);
+	return published_rect_;
 }
 
 QPointF XYCurveData::closest_point(const QPointF &pos, double *dist) const
 {
+	// No point found
+	if (dist)
+		*dist = std::numeric_limits<double>::infinity();
+
 	const size_t num_samples = size();
 	if (num_samples == 0)
-		return QPointF(0, 0); // TODO
-
-	size_t index = -1;
-	double d_min = 1.0e10;
-
-	for (size_t i=0; i < num_samples; i++) {
-		const QPointF sample_point = sample(i);
-		const double d_x = sample_point.x() - pos.x();
-		const double d_y = sample_point.y() - pos.y();
-		const double d_actual = qwtSqr(d_x) + qwtSqr(d_y);
-		if (d_actual < d_min) {
-			index = i;
-			d_min = d_actual;
-		}
-	}
+		return QPointF(0, 0);
+
+	for (size_t i=kd_tree_.size(); i<num_samples; ++i)
+		kd_tree_.append(x_data_.at(i), y_data_.at(i));
+	size_t index;
+	double d_min;
+	if (!kd_tree_.find_closest(pos.x(), pos.y(), index, d_min))
+		return QPointF(0, 0);
 	if (dist)
-		*dist = qSqrt(d_min);
+		*dist = d_min;
 
 	return sample(index);
 }
@@ -222,15 +245,85 @@ XYCurveData *XYCurveData::init_from_settings(
 		dynamic_pointer_cast<sv::data::AnalogTimeSignal>(y_t_data_signal));
 }
 
-void XYCurveData::on_sample_appended()
+void XYCurveData::notify_combine()
+{
+	{
+		lock_guard<mutex> lock(combine_mutex_);
+		has_new_samples_ = true;
+	}
+	combine_cond_.notify_one();
+}
+
+void XYCurveData::combine_thread_proc()
+{
+	while (true) {
+		{
+			unique_lock<mutex> lock(combine_mutex_);
+			combine_cond_.wait(lock,
+				[this] { return combine_abort_ || has_new_samples_; });
+			if (combine_abort_)
+				return;
+			has_new_samples_ = false;
+		}
+
+		combine_new_samples();
+	}
+}
+
+void XYCurveData::combine_new_samples()
 {
-	lock_guard<mutex> lock(sample_append_mutex_);
+	read_new_samples(x_t_signal_, x_t_signal_pos_,
+		read_timestamps_, read_values_);
+	aligner_.add_first(read_timestamps_, read_values_);
+	read_new_samples(y_t_signal_, y_t_signal_pos_,
+		read_timestamps_, read_values_);
+	aligner_.add_second(read_timestamps_, read_values_);
+
+	combined_timestamps_.clear();
+	combined_x_values_.clear();
+	combined_y_values_.clear();
+	aligner_.combine(combined_timestamps_,
+		combined_x_values_, combined_y_values_);
+	for (size_t i=0; i<combined_x_values_.size(); ++i)
+		append_point(combined_x_values_[i], combined_y_values_[i]);
+
+	if (x_data_.size() == published_size_.load(std::memory_order_relaxed))
+		return;
+
+	{
+		lock_guard<mutex> lock(publish_mutex_);
+		// top left, bottom right
+		published_rect_ = QRectF(QPointF(x_min_, y_max_), QPointF(x_max_, y_min_));
+	}
+	published_size_.store(x_data_.size(), std::memory_order_release);
+}
 
-	shared_ptr<vector<double>> time = make_shared<vector<double>>();
-	sv::data::AnalogTimeSignal::combine_signals(
-		x_t_signal_, x_t_signal_pos_,
-		y_t_signal_, y_t_signal_pos_,
-		time, x_data_, y_data_);
+void XYCurveData::read_new_samples(
+	shared_ptr<sv::data::AnalogTimeSignal> signal, size_t &signal_pos,
+	vector<double> &timestamps, vector<double> &values)
+{
+	// get_samples() limits the end position to the current sample count.
+	signal_pos += signal->get_samples(signal_pos,
+		std::numeric_limits<size_t>::max(), timestamps, values, false);
+}
+
+void XYCurveData::append_point(double x, double y)
+{
+	// The x and y buffers always have the same size.
+	if (x_data_.size() == sv::data::ChunkedBuffer::ChunkSize *
+			sv::data::ChunkedBuffer::MaxChunks)
+		return;
+
+	x_data_.push_back(x);
+	y_data_.push_back(y);
+	if (x < x_min_)
+		x_min_ = x;
+	if (x > x_max_)
+		x_max_ = x;
+	if (y < y_min_)
+		y_min_ = y;
+	if (y > y_max_)
+		y_max_ = y;
 }
 
 } // namespace plot
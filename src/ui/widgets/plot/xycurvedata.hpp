@@ -20,10 +20,13 @@
 #ifndef UI_WIDGETS_PLOT_XYCURVEDATA_HPP
 #define UI_WIDGETS_PLOT_XYCURVEDATA_HPP
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <QPointF>
@@ -31,9 +34,14 @@
 #include <QSettings>
 #include <QString>
 
+#include "src/data/chunkedbuffer.hpp"
 #include "src/data/datautil.hpp"
+#include "src/data/kdtree.hpp"
+#include "src/data/timealigner.hpp"
 #include "src/ui/widgets/plot/basecurvedata.hpp"
 
+using std::atomic;
+using std::condition_variable;
 using std::mutex;
 using std::set;
 using std::shared_ptr;
@@ -58,6 +66,11 @@ namespace plot {
 /*
  * NOTE: XYCurveData must also inherit QObject (Important: first QObject,
  *       then BaseCurvedata), to get signals/slots working!
+ *
+ * The x/y pairs are combined from the two time signals in a worker thread
+ * and appended to chunked buffers, so the GUI thread never waits for the
+ * combining. size() and boundingRect() only return the published state of
+ * the worker, all points below size() are immutable.
  */
 class XYCurveData : public BaseCurveData
 {
@@ -66,6 +79,7 @@ class XYCurveData : public BaseCurveData
 public:
 	XYCurveData(shared_ptr<sv::data::AnalogTimeSignal> x_t_signal,
 		shared_ptr<sv::data::AnalogTimeSignal> y_t_signal);
+	~XYCurveData();
 
 	bool is_equal(const BaseCurveData *other) const override;
 
@@ -97,17 +111,48 @@ public:
 		shared_ptr<sv::devices::BaseDevice> origin_device);
 
 private:
+	/** Wake up the combine thread. Called from the acquisition thread. */
+	void notify_combine();
+	void combine_thread_proc();
+	/** Combine the new samples of both signals and publish the result. */
+	void combine_new_samples();
+	static void read_new_samples(
+		shared_ptr<sv::data::AnalogTimeSignal> signal, size_t &signal_pos,
+		vector<double> &timestamps, vector<double> &values);
+	void append_point(double x, double y);
+
 	shared_ptr<sv::data::AnalogTimeSignal> x_t_signal_;
 	shared_ptr<sv::data::AnalogTimeSignal> y_t_signal_;
+
+	/** State of the combine thread. */
 	size_t x_t_signal_pos_;
 	size_t y_t_signal_pos_;
-	// TODO: use some sort of AnalogSignal instead of 2 vectors?
-	shared_ptr<vector<double>> x_data_;
-	shared_ptr<vector<double>> y_data_;
-	mutex sample_append_mutex_;
-
-private Q_SLOTS:
-	void on_sample_appended();
+	vector<double> read_timestamps_;
+	vector<double> read_values_;
+	sv::data::TimeAligner aligner_;
+	vector<double> combined_timestamps_;
+	vector<double> combined_x_values_;
+	vector<double> combined_y_values_;
+	sv::data::ChunkedBuffer x_data_;
+	sv::data::ChunkedBuffer y_data_;
+	double x_min_;
+	double x_max_;
+	double y_min_;
+	double y_max_;
+
+	/** Published by the combine thread for the GUI thread. */
+	atomic<size_t> published_size_;
+	QRectF published_rect_;
+	mutable mutex publish_mutex_;
+
+	std::thread combine_thread_;
+	mutex combine_mutex_;
+	condition_variable combine_cond_;
+	bool combine_abort_;
+	bool has_new_samples_;
+
+	/** Spatial index for closest_point(), updated with the next query. */
+	mutable sv::data::KdTree kd_tree_;
 
 };
 
@@ -20,6 +20,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
 #include <limits>
 #include <math.h>
 #include <sstream>
@@ -177,9 +180,7 @@ void format_value_si(
 	si_prefix_stream << si_prefix;
 }
 
-void format_value_si_autoscale(
-	const double value, const int total_digits, const int decimal_places,
-	QString &value_str, QString &si_prefix_str, const bool use_locale)
+static SIPrefix autoscale_si_prefix(const double value)
 {
 	SIPrefix si_prefix;
 	if (value == 0 || value == NAN ||
@@ -200,6 +201,15 @@ void format_value_si_autoscale(
 	assert(si_prefix >= SIPrefix::yocto);
 	assert(si_prefix <= SIPrefix::yotta);
 
+	return si_prefix;
+}
+
+void format_value_si_autoscale(
+	const double value, const int total_digits, const int decimal_places,
+	QString &value_str, QString &si_prefix_str, const bool use_locale)
+{
+	SIPrefix si_prefix = autoscale_si_prefix(value);
+
 	const double multiplier = pow(10, -exponent(si_prefix));
 
 	// Check if, use current locale (%L) for formating.
@@ -211,6 +221,66 @@ void format_value_si_autoscale(
 	si_prefix_stream << si_prefix;
 }
 
+SIPrefix format_value_si(
+	const double value, const int total_digits, const int sr_digits,
+	const char decimal_point, char *buffer, const size_t size)
+{
+	int prefix = prefix_from_value(value, sr_digits);
+	SIPrefix si_prefix = si_prefix_from_prefix(prefix);
+	assert(si_prefix >= SIPrefix::yocto);
+	assert(si_prefix <= SIPrefix::yotta);
+
+	format_value_fixed(value * pow(10, -3 * prefix), total_digits,
+		decimal_places_from_prefix(prefix, sr_digits), decimal_point,
+		buffer, size);
+
+	return si_prefix;
+}
+
+SIPrefix format_value_si_autoscale(
+	const double value, const int total_digits, const int decimal_places,
+	const char decimal_point, char *buffer, const size_t size)
+{
+	SIPrefix si_prefix = autoscale_si_prefix(value);
+
+	format_value_fixed(value * pow(10, -exponent(si_prefix)), total_digits,
+		decimal_places, decimal_point, buffer, size);
+
+	return si_prefix;
+}
+
+void format_value_fixed(
+	const double value, const int total_digits, const int decimal_places,
+	const char decimal_point, char *buffer, const size_t size)
+{
+	assert(size > 0);
+
+	// The field width has the same meaning as for QString::arg(), a negative
+	// width aligns the value to the left.
+	int length = snprintf(buffer, size, "%*.*f",
+		total_digits, decimal_places, value);
+	if (length < 0) {
+		buffer[0] = '\0';
+		return;
+	}
+
+	// snprintf() uses the decimal point of the C locale.
+	if (decimal_places > 0) {
+		char *point = strchr(buffer, *localeconv()->decimal_point);
+		if (point)
+			*point = decimal_point;
+	}
+}
+
+QString format_si_prefix(SIPrefix prefix)
+{
+	QString str;
+	QTextStream stream(&str);
+	stream << prefix;
+	stream.flush();
+	return str;
+}
+
 QString format_time_si(const Timestamp &timestamp, SIPrefix prefix,
 	unsigned int precision, const QString &unit, bool sign)
 {
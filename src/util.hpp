@@ -117,6 +117,43 @@ void format_value_si_autoscale(
 	const double value, const int total_digits, const int decimal_places,
 	QString &value_str, QString &si_prefix_str, const bool use_locale = true);
 
+/**
+ * Same as `format_value_si()`, but the digits are written to the fixed size
+ * `buffer`, so no memory is allocated. This is used for values that are
+ * updated very often.
+ *
+ * @param decimal_point The character for the decimal point. No group
+ *                      separators are inserted.
+ * @param buffer The buffer for the digits, the string is always terminated.
+ * @param size The size of `buffer`.
+ *
+ * @return The SI prefix of the value.
+ */
+SIPrefix format_value_si(
+	const double value, const int total_digits, const int sr_digits,
+	const char decimal_point, char *buffer, const size_t size);
+
+/**
+ * Same as `format_value_si_autoscale()`, but writes to a fixed size buffer.
+ * See `format_value_si()` above.
+ */
+SIPrefix format_value_si_autoscale(
+	const double value, const int total_digits, const int decimal_places,
+	const char decimal_point, char *buffer, const size_t size);
+
+/**
+ * Format the value with a fixed number of decimal places to a fixed size
+ * buffer. See `format_value_si()` above.
+ */
+void format_value_fixed(
+	const double value, const int total_digits, const int decimal_places,
+	const char decimal_point, char *buffer, const size_t size);
+
+/**
+ * Returns the symbol of the SI prefix, e.g. "m" for milli.
+ */
+QString format_si_prefix(SIPrefix prefix);
+
 /**
  * Formats a given timestamp with the specified SI prefix.
  *
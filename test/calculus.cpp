@@ -0,0 +1,146 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/calculus.hpp"
+
+using std::vector;
+using sv::data::central_derivative;
+using sv::data::simpson_area;
+using sv::data::trapezoid_area;
+
+namespace {
+
+double quadratic(double t)
+{
+	return 3. * t * t - 2. * t + 1.;
+}
+
+double quadratic_integral(double t)
+{
+	return t * t * t - t * t + t;
+}
+
+double quadratic_derivative(double t)
+{
+	return 6. * t - 2.;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(CalculusTest)
+
+BOOST_AUTO_TEST_CASE(trapezoid_linear_test)
+{
+	// The trapezoidal rule is exact for linear functions
+	const vector<double> t { 0., 0.5, 1.25, 2., 3.5 };
+	double sum = 0.;
+	for (size_t i=1; i<t.size(); ++i)
+		sum += trapezoid_area(t[i-1], 2. * t[i-1] + 1., t[i], 2. * t[i] + 1.);
+	BOOST_CHECK_CLOSE(sum, 3.5 * 3.5 + 3.5, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(trapezoid_sine_test)
+{
+	// Integral of sin(t) from 0 to pi is 2, the error is O(h^2)
+	const size_t n = 1000;
+	const double h = M_PI / (double)n;
+	double sum = 0.;
+	for (size_t i=0; i<n; ++i) {
+		double t0 = h * (double)i;
+		double t1 = h * (double)(i + 1);
+		sum += trapezoid_area(t0, std::sin(t0), t1, std::sin(t1));
+	}
+	BOOST_CHECK_CLOSE(sum, 2., 1e-4);
+	BOOST_CHECK_LT(sum, 2.);
+}
+
+BOOST_AUTO_TEST_CASE(simpson_quadratic_test)
+{
+	// Simpson's rule is exact for quadratics, also for non-uniform spacing
+	const vector<double> t { -1., -0.2, 0.5, 0.75, 2., 4. };
+	for (size_t i=2; i<t.size(); ++i) {
+		double area = simpson_area(
+			t[i-2], quadratic(t[i-2]),
+			t[i-1], quadratic(t[i-1]),
+			t[i], quadratic(t[i]));
+		double expected =
+			quadratic_integral(t[i]) - quadratic_integral(t[i-2]);
+		BOOST_CHECK_CLOSE(area, expected, 1e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(simpson_cubic_test)
+{
+	// With uniform spacing Simpson's rule is exact for cubics
+	double area = simpson_area(1., 1., 2., 8., 3., 27.);
+	BOOST_CHECK_CLOSE(area, (81. - 1.) / 4., 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(simpson_sine_test)
+{
+	// Integral of sin(t) from 0 to pi is 2, the error is O(h^4)
+	const size_t n = 100;
+	const double h = M_PI / (double)n;
+	double sum = 0.;
+	for (size_t i=0; i+2<=n; i+=2) {
+		double t0 = h * (double)i;
+		double t1 = h * (double)(i + 1);
+		double t2 = h * (double)(i + 2);
+		sum += simpson_area(t0, std::sin(t0), t1, std::sin(t1),
+			t2, std::sin(t2));
+	}
+	BOOST_CHECK_CLOSE(sum, 2., 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(simpson_degenerate_spacing_test)
+{
+	// Two samples with the same timestamp fall back to trapezoids
+	double area = simpson_area(0., 1., 1., 3., 1., 5.);
+	BOOST_CHECK_CLOSE(area, 2., 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(derivative_quadratic_test)
+{
+	// The three-point difference is exact for quadratics
+	const vector<double> t { -1., -0.2, 0.5, 0.75, 2., 4. };
+	for (size_t i=2; i<t.size(); ++i) {
+		double derivative = central_derivative(
+			t[i-2], quadratic(t[i-2]),
+			t[i-1], quadratic(t[i-1]),
+			t[i], quadratic(t[i]));
+		BOOST_CHECK_CLOSE(derivative, quadratic_derivative(t[i-1]), 1e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(derivative_sine_test)
+{
+	const double h = 1e-3;
+	for (double t : { 0.1, 1., 2.5 }) {
+		double derivative = central_derivative(
+			t - h, std::sin(t - h), t, std::sin(t), t + 2. * h,
+			std::sin(t + 2. * h));
+		BOOST_CHECK_SMALL(derivative - std::cos(t), 1e-5);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/compensatedsum.hpp"
+
+using std::vector;
+using sv::data::CompensatedSum;
+
+BOOST_AUTO_TEST_SUITE(CompensatedSumTest)
+
+BOOST_AUTO_TEST_CASE(cancellation_test)
+{
+	// A naive sum loses both small summands
+	const vector<double> values { 1., 1e100, 1., -1e100 };
+	double naive_sum = 0.;
+	CompensatedSum sum;
+	for (const auto &value : values) {
+		naive_sum += value;
+		sum.add(value);
+	}
+	BOOST_CHECK_EQUAL(naive_sum, 0.);
+	BOOST_CHECK_EQUAL(sum.value(), 2.);
+}
+
+BOOST_AUTO_TEST_CASE(many_small_values_test)
+{
+	// Small increments on a large sum, like a long running energy counter
+	const size_t n = 1000000;
+	double naive_sum = 1e10;
+	CompensatedSum sum(1e10);
+	for (size_t i=0; i<n; ++i) {
+		naive_sum += 1e-7;
+		sum.add(1e-7);
+	}
+	const double expected = 1e10 + 0.1;
+	BOOST_CHECK_GT(std::fabs(naive_sum - expected), 1e-4);
+	BOOST_CHECK_SMALL(sum.value() - expected, 1e-5);
+}
+
+BOOST_AUTO_TEST_CASE(reset_test)
+{
+	CompensatedSum sum;
+	sum.add(1e100);
+	sum.add(1.);
+	sum.reset(5.);
+	BOOST_CHECK_EQUAL(sum.value(), 5.);
+	sum.add(0.5);
+	BOOST_CHECK_EQUAL(sum.value(), 5.5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
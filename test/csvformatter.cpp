@@ -0,0 +1,79 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <clocale>
+#include <ctime>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/csvformatter.hpp"
+
+using std::string;
+using sv::data::CsvFormatter;
+
+namespace {
+
+string str(const CsvFormatter &formatter)
+{
+	return string(formatter.data(), formatter.size());
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(CsvFormatterTest)
+
+BOOST_AUTO_TEST_CASE(number_test)
+{
+	CsvFormatter formatter;
+	formatter.append_fixed(12.34567, 4);
+	formatter.append(',');
+	formatter.append_double(12.34567);
+	formatter.append(",");
+	formatter.append_double(1e-5);
+	formatter.append(string(";"));
+	formatter.append_fixed(-0.5, 0);
+	formatter.end_line();
+	BOOST_CHECK_EQUAL(str(formatter), "12.3457,12.3457,1e-05;-0\n");
+
+	formatter.clear();
+	BOOST_CHECK_EQUAL(formatter.size(), 0);
+	formatter.append_fixed(1e300, 2);
+	BOOST_CHECK_EQUAL(formatter.size(), 304);
+
+	formatter.clear();
+	formatter.append_double(0.1, 17);
+	BOOST_CHECK_EQUAL(str(formatter), "0.10000000000000001");
+}
+
+BOOST_AUTO_TEST_CASE(date_time_test)
+{
+	const time_t secs = 1600000000;
+	char date_time[32];
+	strftime(date_time, sizeof(date_time), "%Y.%m.%d %H:%M:%S",
+		localtime(&secs));
+
+	CsvFormatter formatter;
+	formatter.append_date_time(1600000000.0125);
+	formatter.end_line();
+	formatter.append_date_time(1600000000.999);
+	BOOST_CHECK_EQUAL(str(formatter), string(date_time) + ".012\n" +
+		string(date_time) + ".999");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/densitybuffer.hpp"
+
+using sv::data::DensityBuffer;
+
+namespace {
+
+uint32_t total_count(const DensityBuffer &buffer)
+{
+	uint32_t total = 0;
+	for (size_t i=0; i<buffer.width()*buffer.height(); ++i)
+		total += buffer.data()[i];
+	return total;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(DensityBufferTest)
+
+BOOST_AUTO_TEST_CASE(polyline_test)
+{
+	DensityBuffer buffer;
+	buffer.resize(10, 5);
+
+	// Every pixel of a polyline is hit once
+	buffer.add_point(0, 0);
+	buffer.add_line(0, 0, 4, 0);
+	buffer.add_line(4, 0, 4, 4);
+	buffer.add_line(4, 4, 9, 4);
+	BOOST_CHECK_EQUAL(total_count(buffer), 5 + 4 + 5);
+	BOOST_CHECK_EQUAL(buffer.max_count(), 1);
+	BOOST_CHECK_EQUAL(buffer.count(4, 0), 1);
+	BOOST_CHECK_EQUAL(buffer.count(9, 4), 1);
+
+	// A second sweep over the same line
+	buffer.add_point(0, 0);
+	buffer.add_line(0, 0, 4, 0);
+	BOOST_CHECK_EQUAL(buffer.count(2, 0), 2);
+	BOOST_CHECK_EQUAL(buffer.max_count(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(clipping_test)
+{
+	DensityBuffer buffer;
+	buffer.resize(10, 5);
+
+	// Start and end outside, both edge pixels are hit
+	buffer.add_line(-100, 2, 100, 2);
+	BOOST_CHECK_EQUAL(total_count(buffer), 10);
+	BOOST_CHECK_EQUAL(buffer.count(0, 2), 1);
+	BOOST_CHECK_EQUAL(buffer.count(9, 2), 1);
+
+	// Completely outside
+	buffer.add_line(-5, -5, 20, -1);
+	buffer.add_line(1e300, 0, 1e300, 4);
+	buffer.add_point(10, 0);
+	BOOST_CHECK_EQUAL(total_count(buffer), 10);
+}
+
+BOOST_AUTO_TEST_CASE(decay_test)
+{
+	DensityBuffer buffer;
+	buffer.resize(2, 1);
+	for (size_t i=0; i<100; ++i)
+		buffer.add_point(0, 0);
+	buffer.add_point(1, 0);
+
+	buffer.decay(DensityBuffer::DecayOne / 2);
+	BOOST_CHECK_EQUAL(buffer.count(0, 0), 50);
+	BOOST_CHECK_EQUAL(buffer.count(1, 0), 0);
+
+	buffer.decay(DensityBuffer::DecayOne);
+	BOOST_CHECK_EQUAL(buffer.count(0, 0), 50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/energyaccumulator.hpp"
+
+using sv::data::EnergyAccumulator;
+
+BOOST_AUTO_TEST_SUITE(EnergyAccumulatorTest)
+
+BOOST_AUTO_TEST_CASE(constant_load_test)
+{
+	// 5 V, 2 A for one hour, sampled every 10 ms
+	EnergyAccumulator acc;
+	for (size_t i=0; i<=360000; ++i)
+		acc.add(1000. + (double)i * .01, 5., 2.);
+
+	BOOST_CHECK_CLOSE(acc.amp_hours(), 2., 1e-9);
+	BOOST_CHECK_CLOSE(acc.watt_hours(), 10., 1e-9);
+	BOOST_CHECK_EQUAL(acc.voltage().count(), 360001);
+	BOOST_CHECK_CLOSE(acc.resistance().min(), 2.5, 1e-12);
+	BOOST_CHECK_CLOSE(acc.power().max(), 10., 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(trapezoid_test)
+{
+	// Current ramps linear from 0 A to 3.6 A in 3600 s at 1 V
+	EnergyAccumulator acc;
+	acc.add(0., 1., 0.);
+	acc.add(1800., 1., 1.8);
+	acc.add(3600., 1., 3.6);
+
+	BOOST_CHECK_CLOSE(acc.amp_hours(), 1.8, 1e-12);
+	BOOST_CHECK_CLOSE(acc.watt_hours(), 1.8, 1e-12);
+	BOOST_CHECK_EQUAL(acc.current().min(), 0.);
+	BOOST_CHECK_EQUAL(acc.current().max(), 3.6);
+	// The resistance of the first sample is infinite and ignored
+	BOOST_CHECK_EQUAL(acc.resistance().count(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_sample_test)
+{
+	EnergyAccumulator acc;
+	acc.add(0., 1., 1.);
+	acc.add(1800., 1., 1.);
+	acc.add(2000., std::numeric_limits<double>::quiet_NaN(), 1.);
+	// The interval around the invalid sample is not integrated
+	acc.add(3000., 1., 1.);
+	acc.add(4800., 1., 1.);
+
+	BOOST_CHECK_CLOSE(acc.amp_hours(), 1., 1e-12);
+	BOOST_CHECK_EQUAL(acc.voltage().count(), 4);
+
+	acc.reset();
+	BOOST_CHECK_EQUAL(acc.amp_hours(), 0.);
+	BOOST_CHECK_EQUAL(acc.voltage().count(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/envelopetile.hpp"
+
+using std::vector;
+using sv::data::EnvelopeTile;
+
+BOOST_AUTO_TEST_SUITE(EnvelopeTileTest)
+
+BOOST_AUTO_TEST_CASE(level_for_width_test)
+{
+	BOOST_CHECK_EQUAL(EnvelopeTile::level_for_width(1.), 0);
+	BOOST_CHECK_EQUAL(EnvelopeTile::level_for_width(1.5), 0);
+	BOOST_CHECK_EQUAL(EnvelopeTile::level_for_width(2.), 1);
+	BOOST_CHECK_EQUAL(EnvelopeTile::level_for_width(0.001), -10);
+	BOOST_CHECK_EQUAL(EnvelopeTile::level_for_width(0.),
+		EnvelopeTile::MinLevel);
+	BOOST_CHECK_EQUAL(EnvelopeTile::level_for_width(1e30),
+		EnvelopeTile::MaxLevel);
+
+	BOOST_CHECK_EQUAL(EnvelopeTile::index_for_time(0, -0.5), -1);
+	BOOST_CHECK_EQUAL(EnvelopeTile::index_for_time(0, 256.), 1);
+}
+
+BOOST_AUTO_TEST_CASE(bucket_test)
+{
+	// 4 samples per bucket of level -2
+	EnvelopeTile tile(-2, 1);
+	vector<double> timestamps;
+	vector<double> values;
+	for (size_t i=0; i<1600; ++i) {
+		timestamps.push_back(32. + (double)i / 16.);
+		values.push_back(std::sin(0.1 * (double)i));
+	}
+	tile.add_samples(0, timestamps.data(), values.data(), timestamps.size());
+
+	BOOST_CHECK_EQUAL(tile.start(), 64.);
+	BOOST_CHECK_EQUAL(tile.end(), 128.);
+	for (size_t b=0; b<EnvelopeTile::BucketCount; ++b) {
+		BOOST_REQUIRE(!tile.is_empty(b));
+		const auto &bucket = tile.bucket(b);
+		const size_t pos = 512 + 4 * b;
+		BOOST_CHECK_EQUAL(bucket.first_pos, pos);
+		BOOST_CHECK_EQUAL(bucket.last_pos, pos + 3);
+		double min = values[pos];
+		double max = values[pos];
+		for (size_t i=pos; i<pos+4; ++i) {
+			min = std::min(min, values[i]);
+			max = std::max(max, values[i]);
+		}
+		BOOST_CHECK_EQUAL(values[bucket.min_pos], min);
+		BOOST_CHECK_EQUAL(values[bucket.max_pos], max);
+	}
+
+	vector<size_t> positions;
+	tile.append_positions(0., 1000., positions);
+	BOOST_CHECK(positions.size() <= 4 * EnvelopeTile::BucketCount);
+	BOOST_CHECK_EQUAL(positions.front(), 512u);
+	BOOST_CHECK_EQUAL(positions.back(), 512u + 1023u);
+	for (size_t i=1; i<positions.size(); ++i)
+		BOOST_CHECK(positions[i] > positions[i-1]);
+}
+
+BOOST_AUTO_TEST_CASE(merge_test)
+{
+	vector<double> timestamps;
+	vector<double> values;
+	for (size_t i=0; i<5000; ++i) {
+		timestamps.push_back(0.37 * (double)i);
+		values.push_back(std::fmod(7.3 * (double)i, 11.));
+	}
+	values[1234] = std::numeric_limits<double>::quiet_NaN();
+
+	EnvelopeTile first(0, 2);
+	EnvelopeTile second(0, 3);
+	EnvelopeTile parent(1, 1);
+	first.add_samples(0, timestamps.data(), values.data(), timestamps.size());
+	second.add_samples(0, timestamps.data(), values.data(), timestamps.size());
+	parent.add_samples(0, timestamps.data(), values.data(), timestamps.size());
+
+	EnvelopeTile merged = EnvelopeTile::merge(first, second);
+	BOOST_CHECK_EQUAL(merged.level(), 1);
+	BOOST_CHECK_EQUAL(merged.index(), 1);
+	for (size_t b=0; b<EnvelopeTile::BucketCount; ++b) {
+		BOOST_REQUIRE_EQUAL(merged.is_empty(b), parent.is_empty(b));
+		if (parent.is_empty(b))
+			continue;
+		BOOST_CHECK_EQUAL(merged.bucket(b).first_pos, parent.bucket(b).first_pos);
+		BOOST_CHECK_EQUAL(merged.bucket(b).min_pos, parent.bucket(b).min_pos);
+		BOOST_CHECK_EQUAL(merged.bucket(b).max_pos, parent.bucket(b).max_pos);
+		BOOST_CHECK_EQUAL(merged.bucket(b).last_pos, parent.bucket(b).last_pos);
+		BOOST_CHECK(!std::isnan(merged.bucket(b).min));
+		BOOST_CHECK(!std::isnan(merged.bucket(b).max));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
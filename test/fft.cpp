@@ -0,0 +1,86 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/fft.hpp"
+
+using std::complex;
+using std::vector;
+using sv::data::FFT;
+
+namespace {
+
+vector<complex<double>> naive_dft(const vector<complex<double>> &in)
+{
+	const size_t n = in.size();
+	vector<complex<double>> out(n);
+	for (size_t k=0; k<n; ++k) {
+		complex<double> sum(0., 0.);
+		for (size_t i=0; i<n; ++i) {
+			double phase = -2 * M_PI * (double)((k * i) % n) / (double)n;
+			sum += in[i] * complex<double>(std::cos(phase), std::sin(phase));
+		}
+		out[k] = sum;
+	}
+	return out;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(FFTTest)
+
+BOOST_AUTO_TEST_CASE(compare_naive_dft_test)
+{
+	for (size_t n : { 1, 2, 3, 4, 5, 7, 8, 12, 30, 64, 100, 243, 1024 }) {
+		vector<complex<double>> in(n);
+		for (size_t i=0; i<n; ++i)
+			in[i] = complex<double>(std::sin(0.37 * i) + 0.1 * i, std::cos(1.3 * i));
+
+		vector<complex<double>> out(n);
+		FFT fft(n);
+		fft.transform(in.data(), out.data());
+		auto ref = naive_dft(in);
+
+		for (size_t k=0; k<n; ++k)
+			BOOST_CHECK_SMALL(std::abs(out[k] - ref[k]), 1e-9 * (double)n);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(real_sine_test)
+{
+	const size_t n = 256;
+	vector<double> in(n);
+	for (size_t i=0; i<n; ++i)
+		in[i] = 3. * std::cos(2 * M_PI * 10. * (double)i / (double)n);
+
+	vector<complex<double>> out(n);
+	vector<complex<double>> buffer;
+	FFT fft(n);
+	fft.transform_real(in.data(), out.data(), buffer);
+
+	BOOST_CHECK_CLOSE(2. * std::abs(out[10]) / (double)n, 3., 1e-9);
+	BOOST_CHECK_SMALL(std::abs(out[11]), 1e-9);
+	BOOST_CHECK_SMALL(std::abs(out[0]), 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <numeric>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/histogram.hpp"
+
+using sv::data::Histogram;
+using sv::data::P2QuantileEstimator;
+
+BOOST_AUTO_TEST_SUITE(HistogramTest)
+
+BOOST_AUTO_TEST_CASE(fixed_range_test)
+{
+	Histogram histogram(10, 0., 10.);
+	for (int i=0; i<100; ++i)
+		histogram.add(0.1 * i);
+	histogram.add(-5.);
+	histogram.add(50.);
+
+	BOOST_CHECK_EQUAL(histogram.count(), 102);
+	BOOST_CHECK_EQUAL(histogram.bins().size(), 10);
+	BOOST_CHECK_EQUAL(histogram.bins().front(), 11);
+	BOOST_CHECK_EQUAL(histogram.bins().back(), 11);
+	BOOST_CHECK_EQUAL(histogram.bins()[5], 10);
+}
+
+BOOST_AUTO_TEST_CASE(auto_range_test)
+{
+	Histogram histogram(16);
+	for (int i=0; i<16; ++i)
+		histogram.add(1. + 0.01 * i);
+	BOOST_CHECK_EQUAL(histogram.bins().size(), 16);
+
+	// Force the range to grow in both directions
+	histogram.add(-3.);
+	histogram.add(7.);
+	BOOST_CHECK(histogram.lower_bound() <= -3.);
+	BOOST_CHECK(histogram.lower_bound() +
+		histogram.bin_width() * histogram.bin_count() > 7.);
+
+	double sum = std::accumulate(
+		histogram.bins().begin(), histogram.bins().end(), 0.);
+	BOOST_CHECK_EQUAL(sum, 18.);
+	BOOST_CHECK_EQUAL(histogram.count(), 18);
+}
+
+BOOST_AUTO_TEST_CASE(p2_quantile_test)
+{
+	P2QuantileEstimator p1(0.01);
+	P2QuantileEstimator p50(0.5);
+	P2QuantileEstimator p99(0.99);
+	// Uniformly distributed permutation of 0..9999
+	for (int i=0; i<10000; ++i) {
+		double value = (double)((i * 7919) % 10000);
+		p1.add(value);
+		p50.add(value);
+		p99.add(value);
+	}
+
+	BOOST_CHECK_SMALL(p1.value() - 100., 50.);
+	BOOST_CHECK_SMALL(p50.value() - 5000., 100.);
+	BOOST_CHECK_SMALL(p99.value() - 9900., 50.);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/intervalstatistics.hpp"
+
+using sv::data::IntervalStatistics;
+
+BOOST_AUTO_TEST_SUITE(IntervalStatisticsTest)
+
+BOOST_AUTO_TEST_CASE(add_test)
+{
+	IntervalStatistics stats;
+	stats.add(10.);
+	BOOST_CHECK_EQUAL(stats.count(), 0);
+	BOOST_CHECK_EQUAL(stats.samplerate(), 0.);
+
+	stats.add(11.);
+	stats.add(13.);
+	stats.add(NAN);
+	stats.add(16.);
+	BOOST_CHECK_EQUAL(stats.count(), 3);
+	BOOST_CHECK_EQUAL(stats.min(), 1.);
+	BOOST_CHECK_EQUAL(stats.max(), 3.);
+	BOOST_CHECK_CLOSE(stats.mean(), 2., 1e-9);
+	BOOST_CHECK_CLOSE(stats.jitter(), std::sqrt(2. / 3.), 1e-9);
+	BOOST_CHECK_CLOSE(stats.samplerate(), .5, 1e-9);
+
+	stats.reset();
+	BOOST_CHECK_EQUAL(stats.count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(add_uniform_test)
+{
+	IntervalStatistics uniform;
+	IntervalStatistics single;
+	uniform.add(0.);
+	single.add(0.);
+
+	uniform.add_uniform(.5, .25, 5);
+	for (size_t i=0; i<5; ++i)
+		single.add(.5 + .25 * (double)i);
+	uniform.add(2.);
+	single.add(2.);
+
+	BOOST_CHECK_EQUAL(uniform.count(), single.count());
+	BOOST_CHECK_CLOSE(uniform.min(), single.min(), 1e-9);
+	BOOST_CHECK_CLOSE(uniform.max(), single.max(), 1e-9);
+	BOOST_CHECK_CLOSE(uniform.mean(), single.mean(), 1e-9);
+	BOOST_CHECK_CLOSE(uniform.jitter(), single.jitter(), 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/kdtree.hpp"
+
+using std::vector;
+using sv::data::KdTree;
+
+namespace {
+
+void check_closest(KdTree &tree, const vector<double> &x,
+	const vector<double> &y, double pos_x, double pos_y)
+{
+	size_t ref_pos = 0;
+	double ref_d2 = std::numeric_limits<double>::infinity();
+	for (size_t i=0; i<x.size(); ++i) {
+		double d2 = (x[i] - pos_x) * (x[i] - pos_x) +
+			(y[i] - pos_y) * (y[i] - pos_y);
+		if (d2 < ref_d2) {
+			ref_pos = i;
+			ref_d2 = d2;
+		}
+	}
+
+	size_t pos;
+	double distance;
+	BOOST_REQUIRE(tree.find_closest(pos_x, pos_y, pos, distance));
+	BOOST_CHECK_EQUAL(pos, ref_pos);
+	BOOST_CHECK_CLOSE(distance, std::sqrt(ref_d2), 1e-9);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(KdTreeTest)
+
+BOOST_AUTO_TEST_CASE(incremental_update_test)
+{
+	vector<double> x;
+	vector<double> y;
+	KdTree tree;
+
+	// A discharge like curve, queried while it grows
+	for (size_t step : { 1, 10, 500, 3, 5000, 20000 }) {
+		for (size_t i=0; i<step; ++i) {
+			double t = (double)x.size();
+			x.push_back(0.001 * t);
+			y.push_back(4.2 - 0.0001 * t + 0.05 * std::sin(0.37 * t));
+			tree.append(x.back(), y.back());
+		}
+		BOOST_CHECK_EQUAL(tree.size(), x.size());
+
+		for (double pos_x : { -10., 0., 0.5, 3.3, 100. }) {
+			for (double pos_y : { -5., 3.9, 4.2, 10. })
+				check_closest(tree, x, y, pos_x, pos_y);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(random_cloud_test)
+{
+	vector<double> x;
+	vector<double> y;
+	unsigned int seed = 12345;
+	for (size_t i=0; i<30000; ++i) {
+		seed = seed * 1103515245 + 12345;
+		x.push_back((double)(seed % 10007) / 10007.);
+		seed = seed * 1103515245 + 12345;
+		y.push_back((double)(seed % 9973) * 100.);
+	}
+
+	KdTree tree;
+	for (size_t i=0; i<x.size(); ++i)
+		tree.append(x[i], y[i]);
+	for (size_t i=0; i<200; ++i)
+		check_closest(tree, x, y, 0.005 * (double)i, 5000. * (double)i);
+}
+
+BOOST_AUTO_TEST_CASE(nan_and_clear_test)
+{
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	KdTree tree;
+	tree.append(nan, 0.);
+	tree.append(1., nan);
+	tree.append(2., 2.);
+	tree.append(nan, 3.);
+
+	size_t pos;
+	double distance;
+	BOOST_REQUIRE(tree.find_closest(0., 0., pos, distance));
+	BOOST_CHECK_EQUAL(pos, 2);
+
+	tree.clear();
+	tree.append(nan, nan);
+	BOOST_CHECK_EQUAL(tree.size(), 1);
+	BOOST_CHECK(!tree.find_closest(0., 0., pos, distance));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/minmaxindex.hpp"
+
+using std::vector;
+using sv::data::MinMaxIndex;
+
+namespace {
+
+MinMaxIndex::fetch_func_t fetch_from(const vector<double> &values)
+{
+	return [&values](size_t pos, size_t end_pos, vector<double> &out) {
+		end_pos = std::min(end_pos, values.size());
+		out.clear();
+		if (pos < end_pos)
+			out.assign(values.begin() + pos, values.begin() + end_pos);
+	};
+}
+
+void check_range(const MinMaxIndex &index, const vector<double> &values,
+	size_t pos, size_t end_pos)
+{
+	double min = values[pos];
+	double max = values[pos];
+	for (size_t i=pos; i<end_pos; ++i) {
+		if (values[i] < min)
+			min = values[i];
+		if (values[i] > max)
+			max = values[i];
+	}
+
+	size_t min_pos;
+	size_t max_pos;
+	index.find(pos, end_pos, min_pos, max_pos);
+	BOOST_CHECK(min_pos >= pos && min_pos < end_pos);
+	BOOST_CHECK(max_pos >= pos && max_pos < end_pos);
+	BOOST_CHECK_EQUAL(values[min_pos], min);
+	BOOST_CHECK_EQUAL(values[max_pos], max);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(MinMaxIndexTest)
+
+BOOST_AUTO_TEST_CASE(incremental_update_test)
+{
+	vector<double> values;
+	MinMaxIndex index(fetch_from(values));
+
+	// Grow the column in uneven steps, so blocks are completed over several
+	// updates.
+	for (size_t step : { 1, 7, 64, 100, 3, 1000, 513 }) {
+		for (size_t i=0; i<step; ++i) {
+			double x = (double)values.size();
+			values.push_back(std::sin(0.05 * x) * x + std::cos(1.7 * x));
+		}
+		index.update(values.size());
+		BOOST_CHECK_EQUAL(index.size(), values.size());
+
+		const size_t n = values.size();
+		check_range(index, values, 0, n);
+		check_range(index, values, n - 1, n);
+		check_range(index, values, n / 3, n / 3 + 1);
+		for (size_t pos=0; pos<n; pos+=37)
+			check_range(index, values, pos, std::min(n, pos + 5 + pos / 2));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nan_test)
+{
+	vector<double> values(300, 1.);
+	values[0] = std::numeric_limits<double>::quiet_NaN();
+	values[130] = std::numeric_limits<double>::quiet_NaN();
+	values[200] = -2.;
+	values[250] = 3.;
+
+	MinMaxIndex index(fetch_from(values));
+	index.update(values.size());
+
+	size_t min_pos;
+	size_t max_pos;
+	index.find(0, values.size(), min_pos, max_pos);
+	BOOST_CHECK_EQUAL(min_pos, 200);
+	BOOST_CHECK_EQUAL(max_pos, 250);
+
+	index.find(0, 1, min_pos, max_pos);
+	BOOST_CHECK_EQUAL(min_pos, 0);
+	BOOST_CHECK_EQUAL(max_pos, 0);
+}
+
+BOOST_AUTO_TEST_CASE(short_fetch_test)
+{
+	vector<double> values(100);
+	for (size_t i=0; i<values.size(); ++i)
+		values[i] = std::cos(0.3 * (double)i);
+
+	// Only the fetched values are indexed
+	MinMaxIndex index(fetch_from(values));
+	index.update(200);
+	BOOST_CHECK_EQUAL(index.size(), values.size());
+	check_range(index, values, 0, values.size());
+
+	for (size_t i=0; i<100; ++i)
+		values.push_back(std::sin(0.7 * (double)i));
+	index.update(values.size());
+	BOOST_CHECK_EQUAL(index.size(), values.size());
+	check_range(index, values, 0, values.size());
+	check_range(index, values, 90, 170);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
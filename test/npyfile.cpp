@@ -0,0 +1,202 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/npyfile.hpp"
+
+using std::string;
+using std::vector;
+
+namespace npy = sv::data::npy;
+
+namespace {
+
+uint32_t read_u32(const string &data, size_t pos)
+{
+	const auto *bytes = reinterpret_cast<const uint8_t *>(data.data() + pos);
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+		((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(NpyFileTest)
+
+BOOST_AUTO_TEST_CASE(crc32_test)
+{
+	const char check[] = "123456789";
+	BOOST_CHECK_EQUAL(npy::crc32(0, check, 9), 0xCBF43926u);
+	BOOST_CHECK_EQUAL(npy::crc32(0, check, 0), 0u);
+
+	// Incremental
+	uint32_t crc = npy::crc32(0, check, 5);
+	BOOST_CHECK_EQUAL(npy::crc32(crc, check + 5, 4), 0xCBF43926u);
+}
+
+BOOST_AUTO_TEST_CASE(header_test)
+{
+	const vector<size_t> counts = { 0, 1, 1000, 123456789012 };
+	for (const size_t count : counts) {
+		string header = npy::header(count);
+		BOOST_CHECK_EQUAL(header.size() % 64, 0);
+		BOOST_CHECK_EQUAL(header.back(), '\n');
+
+		vector<char> file(header.begin(), header.end());
+		file.resize(header.size() + 8 * (count < 1000 ? count : 1000));
+		size_t data_offset;
+		size_t parsed_count;
+		size_t item_size;
+		string error;
+		bool valid = npy::parse_header(file.data(), file.size(),
+			data_offset, parsed_count, item_size, error);
+		if (count <= 1000) {
+			BOOST_CHECK(valid);
+			BOOST_CHECK_EQUAL(data_offset, header.size());
+			BOOST_CHECK_EQUAL(parsed_count, count);
+			BOOST_CHECK_EQUAL(item_size, 8);
+		}
+		else {
+			// The data is truncated
+			BOOST_CHECK(!valid);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parse_header_test)
+{
+	const string dict =
+		"{'descr': '<f4', 'fortran_order': False, 'shape': (3,), }\n";
+	string file("\x93NUMPY\x01\x00", 8);
+	file += (char)dict.size();
+	file += (char)0;
+	file += dict;
+	file.append(12, '\0');
+
+	size_t data_offset;
+	size_t count;
+	size_t item_size;
+	string error;
+	BOOST_CHECK(npy::parse_header(file.data(), file.size(),
+		data_offset, count, item_size, error));
+	BOOST_CHECK_EQUAL(data_offset, 10 + dict.size());
+	BOOST_CHECK_EQUAL(count, 3);
+	BOOST_CHECK_EQUAL(item_size, 4);
+
+	const string dict_2d =
+		"{'descr': '<f8', 'fortran_order': False, 'shape': (3, 2), }\n";
+	string file_2d("\x93NUMPY\x01\x00", 8);
+	file_2d += (char)dict_2d.size();
+	file_2d += (char)0;
+	file_2d += dict_2d;
+	file_2d.append(48, '\0');
+	BOOST_CHECK(!npy::parse_header(file_2d.data(), file_2d.size(),
+		data_offset, count, item_size, error));
+
+	BOOST_CHECK(!npy::parse_header("no numpy", 8,
+		data_offset, count, item_size, error));
+}
+
+BOOST_AUTO_TEST_CASE(npz_writer_test)
+{
+	FILE *file = tmpfile();
+	BOOST_REQUIRE(file);
+
+	const vector<double> values = { 1., 2.5, -3. };
+	npy::NpzWriter writer(file);
+	BOOST_CHECK(writer.begin_array("a", values.size()));
+	BOOST_CHECK(writer.write(values.data(), values.size()));
+	BOOST_CHECK(writer.end_array());
+	BOOST_CHECK(writer.begin_array("b", 0));
+	BOOST_CHECK(writer.end_array());
+	BOOST_CHECK(writer.finish());
+
+	string data(ftell(file), '\0');
+	rewind(file);
+	BOOST_REQUIRE_EQUAL(fread(&data[0], 1, data.size(), file), data.size());
+	fclose(file);
+
+	// Local file header of the first member
+	BOOST_CHECK_EQUAL(read_u32(data, 0), 0x04034b50u);
+	BOOST_CHECK_EQUAL(data.substr(30, 5), "a.npy");
+
+	// End of central directory record
+	const size_t eocd = data.size() - 22;
+	BOOST_CHECK_EQUAL(read_u32(data, eocd), 0x06054b50u);
+	BOOST_CHECK_EQUAL(data[eocd + 10], 2);
+	const uint32_t directory_offset = read_u32(data, eocd + 16);
+	BOOST_CHECK_EQUAL(read_u32(data, directory_offset), 0x02014b50u);
+
+	// The array data of the first member
+	const string member = data.substr(35, npy::header(3).size() + 24);
+	BOOST_CHECK_EQUAL(read_u32(data, directory_offset + 16),
+		npy::crc32(0, member.data(), member.size()));
+	double value;
+	memcpy(&value, member.data() + member.size() - 16, sizeof(double));
+	BOOST_CHECK_EQUAL(value, 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(find_member_test)
+{
+	FILE *file = tmpfile();
+	BOOST_REQUIRE(file);
+
+	const vector<double> values = { 4., -1.5 };
+	npy::NpzWriter writer(file);
+	BOOST_CHECK(writer.begin_array("first", 1));
+	BOOST_CHECK(writer.write(values.data(), 1));
+	BOOST_CHECK(writer.end_array());
+	BOOST_CHECK(writer.begin_array("second", values.size()));
+	BOOST_CHECK(writer.write(values.data(), values.size()));
+	BOOST_CHECK(writer.end_array());
+	BOOST_CHECK(writer.finish());
+
+	string data(ftell(file), '\0');
+	rewind(file);
+	BOOST_REQUIRE_EQUAL(fread(&data[0], 1, data.size(), file), data.size());
+	fclose(file);
+
+	size_t member_offset;
+	size_t member_size;
+	string error;
+	BOOST_REQUIRE(npy::find_member(data.data(), data.size(), "second.npy",
+		member_offset, member_size, error));
+
+	size_t data_offset;
+	size_t count;
+	size_t item_size;
+	BOOST_REQUIRE(npy::parse_header(data.data() + member_offset, member_size,
+		data_offset, count, item_size, error));
+	BOOST_CHECK_EQUAL(count, 2);
+	double value;
+	memcpy(&value, data.data() + member_offset + data_offset + item_size,
+		sizeof(double));
+	BOOST_CHECK_EQUAL(value, -1.5);
+
+	BOOST_CHECK(!npy::find_member(data.data(), data.size(), "third.npy",
+		member_offset, member_size, error));
+	BOOST_CHECK(!npy::find_member(data.data(), 10, "first.npy",
+		member_offset, member_size, error));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/rollingstatistics.hpp"
+
+using std::vector;
+using sv::data::RollingStatistics;
+
+BOOST_AUTO_TEST_SUITE(RollingStatisticsTest)
+
+BOOST_AUTO_TEST_CASE(sample_count_window_test)
+{
+	const size_t window = 37;
+	RollingStatistics stats(window, 0.);
+	vector<double> values;
+	for (size_t i=0; i<1000; ++i) {
+		// Large offset with small noise to check the cancellation handling
+		double value = 1e6 + std::sin(0.7 * i) + 0.01 * (double)(i % 13);
+		values.push_back(value);
+		stats.add((double)i, value);
+
+		size_t first = (values.size() > window) ? values.size() - window : 0;
+		vector<double> w(values.begin() + first, values.end());
+		double min = *std::min_element(w.begin(), w.end());
+		double max = *std::max_element(w.begin(), w.end());
+		double mean = 0.;
+		double squares = 0.;
+		for (double v : w) {
+			mean += v;
+			squares += v * v;
+		}
+		mean /= w.size();
+		double variance = 0.;
+		for (double v : w)
+			variance += (v - mean) * (v - mean);
+		variance /= w.size();
+
+		BOOST_CHECK_EQUAL(stats.count(), w.size());
+		BOOST_CHECK_EQUAL(stats.min(), min);
+		BOOST_CHECK_EQUAL(stats.max(), max);
+		BOOST_CHECK_CLOSE(stats.mean(), mean, 1e-9);
+		BOOST_CHECK_SMALL(stats.stddev() - std::sqrt(variance), 1e-6);
+		BOOST_CHECK_CLOSE(stats.rms(), std::sqrt(squares / w.size()), 1e-9);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(time_window_test)
+{
+	RollingStatistics stats(0, 1.);
+	stats.add(0.0, 5.);
+	stats.add(0.5, 1.);
+	stats.add(1.0, 3.);
+	BOOST_CHECK_EQUAL(stats.count(), 3);
+	BOOST_CHECK_EQUAL(stats.peak_to_peak(), 4.);
+
+	stats.add(1.6, 2.);
+	BOOST_CHECK_EQUAL(stats.count(), 2);
+	BOOST_CHECK_EQUAL(stats.min(), 2.);
+	BOOST_CHECK_EQUAL(stats.max(), 3.);
+	BOOST_CHECK_CLOSE(stats.mean(), 2.5, 1e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
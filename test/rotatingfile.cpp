@@ -0,0 +1,110 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include <QTemporaryDir>
+
+#include "src/data/rotatingfile.hpp"
+
+using std::string;
+using sv::data::RotatingFile;
+
+namespace {
+
+string read_file(const string &file_name)
+{
+	string content;
+	FILE *file = fopen(file_name.c_str(), "rb");
+	if (!file)
+		return content;
+	char buffer[256];
+	size_t size;
+	while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		content.append(buffer, size);
+	fclose(file);
+	return content;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(RotatingFileTest)
+
+BOOST_AUTO_TEST_CASE(rotate_size_test)
+{
+	QTemporaryDir temp_dir;
+	BOOST_REQUIRE(temp_dir.isValid());
+	const string base_name = temp_dir.path().toStdString() + "/log";
+	RotatingFile file(base_name, "csv", 10, 0, 0);
+	file.set_header("H\n");
+
+	BOOST_CHECK(file.write("12345", 5, 1000.));
+	BOOST_CHECK(file.write("678", 3, 1001.));
+	const string first_file_name = file.file_name();
+	// Exceeds the max. size, so a new file is started
+	BOOST_CHECK(file.write("abc", 3, 1002.));
+	BOOST_CHECK(file.flush(1002.));
+	BOOST_CHECK_EQUAL(file.file_count(), 2);
+	BOOST_CHECK(file.file_name() != first_file_name);
+	BOOST_CHECK(file.close());
+
+	BOOST_CHECK_EQUAL(read_file(first_file_name), "H\n12345678");
+	BOOST_CHECK_EQUAL(read_file(file.file_name()), "H\nabc");
+	BOOST_CHECK(file.error().empty());
+
+	// Data larger than the max. size is not split
+	RotatingFile big_file(base_name, "csv", 4, 0, 0);
+	BOOST_CHECK(big_file.write("0123456789", 10, 1000.));
+	BOOST_CHECK_EQUAL(big_file.file_count(), 1);
+	BOOST_CHECK(big_file.close());
+	// The files of the first logger are not overwritten
+	BOOST_CHECK(big_file.file_name() != first_file_name);
+	BOOST_CHECK_EQUAL(read_file(big_file.file_name()), "0123456789");
+}
+
+BOOST_AUTO_TEST_CASE(rotate_time_test)
+{
+	QTemporaryDir temp_dir;
+	BOOST_REQUIRE(temp_dir.isValid());
+	const string base_name = temp_dir.path().toStdString() + "/log";
+	RotatingFile file(base_name, "bin", 0, 60., 1.);
+
+	BOOST_CHECK(file.write("a", 1, 1000.));
+	BOOST_CHECK(file.write("b", 1, 1059.));
+	BOOST_CHECK_EQUAL(file.file_count(), 1);
+	BOOST_CHECK(file.write("c", 1, 1060.));
+	BOOST_CHECK_EQUAL(file.file_count(), 2);
+	BOOST_CHECK(file.close());
+	BOOST_CHECK_EQUAL(read_file(file.file_name()), "c");
+}
+
+BOOST_AUTO_TEST_CASE(open_error_test)
+{
+	QTemporaryDir temp_dir;
+	BOOST_REQUIRE(temp_dir.isValid());
+	RotatingFile file(temp_dir.path().toStdString() + "/missing/log", "csv",
+		0, 0, 0);
+	BOOST_CHECK(!file.write("a", 1, 1000.));
+	BOOST_CHECK(!file.error().empty());
+	BOOST_CHECK(!file.flush(1000.));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/samplemerger.hpp"
+
+using std::vector;
+using sv::data::SampleMerger;
+
+namespace {
+
+SampleMerger::fetch_func_t fetch_from(const vector<vector<double>> &timestamps,
+	const vector<vector<double>> &values)
+{
+	return [&timestamps, &values](size_t source, size_t pos, size_t end,
+			vector<double> &ts, vector<double> &vals) {
+		ts.assign(timestamps[source].begin() + pos,
+			timestamps[source].begin() + end);
+		vals.assign(values[source].begin() + pos,
+			values[source].begin() + end);
+	};
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SampleMergerTest)
+
+BOOST_AUTO_TEST_CASE(merge_test)
+{
+	vector<vector<double>> timestamps = {
+		{ 1., 2., 4. }, { 2., 3. }, { } };
+	vector<vector<double>> values = {
+		{ 10., 20., 40. }, { 21., 31. }, { } };
+
+	SampleMerger merger({ 3, 2, 0 }, fetch_from(timestamps, values));
+	BOOST_CHECK_EQUAL(merger.source_count(), 3);
+	BOOST_CHECK_EQUAL(merger.total_count(), 5);
+
+	BOOST_REQUIRE(merger.next());
+	BOOST_CHECK_EQUAL(merger.timestamp(), 1.);
+	BOOST_CHECK(merger.has_value(0));
+	BOOST_CHECK_EQUAL(merger.value(0), 10.);
+	BOOST_CHECK(!merger.has_value(1));
+	BOOST_CHECK(!merger.has_value(2));
+
+	BOOST_REQUIRE(merger.next());
+	BOOST_CHECK_EQUAL(merger.timestamp(), 2.);
+	BOOST_CHECK(merger.has_value(0));
+	BOOST_CHECK_EQUAL(merger.value(0), 20.);
+	BOOST_CHECK(merger.has_value(1));
+	BOOST_CHECK_EQUAL(merger.value(1), 21.);
+
+	BOOST_REQUIRE(merger.next());
+	BOOST_CHECK_EQUAL(merger.timestamp(), 3.);
+	BOOST_CHECK(!merger.has_value(0));
+	BOOST_CHECK(merger.has_value(1));
+
+	BOOST_REQUIRE(merger.next());
+	BOOST_CHECK_EQUAL(merger.timestamp(), 4.);
+	BOOST_CHECK_EQUAL(merger.value(0), 40.);
+	BOOST_CHECK(!merger.has_value(1));
+
+	BOOST_CHECK(!merger.next());
+	BOOST_CHECK_EQUAL(merger.merged_count(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(timeframe_test)
+{
+	vector<vector<double>> timestamps = { { 1., 1.2, 2. }, { 1.1, 2.05 } };
+	vector<vector<double>> values = { { 1., 2., 3. }, { 4., 5. } };
+
+	SampleMerger merger({ 3, 2 }, fetch_from(timestamps, values), 0.15);
+
+	// Only one value per source and row
+	BOOST_REQUIRE(merger.next());
+	BOOST_CHECK_EQUAL(merger.timestamp(), 1.);
+	BOOST_CHECK_EQUAL(merger.value(0), 1.);
+	BOOST_CHECK_EQUAL(merger.value(1), 4.);
+
+	BOOST_REQUIRE(merger.next());
+	BOOST_CHECK_EQUAL(merger.timestamp(), 1.2);
+	BOOST_CHECK_EQUAL(merger.value(0), 2.);
+	BOOST_CHECK(!merger.has_value(1));
+
+	BOOST_REQUIRE(merger.next());
+	BOOST_CHECK_EQUAL(merger.timestamp(), 2.);
+	BOOST_CHECK_EQUAL(merger.value(0), 3.);
+	BOOST_CHECK_EQUAL(merger.value(1), 5.);
+
+	BOOST_CHECK(!merger.next());
+}
+
+BOOST_AUTO_TEST_CASE(block_test)
+{
+	const size_t n = 3 * SampleMerger::BlockSize + 7;
+	vector<vector<double>> timestamps(2);
+	vector<vector<double>> values(2);
+	for (size_t i=0; i<n; ++i) {
+		timestamps[0].push_back((double)(2 * i));
+		values[0].push_back((double)i);
+		timestamps[1].push_back((double)(2 * i + 1));
+		values[1].push_back((double)i);
+	}
+
+	SampleMerger merger({ n, n }, fetch_from(timestamps, values));
+	double last_timestamp = -1.;
+	size_t rows = 0;
+	while (merger.next()) {
+		BOOST_REQUIRE(merger.timestamp() > last_timestamp);
+		size_t source = rows % 2;
+		BOOST_REQUIRE(merger.has_value(source));
+		BOOST_REQUIRE_EQUAL(merger.value(source), (double)(rows / 2));
+		last_timestamp = merger.timestamp();
+		++rows;
+	}
+	BOOST_CHECK_EQUAL(rows, 2 * n);
+	BOOST_CHECK_EQUAL(merger.merged_count(), 2 * n);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
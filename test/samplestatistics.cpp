@@ -0,0 +1,61 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <limits>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/samplestatistics.hpp"
+
+using sv::data::SampleStatistics;
+
+BOOST_AUTO_TEST_SUITE(SampleStatisticsTest)
+
+BOOST_AUTO_TEST_CASE(statistics_test)
+{
+	SampleStatistics statistics;
+	BOOST_CHECK_EQUAL(statistics.count(), 0u);
+
+	for (int i=-5; i<=10; ++i)
+		statistics.add((double)i);
+	statistics.add(std::numeric_limits<double>::quiet_NaN());
+	statistics.add(std::numeric_limits<double>::infinity());
+
+	BOOST_CHECK_EQUAL(statistics.count(), 16u);
+	BOOST_CHECK_EQUAL(statistics.min(), -5.);
+	BOOST_CHECK_EQUAL(statistics.max(), 10.);
+	BOOST_CHECK_CLOSE(statistics.mean(), 2.5, 1e-12);
+
+	statistics.reset();
+	BOOST_CHECK_EQUAL(statistics.count(), 0u);
+	statistics.add(3.);
+	BOOST_CHECK_EQUAL(statistics.min(), 3.);
+	BOOST_CHECK_EQUAL(statistics.max(), 3.);
+	BOOST_CHECK_EQUAL(statistics.mean(), 3.);
+}
+
+BOOST_AUTO_TEST_CASE(large_offset_mean_test)
+{
+	SampleStatistics statistics;
+	for (size_t i=0; i<1000000; ++i)
+		statistics.add(1e9 + (i % 2 ? 0.1 : -0.1));
+	BOOST_CHECK_CLOSE(statistics.mean(), 1e9, 1e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
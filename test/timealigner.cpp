@@ -0,0 +1,106 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/timealigner.hpp"
+
+using std::vector;
+using sv::data::TimeAligner;
+
+BOOST_AUTO_TEST_SUITE(TimeAlignerTest)
+
+BOOST_AUTO_TEST_CASE(combine_test)
+{
+	// Same example as for AnalogTimeSignal::combine_signals()
+	TimeAligner aligner;
+	aligner.add_first({ 1., 2., 4., 6. }, { 1., 2., 4., 6. });
+	aligner.add_second({ 1., 3., 4., 7. }, { 10., 30., 40., 70. });
+
+	vector<double> timestamps;
+	vector<double> first_values;
+	vector<double> second_values;
+	aligner.combine(timestamps, first_values, second_values);
+
+	// The last sample of the first signal waits for the next sample of the
+	// second signal and the other way around.
+	const vector<double> ref_timestamps { 1., 2., 3., 4., 6. };
+	const vector<double> ref_first { 1., 2., 3., 4., 6. };
+	const vector<double> ref_second { 10., 20., 30., 40., 60. };
+	BOOST_CHECK_EQUAL_COLLECTIONS(timestamps.begin(), timestamps.end(),
+		ref_timestamps.begin(), ref_timestamps.end());
+	BOOST_CHECK_EQUAL_COLLECTIONS(first_values.begin(), first_values.end(),
+		ref_first.begin(), ref_first.end());
+	BOOST_CHECK_EQUAL_COLLECTIONS(second_values.begin(), second_values.end(),
+		ref_second.begin(), ref_second.end());
+}
+
+BOOST_AUTO_TEST_CASE(chunked_test)
+{
+	// Adding the samples one by one must give the same result as adding
+	// them at once.
+	const vector<double> first_ts { 0., 1., 2., 3., 4., 5., 6., 7., 8. };
+	const vector<double> second_ts { .5, 1., 2.5, 3.5, 3.75, 6., 8. };
+
+	TimeAligner all;
+	all.add_first(first_ts, first_ts);
+	all.add_second(second_ts, second_ts);
+	vector<double> ref_ts, ref_first, ref_second;
+	all.combine(ref_ts, ref_first, ref_second);
+
+	TimeAligner chunked;
+	vector<double> ts, first, second;
+	for (size_t i=0; i<first_ts.size(); ++i) {
+		chunked.add_first({ first_ts[i] }, { first_ts[i] });
+		if (i < second_ts.size())
+			chunked.add_second({ second_ts[i] }, { second_ts[i] });
+		chunked.combine(ts, first, second);
+	}
+
+	BOOST_CHECK_EQUAL_COLLECTIONS(ts.begin(), ts.end(),
+		ref_ts.begin(), ref_ts.end());
+	BOOST_CHECK_EQUAL_COLLECTIONS(first.begin(), first.end(),
+		ref_first.begin(), ref_first.end());
+	BOOST_CHECK_EQUAL_COLLECTIONS(second.begin(), second.end(),
+		ref_second.begin(), ref_second.end());
+
+	// Both values are the timestamps, so they must be equal after the
+	// interpolation.
+	for (size_t i=0; i<ts.size(); ++i) {
+		BOOST_CHECK_CLOSE(first[i], ts[i], 1e-9);
+		BOOST_CHECK_CLOSE(second[i], ts[i], 1e-9);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(clear_test)
+{
+	TimeAligner aligner;
+	aligner.add_first({ 1., 2. }, { 1., 2. });
+	aligner.add_second({ 1. }, { 10. });
+	aligner.clear();
+
+	vector<double> timestamps, first_values, second_values;
+	aligner.add_first({ 5. }, { 5. });
+	aligner.add_second({ 6. }, { 6. });
+	aligner.combine(timestamps, first_values, second_values);
+	BOOST_CHECK(timestamps.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the SmuView project.
+ *
+ * Copyright (C) 2026 Frank Stettner <frank-stettner@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "src/data/timestamprows.hpp"
+
+using std::vector;
+using sv::data::TimestampRows;
+
+BOOST_AUTO_TEST_SUITE(TimestampRowsTest)
+
+BOOST_AUTO_TEST_CASE(interleaved_signals_test)
+{
+	TimestampRows rows;
+	vector<double> expected;
+
+	// Two signals, the second one lags behind and has some equal timestamps
+	size_t pos1 = 0;
+	size_t pos2 = 0;
+	for (size_t batch=0; batch<100; ++batch) {
+		for (size_t i=0; i<10; ++i, ++pos1) {
+			BOOST_CHECK(rows.add(0.1 * (double)pos1));
+			expected.push_back(0.1 * (double)pos1);
+		}
+		for (size_t i=0; i<5; ++i, ++pos2) {
+			double timestamp = 0.1 * (double)pos2;
+			if (pos2 % 2 == 0)
+				timestamp += 0.05;
+			BOOST_CHECK(rows.add(timestamp));
+			expected.push_back(timestamp);
+		}
+		rows.set_horizon(0.1 * (double)(pos2 - 1));
+	}
+
+	std::sort(expected.begin(), expected.end());
+	expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+	BOOST_REQUIRE_EQUAL(rows.size(), expected.size());
+	for (size_t i=0; i<expected.size(); ++i)
+		BOOST_CHECK_EQUAL(rows.at(i), expected[i]);
+}
+
+BOOST_AUTO_TEST_CASE(moved_rows_test)
+{
+	TimestampRows rows;
+	rows.add(1.);
+	rows.add(3.);
+	rows.add(4.);
+	BOOST_CHECK_EQUAL(rows.first_moved_row(), rows.size());
+
+	rows.add(2.);
+	BOOST_CHECK_EQUAL(rows.first_moved_row(), 1u);
+	rows.reset_moved_rows();
+
+	rows.set_horizon(3.);
+	BOOST_CHECK_EQUAL(rows.size(), 4u);
+	BOOST_CHECK(rows.add(2.));
+	BOOST_CHECK(!rows.add(2.5));
+	rows.add(3.5);
+	BOOST_CHECK_EQUAL(rows.first_moved_row(), 3u);
+	BOOST_CHECK_EQUAL(rows.at(3), 3.5);
+	BOOST_CHECK_EQUAL(rows.at(4), 4.);
+
+	rows.clear();
+	BOOST_CHECK_EQUAL(rows.size(), 0u);
+	BOOST_CHECK(rows.add(0.5));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
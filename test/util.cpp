@@ -573,6 +573,38 @@ BOOST_AUTO_TEST_CASE(format_value_si_autoscale_test)
 	BOOST_CHECK_EQUAL(si_prefix_str, mu);
 }
 
+BOOST_AUTO_TEST_CASE(format_value_buffer_test)
+{
+	char buffer[32];
+
+	BOOST_CHECK(format_value_si(4635., -1, 0, '.', buffer, sizeof(buffer)) ==
+		SIPrefix::kilo);
+	BOOST_CHECK_EQUAL(buffer, "4.635");
+
+	BOOST_CHECK(format_value_si(.04635, 7, 5, ',', buffer, sizeof(buffer)) ==
+		SIPrefix::milli);
+	BOOST_CHECK_EQUAL(buffer, "  46,35");
+
+	BOOST_CHECK(format_value_si(-4635., -1, 3, '.', buffer, sizeof(buffer)) ==
+		SIPrefix::kilo);
+	BOOST_CHECK_EQUAL(buffer, "-4.635000");
+
+	BOOST_CHECK(format_value_si_autoscale(0.000123, -1, 2, '.', buffer,
+		sizeof(buffer)) == SIPrefix::micro);
+	BOOST_CHECK_EQUAL(buffer, "123.00");
+
+	BOOST_CHECK(format_value_si_autoscale(0, 6, 3, '.', buffer,
+		sizeof(buffer)) == SIPrefix::none);
+	BOOST_CHECK_EQUAL(buffer, " 0.000");
+
+	format_value_fixed(12.5, -1, 0, ',', buffer, sizeof(buffer));
+	BOOST_CHECK_EQUAL(buffer, "12");
+
+	// The string is truncated to the buffer size
+	format_value_fixed(123456.789, -1, 3, '.', buffer, 5);
+	BOOST_CHECK_EQUAL(buffer, "1234");
+}
+
 BOOST_AUTO_TEST_CASE(format_time_si_test)
 {
 	// check prefix calculation